@@ -3357,6 +3357,7 @@ static PyObject * offset_mesh(PyObject *self, PyObject *args)
             mesh.MovePoint(i,(normal*float(offset)));
 
         }
+        o->resetAdjacency();
 
         log3d.saveToFile("c:/test.iv");
         MeshObject aObject(mesh);
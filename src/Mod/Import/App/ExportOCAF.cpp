@@ -237,6 +237,53 @@ void ExportOCAF::createNode(App::Part* part, int& root_id,
     root_id=hierarchical_label.size();
 }
 
+// Copies of the same shape share their sub-shapes so that the geometry is
+// written only once. Shapes with different colors are kept apart as the face
+// colors are attached to the sub-shapes. The content hash is only computed
+// for shapes of the same type and with the same number of sub-shapes.
+TopoDS_Shape ExportOCAF::findSharedShape(Part::Feature* part, const TopoDS_Shape& baseShape,
+                                         const std::vector<App::Color>& colors)
+{
+    TopTools_IndexedMapOfShape faces, edges, vertexes;
+    TopExp::MapShapes(baseShape, TopAbs_FACE, faces);
+    TopExp::MapShapes(baseShape, TopAbs_EDGE, edges);
+    TopExp::MapShapes(baseShape, TopAbs_VERTEX, vertexes);
+    std::vector<SharedShape>& candidates = sharedShapes[std::make_tuple(
+        static_cast<int>(baseShape.ShapeType()), faces.Extent(), edges.Extent(), vertexes.Extent())];
+
+    for (auto& it : candidates) {
+        if (it.colors == colors && it.shape.IsEqual(baseShape))
+            return it.shape;
+    }
+
+    // the hash of the property is cached but includes the placement of the shape
+    auto contentHash = [this](Part::Feature* feature, const TopoDS_Shape& shape) {
+        if (!keepExplicitPlacement || feature->Shape.getValue().Location().IsIdentity())
+            return feature->Shape.getContentHash();
+        return Part::TopoShape(shape).getContentHash();
+    };
+
+    std::string hash;
+    for (auto& it : candidates) {
+        if (it.colors != colors)
+            continue;
+        if (hash.empty())
+            hash = contentHash(part, baseShape);
+        if (it.hash.empty())
+            it.hash = contentHash(it.part, it.shape);
+        if (it.hash == hash)
+            return it.shape;
+    }
+
+    SharedShape shared;
+    shared.part = part;
+    shared.shape = baseShape;
+    shared.colors = colors;
+    shared.hash = hash;
+    candidates.push_back(shared);
+    return baseShape;
+}
+
 int ExportOCAF::saveShape(Part::Feature* part, const std::vector<App::Color>& colors,
                           std::vector <TDF_Label>& hierarchical_label,
                           std::vector <TopLoc_Location>& hierarchical_loc,
@@ -269,6 +316,8 @@ int ExportOCAF::saveShape(Part::Feature* part, const std::vector<App::Color>& co
         baseShape = shape;
     }
 
+    baseShape = findSharedShape(part, baseShape, colors);
+
     // Add shape and name
     TDF_Label shapeLabel = aShapeTool->NewShape();
     aShapeTool->SetShape(shapeLabel, baseShape);
@@ -311,6 +360,10 @@ int ExportOCAF::saveShape(Part::Feature* part, const std::vector<App::Color>& co
                 if (!faceLabel.IsNull()) {
                     aShapeTool->SetShape(faceLabel, xp.Current());
                 }
+                else if (xp.Current().IsSame(baseShape)) {
+                    // FindShape() would return the first label of a shared shape
+                    faceLabel = shapeLabel;
+                }
                 else {
                     aShapeTool->FindShape(xp.Current(), faceLabel);
                 }
@@ -33,6 +33,7 @@
 #include <string>
 #include <set>
 #include <map>
+#include <tuple>
 #include <vector>
 #include <App/Material.h>
 #include <App/Part.h>
@@ -86,6 +87,8 @@ public:
 private:
     virtual void findColors(Part::Feature*, std::vector<App::Color>&) const {}
     std::vector<App::DocumentObject*> filterPart(App::Part* part) const;
+    TopoDS_Shape findSharedShape(Part::Feature* part, const TopoDS_Shape& baseShape,
+                                 const std::vector<App::Color>& colors);
 
 private:
     Handle(TDocStd_Document) pDoc;
@@ -94,6 +97,14 @@ private:
     TDF_Label rootLabel;
     bool keepExplicitPlacement;
     bool filterBaseFeature;
+    struct SharedShape {
+        Part::Feature* part;
+        TopoDS_Shape shape;
+        std::vector<App::Color> colors;
+        std::string hash; ///< content hash, computed on demand
+    };
+    /// exported shapes with their colors, keyed by shape type and number of faces, edges and vertexes
+    std::map<std::tuple<int, int, int, int>, std::vector<SharedShape> > sharedShapes;
 };
 
 class ImportExport ExportOCAFCmd : public ExportOCAF
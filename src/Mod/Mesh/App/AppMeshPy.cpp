@@ -38,6 +38,8 @@
 #include <App/DocumentObjectPy.h>
 #include <App/Property.h>
 #include <Base/PlacementPy.h>
+#include <Base/MatrixPy.h>
+#include <Base/BoundBoxPy.h>
 
 #include <Base/GeometryPyCXX.h>
 #include <Base/VectorPy.h>
@@ -47,6 +49,7 @@
 #include "Core/Evaluation.h"
 #include "Core/Iterator.h"
 #include "Core/Approximation.h"
+#include "Core/ChunkedMesh.h"
 
 #include "WildMagic4/Wm4ContBox3.h"
 
@@ -126,6 +129,38 @@ public:
             "tuple of seven items:\n"
             "    center, u, v, w directions and the lengths of the three vectors.\n"
         );
+        add_varargs_method("createChunked",&Module::createChunked,
+            "createChunked(stl, output, [facetsPerChunk=1000000])\n"
+            "Converts an STL file into a chunked mesh file that is processed\n"
+            "chunk by chunk by the other *Chunked functions. This way meshes can be\n"
+            "handled that don't fit into memory."
+        );
+        add_varargs_method("transformChunked",&Module::transformChunked,
+            "transformChunked(input, output, Matrix) -- Transforms a chunked mesh file."
+        );
+        add_varargs_method("smoothChunked",&Module::smoothChunked,
+            "smoothChunked(input, output, [iterations=1, lambda=0.6307])\n"
+            "Laplace smoothing of a chunked mesh file. The seams between the\n"
+            "chunks are kept fixed."
+        );
+        add_varargs_method("decimateChunked",&Module::decimateChunked,
+            "decimateChunked(input, output, reduction, [tolerance=0.0])\n"
+            "Removes the given portion of facets of a chunked mesh file. The seams\n"
+            "between the chunks are kept. If tolerance is greater than zero edge\n"
+            "collapses with a larger error are rejected."
+        );
+        add_varargs_method("evaluateChunked",&Module::evaluateChunked,
+            "evaluateChunked(input) -- Returns a dict with the number of points\n"
+            "and facets, the number of open edges and degenerated facets, the area,\n"
+            "the volume and the bounding box of a chunked mesh file."
+        );
+        add_varargs_method("exportChunked",&Module::exportChunked,
+            "exportChunked(input, stl, [binary=True]) -- Writes a chunked mesh file\n"
+            "as STL file."
+        );
+        add_varargs_method("readChunked",&Module::readChunked,
+            "readChunked(input) -- Loads a chunked mesh file into a Mesh object."
+        );
         initialize("The functions in this module allow working with mesh objects.\n"
                    "A set of functions are provided for reading in registered mesh\n"
                    "file formats to either a new or existing document.\n"
@@ -579,6 +614,149 @@ private:
 
         return result;
     }
+    static std::string decodeName(char* name)
+    {
+        std::string encodedName(name);
+        PyMem_Free(name);
+        return encodedName;
+    }
+    static void openChunked(const std::string& name, MeshCore::MeshChunkedFile& file)
+    {
+        if (!file.Open(name)) {
+            std::string error = std::string("Cannot open chunked mesh file ") + name;
+            throw Py::RuntimeError(error);
+        }
+    }
+    static void checkResult(bool ok, const std::string& name)
+    {
+        if (!ok) {
+            std::string error = std::string("Cannot write file ") + name;
+            throw Py::RuntimeError(error);
+        }
+    }
+    Py::Object createChunked(const Py::Tuple& args)
+    {
+        char* input;
+        char* output;
+        unsigned long facetsPerChunk = 1000000;
+        if (!PyArg_ParseTuple(args.ptr(), "etet|k","utf-8",&input,"utf-8",&output,&facetsPerChunk))
+            throw Py::Exception();
+        std::string inputName = decodeName(input);
+        std::string outputName = decodeName(output);
+
+        bool ok = MeshCore::MeshChunkedProcessor::ImportSTL(inputName, outputName, facetsPerChunk);
+        checkResult(ok, outputName);
+        return Py::None();
+    }
+    Py::Object transformChunked(const Py::Tuple& args)
+    {
+        char* input;
+        char* output;
+        PyObject* mat;
+        if (!PyArg_ParseTuple(args.ptr(), "etetO!","utf-8",&input,"utf-8",&output,
+                              &(Base::MatrixPy::Type), &mat))
+            throw Py::Exception();
+        std::string inputName = decodeName(input);
+        std::string outputName = decodeName(output);
+
+        MeshCore::MeshChunkedFile file;
+        openChunked(inputName, file);
+        MeshCore::MeshChunkedProcessor proc(file);
+        checkResult(proc.Transform(static_cast<Base::MatrixPy*>(mat)->value(), outputName), outputName);
+        return Py::None();
+    }
+    Py::Object smoothChunked(const Py::Tuple& args)
+    {
+        char* input;
+        char* output;
+        int iterations = 1;
+        double lambda = 0.6307;
+        if (!PyArg_ParseTuple(args.ptr(), "etet|id","utf-8",&input,"utf-8",&output,&iterations,&lambda))
+            throw Py::Exception();
+        std::string inputName = decodeName(input);
+        std::string outputName = decodeName(output);
+
+        MeshCore::MeshChunkedFile file;
+        openChunked(inputName, file);
+        MeshCore::MeshChunkedProcessor proc(file);
+        checkResult(proc.Smooth(iterations, static_cast<float>(lambda), outputName), outputName);
+        return Py::None();
+    }
+    Py::Object decimateChunked(const Py::Tuple& args)
+    {
+        char* input;
+        char* output;
+        double reduction;
+        double tolerance = 0.0;
+        if (!PyArg_ParseTuple(args.ptr(), "etetd|d","utf-8",&input,"utf-8",&output,&reduction,&tolerance))
+            throw Py::Exception();
+        std::string inputName = decodeName(input);
+        std::string outputName = decodeName(output);
+
+        MeshCore::MeshChunkedFile file;
+        openChunked(inputName, file);
+        MeshCore::MeshChunkedProcessor proc(file);
+        checkResult(proc.Decimate(static_cast<float>(reduction), static_cast<float>(tolerance), outputName), outputName);
+        return Py::None();
+    }
+    Py::Object evaluateChunked(const Py::Tuple& args)
+    {
+        char* input;
+        if (!PyArg_ParseTuple(args.ptr(), "et","utf-8",&input))
+            throw Py::Exception();
+        std::string inputName = decodeName(input);
+
+        MeshCore::MeshChunkedFile file;
+        openChunked(inputName, file);
+        MeshCore::MeshChunkedProcessor proc(file);
+        MeshCore::MeshChunkedStatistics stat = proc.Evaluate();
+
+        Py::Dict dict;
+        dict.setItem(Py::String("CountPoints"), Py::Long(static_cast<unsigned long>(stat.countPoints)));
+        dict.setItem(Py::String("CountFacets"), Py::Long(static_cast<unsigned long>(stat.countFacets)));
+        dict.setItem(Py::String("CountChunks"), Py::Long(file.CountChunks()));
+        dict.setItem(Py::String("BorderEdges"), Py::Long(static_cast<unsigned long>(stat.countBorderEdges)));
+        dict.setItem(Py::String("DegeneratedFacets"), Py::Long(static_cast<unsigned long>(stat.countDegenerated)));
+        dict.setItem(Py::String("Area"), Py::Float(stat.area));
+        dict.setItem(Py::String("Volume"), Py::Float(stat.volume));
+        Base::BoundBox3d box(stat.box.MinX, stat.box.MinY, stat.box.MinZ,
+                             stat.box.MaxX, stat.box.MaxY, stat.box.MaxZ);
+        dict.setItem(Py::String("BoundBox"), Py::asObject(new Base::BoundBoxPy(new Base::BoundBox3d(box))));
+        return dict;
+    }
+    Py::Object exportChunked(const Py::Tuple& args)
+    {
+        char* input;
+        char* output;
+        PyObject* binary = Py_True;
+        if (!PyArg_ParseTuple(args.ptr(), "etet|O!","utf-8",&input,"utf-8",&output,&PyBool_Type,&binary))
+            throw Py::Exception();
+        std::string inputName = decodeName(input);
+        std::string outputName = decodeName(output);
+
+        MeshCore::MeshChunkedFile file;
+        openChunked(inputName, file);
+        MeshCore::MeshChunkedProcessor proc(file);
+        checkResult(proc.SaveSTL(outputName, PyObject_IsTrue(binary) ? true : false), outputName);
+        return Py::None();
+    }
+    Py::Object readChunked(const Py::Tuple& args)
+    {
+        char* input;
+        if (!PyArg_ParseTuple(args.ptr(), "et","utf-8",&input))
+            throw Py::Exception();
+        std::string inputName = decodeName(input);
+
+        MeshCore::MeshChunkedFile file;
+        openChunked(inputName, file);
+        MeshCore::MeshChunkedProcessor proc(file);
+        MeshCore::MeshKernel kernel;
+        proc.Load(kernel);
+
+        std::unique_ptr<MeshObject> mesh(new MeshObject);
+        mesh->swap(kernel);
+        return Py::asObject(new MeshPy(mesh.release()));
+    }
 };
 
 PyObject* initModule()
@@ -25,6 +25,9 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <atomic>
+# include <iterator>
+# include <memory>
 #endif
 
 #include "Algorithm.h"
@@ -33,6 +36,7 @@
 #include "Iterator.h"
 #include "Grid.h"
 #include "Triangulation.h"
+#include "Functional.h"
 
 #include <Base/Console.h>
 #include <Base/Sequencer.h>
@@ -1984,6 +1988,142 @@ void MeshRefPointToPoints::RemoveNeighbour(unsigned long pos, unsigned long face
 
 //----------------------------------------------------------------------------
 
+namespace MeshCore {
+
+/*
+ * Fills the rows of a compressed sparse row structure concurrently. The
+ * neighbours of an element are collected by \a gather, sorted and made
+ * unique. As the size of a row is not known in advance the rows are counted
+ * first and filled afterwards.
+ */
+template <class Gather>
+static void BuildCompactRows(unsigned long count, Gather gather,
+                             std::vector<unsigned long>& offsets,
+                             std::vector<unsigned long>& indices)
+{
+    auto row = [&gather](unsigned long pos, std::vector<unsigned long>& items) {
+        items.clear();
+        gather(pos, items);
+        std::sort(items.begin(), items.end());
+        items.erase(std::unique(items.begin(), items.end()), items.end());
+    };
+
+    int threads = std::max(1, QThread::idealThreadCount());
+    offsets.assign(count + 1, 0);
+    parallel_for(0, count, [&](unsigned long first, unsigned long last) {
+        std::vector<unsigned long> items;
+        for (unsigned long pos = first; pos < last; pos++) {
+            row(pos, items);
+            offsets[pos + 1] = items.size();
+        }
+    }, threads);
+    for (unsigned long i = 0; i < count; i++)
+        offsets[i + 1] += offsets[i];
+
+    indices.resize(offsets.back());
+    parallel_for(0, count, [&](unsigned long first, unsigned long last) {
+        std::vector<unsigned long> items;
+        for (unsigned long pos = first; pos < last; pos++) {
+            row(pos, items);
+            std::copy(items.begin(), items.end(), indices.begin() + offsets[pos]);
+        }
+    }, threads);
+}
+
+}
+
+void MeshCompactPointToFacets::Rebuild (void)
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    unsigned long countPoints = _rclMesh.CountPoints();
+    unsigned long countFacets = rFacets.size();
+    int threads = std::max(1, QThread::idealThreadCount());
+
+    // count the facets of each point
+    std::unique_ptr<std::atomic<unsigned long>[]> counts(new std::atomic<unsigned long>[countPoints + 1]);
+    parallel_for(0, countPoints + 1, [&](unsigned long first, unsigned long last) {
+        for (unsigned long i = first; i < last; i++)
+            counts[i].store(0, std::memory_order_relaxed);
+    }, threads);
+    parallel_for(0, countFacets, [&](unsigned long first, unsigned long last) {
+        for (unsigned long i = first; i < last; i++) {
+            for (int j = 0; j < 3; j++)
+                counts[rFacets[i]._aulPoints[j] + 1].fetch_add(1, std::memory_order_relaxed);
+        }
+    }, threads);
+
+    _offsets.resize(countPoints + 1);
+    _offsets[0] = 0;
+    for (unsigned long i = 0; i < countPoints; i++) {
+        _offsets[i + 1] = _offsets[i] + counts[i + 1].load(std::memory_order_relaxed);
+        counts[i].store(_offsets[i], std::memory_order_relaxed);
+    }
+
+    // the counters are re-used as insert positions
+    _indices.resize(_offsets.back());
+    parallel_for(0, countFacets, [&](unsigned long first, unsigned long last) {
+        for (unsigned long i = first; i < last; i++) {
+            for (int j = 0; j < 3; j++)
+                _indices[counts[rFacets[i]._aulPoints[j]].fetch_add(1, std::memory_order_relaxed)] = i;
+        }
+    }, threads);
+
+    // the facets of a point are inserted in arbitrary order
+    parallel_for(0, countPoints, [&](unsigned long first, unsigned long last) {
+        for (unsigned long i = first; i < last; i++)
+            std::sort(_indices.begin() + _offsets[i], _indices.begin() + _offsets[i + 1]);
+    }, threads);
+}
+
+std::vector<unsigned long>
+MeshCompactPointToFacets::GetIndices(unsigned long pos1, unsigned long pos2, unsigned long pos3) const
+{
+    std::vector<unsigned long> tmp, intersection;
+    std::set_intersection(Begin(pos1), End(pos1), Begin(pos2), End(pos2),
+                          std::back_inserter(tmp));
+    std::set_intersection(tmp.begin(), tmp.end(), Begin(pos3), End(pos3),
+                          std::back_inserter(intersection));
+    return intersection;
+}
+
+void MeshCompactFacetToFacets::Rebuild (void)
+{
+    MeshCompactPointToFacets pt2f(_rclMesh);
+    Rebuild(pt2f);
+}
+
+void MeshCompactFacetToFacets::Rebuild (const MeshCompactPointToFacets& pt2f)
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    BuildCompactRows(rFacets.size(), [&](unsigned long pos, std::vector<unsigned long>& facets) {
+        const MeshFacet& rFace = rFacets[pos];
+        for (int i = 0; i < 3; i++)
+            facets.insert(facets.end(), pt2f.Begin(rFace._aulPoints[i]), pt2f.End(rFace._aulPoints[i]));
+    }, _offsets, _indices);
+}
+
+void MeshCompactPointToPoints::Rebuild (void)
+{
+    MeshCompactPointToFacets pt2f(_rclMesh);
+    Rebuild(pt2f);
+}
+
+void MeshCompactPointToPoints::Rebuild (const MeshCompactPointToFacets& pt2f)
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    BuildCompactRows(_rclMesh.CountPoints(), [&](unsigned long pos, std::vector<unsigned long>& points) {
+        for (const unsigned long* it = pt2f.Begin(pos); it != pt2f.End(pos); ++it) {
+            const MeshFacet& rFace = rFacets[*it];
+            for (int i = 0; i < 3; i++) {
+                if (rFace._aulPoints[i] != pos)
+                    points.push_back(rFace._aulPoints[i]);
+            }
+        }
+    }, _offsets, _indices);
+}
+
+//----------------------------------------------------------------------------
+
 void MeshRefEdgeToFacets::Rebuild (void)
 {
     _map.clear();
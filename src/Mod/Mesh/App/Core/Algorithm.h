@@ -459,6 +459,106 @@ protected:
     std::vector<std::set<unsigned long> > _map;
 };
 
+/**
+ * The MeshCompactAdjacency is the base class of the adjacency structures that
+ * use a compressed sparse row layout: the neighbours of an element are the
+ * ascending indices in the range [Begin(), End()). Compared to a set per element
+ * this needs only a fraction of the memory and the structures are built concurrently.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshCompactAdjacency
+{
+public:
+    /// Returns the number of elements.
+    unsigned long Size (void) const
+    { return _offsets.empty() ? 0 : static_cast<unsigned long>(_offsets.size() - 1); }
+    /// Returns the number of neighbours of the element with index \a pos.
+    unsigned long Count (unsigned long pos) const
+    { return _offsets[pos+1] - _offsets[pos]; }
+    /// Returns the first neighbour of the element with index \a pos.
+    const unsigned long* Begin (unsigned long pos) const
+    { return _indices.data() + _offsets[pos]; }
+    /// Returns the end of the neighbours of the element with index \a pos.
+    const unsigned long* End (unsigned long pos) const
+    { return _indices.data() + _offsets[pos+1]; }
+    /// Returns the memory used by the structure in bytes.
+    unsigned long GetMemSize (void) const
+    { return static_cast<unsigned long>((_offsets.size() + _indices.size()) * sizeof(unsigned long)); }
+
+protected:
+    /// Construction
+    MeshCompactAdjacency (const MeshKernel &rclM) : _rclMesh(rclM)
+    { }
+    /// Destruction
+    ~MeshCompactAdjacency (void)
+    { }
+
+protected:
+    const MeshKernel  &_rclMesh; /**< The mesh kernel. */
+    std::vector<unsigned long> _offsets;
+    std::vector<unsigned long> _indices;
+};
+
+/**
+ * The MeshCompactPointToFacets builds up the same relation as MeshRefPointToFacets
+ * in a compressed sparse row layout.
+ */
+class MeshExport MeshCompactPointToFacets : public MeshCompactAdjacency
+{
+public:
+    /// Construction
+    MeshCompactPointToFacets (const MeshKernel &rclM) : MeshCompactAdjacency(rclM)
+    { Rebuild(); }
+
+    /// Rebuilds up data structure
+    void Rebuild (void);
+    /// Returns the facets that reference the three given points.
+    std::vector<unsigned long> GetIndices(unsigned long, unsigned long, unsigned long) const;
+};
+
+/**
+ * The MeshCompactFacetToFacets builds up the same relation as MeshRefFacetToFacets
+ * in a compressed sparse row layout.
+ */
+class MeshExport MeshCompactFacetToFacets : public MeshCompactAdjacency
+{
+public:
+    /// Construction
+    MeshCompactFacetToFacets (const MeshKernel &rclM) : MeshCompactAdjacency(rclM)
+    { Rebuild(); }
+    /// Construction from an existing point to facets structure of the same mesh
+    MeshCompactFacetToFacets (const MeshKernel &rclM, const MeshCompactPointToFacets& pt2f)
+      : MeshCompactAdjacency(rclM)
+    { Rebuild(pt2f); }
+
+    /// Rebuilds up data structure
+    void Rebuild (void);
+    /// Rebuilds up data structure from the point to facets structure \a pt2f
+    void Rebuild (const MeshCompactPointToFacets& pt2f);
+};
+
+/**
+ * The MeshCompactPointToPoints builds up the same relation as MeshRefPointToPoints
+ * in a compressed sparse row layout.
+ */
+class MeshExport MeshCompactPointToPoints : public MeshCompactAdjacency
+{
+public:
+    /// Construction
+    MeshCompactPointToPoints (const MeshKernel &rclM) : MeshCompactAdjacency(rclM)
+    { Rebuild(); }
+    /// Construction from an existing point to facets structure of the same mesh
+    MeshCompactPointToPoints (const MeshKernel &rclM, const MeshCompactPointToFacets& pt2f)
+      : MeshCompactAdjacency(rclM)
+    { Rebuild(pt2f); }
+
+    /// Rebuilds up data structure
+    void Rebuild (void);
+    /// Rebuilds up data structure from the point to facets structure \a pt2f
+    void Rebuild (const MeshCompactPointToFacets& pt2f);
+};
+
 /**
  * The MeshRefEdgeToFacets builds up a structure to have access to all facets 
  * of an edge. On a manifold mesh an edge has one or two facets associated.
@@ -38,7 +38,7 @@
 using namespace MeshCore;
 
 
-MeshBuilder::MeshBuilder (MeshKernel& kernel) : _meshKernel(kernel), _seq(0), _ptIdx(0)
+MeshBuilder::MeshBuilder (MeshKernel& kernel) : _meshKernel(kernel), _seq(0), _ptIdx(0), _facetIdx(0)
 {
     _fSaveTolerance = MeshDefinitions::_fMinPointDistanceD1;
 }
@@ -68,32 +68,19 @@ void MeshBuilder::Initialize (size_t ctFacets, bool deletion)
         //       memory. So we're strived to avoid the wastage of memory.
         _meshKernel._aclFacetArray.reserve(ctFacets);
 
-        // Usually the number of vertices is the half of the number of facets. So we reserve this memory with 10% surcharge
-        // To save memory we hold an array with iterators that point to the right vertex (insertion order) in the set, instead of
-        // holding the vertex array twice.
-        size_t ctPoints = ctFacets / 2;
-        _pointsIterator.reserve(static_cast<size_t>(float(ctPoints)*1.10f));
-        _ptIdx = 0;
+        // Every facet adds its three points. Duplicates are only removed in Finish().
+        _meshKernel._aclPointArray.reserve(3 * ctFacets);
     }
     else
     {
-        for (MeshPointArray::_TConstIterator it1 = _meshKernel._aclPointArray.begin(); it1 != _meshKernel._aclPointArray.end(); ++it1)
-        {
-            MeshPointIterator pit = _points.insert(*it1);
-            _pointsIterator.push_back(pit);
-        }
-        _ptIdx = _points.size();
-
-        // As we have a copy of our vertices in the set we must clear them from our array now  But we can keep its
-        // memory as we reuse it later on anyway.
-        _meshKernel._aclPointArray.clear();
         // additional memory
-        size_t newCtFacets = _meshKernel._aclFacetArray.size()+ctFacets;
-        _meshKernel._aclFacetArray.reserve(newCtFacets);
-        size_t ctPoints = newCtFacets / 2;
-        _pointsIterator.reserve(static_cast<size_t>(float(ctPoints)*1.10f));
+        _meshKernel._aclFacetArray.reserve(_meshKernel._aclFacetArray.size() + ctFacets);
+        _meshKernel._aclPointArray.reserve(_meshKernel._aclPointArray.size() + 3 * ctFacets);
     }
 
+    _ptIdx = _meshKernel._aclPointArray.size();
+    _facetIdx = _meshKernel._aclFacetArray.size();
+
     this->_seq = new Base::SequencerLauncher("create mesh structure...", ctFacets * 2);
 }
 
@@ -129,28 +116,75 @@ void MeshBuilder::AddFacet (Base::Vector3f* facetPoints, unsigned char flag, uns
     mf._ucFlag = flag;
     mf._ulProp = prop;
 
-    int i = 0;
-    for (i = 0; i < 3; i++)
+    // the points get merged in Finish()
+    for (int i = 0; i < 3; i++)
     {
-        MeshPoint pt(facetPoints[i]);
-        std::set<MeshPoint>::iterator p = _points.find(pt);
-        if (p == _points.end())
+        mf._aulPoints[i] = _meshKernel._aclPointArray.size();
+        _meshKernel._aclPointArray.push_back(MeshPoint(facetPoints[i]));
+    }
+
+    _meshKernel._aclFacetArray.push_back(mf);
+}
+
+void MeshBuilder::MergePoints ()
+{
+    // Group the added points with a concurrent sort, using the '<' operator of
+    // MeshPoint like MeshEvalDuplicatePoints does. The points that were in the
+    // kernel before keep their index.
+    MeshPointArray& rPoints = _meshKernel._aclPointArray;
+    unsigned long ctPoints = rPoints.size();
+    int threads = std::max(1, QThread::idealThreadCount());
+    std::vector<unsigned long> remap = parallel_group(ctPoints, [&rPoints](unsigned long x, unsigned long y) {
+        return rPoints[x] < rPoints[y];
+    }, threads);
+
+    // The first point of each group is kept, in the order the points were added.
+    // remap[i] becomes the new index of point i. The first point of a group
+    // always comes before the others, so its new index is known already.
+    unsigned long ptIdx = _ptIdx;
+    for (unsigned long i = _ptIdx; i < ctPoints; i++)
+    {
+        if (remap[i] == i)
         {
-            mf._aulPoints[i] = _ptIdx;
-            pt._ulProp = _ptIdx++;
-            // keep an iterator to the right vertex
-            MeshPointIterator it = _points.insert(pt);
-            _pointsIterator.push_back(it);
+            rPoints[ptIdx] = rPoints[i];
+            rPoints[ptIdx]._ulProp = ptIdx;
+            remap[i] = ptIdx++;
         }
         else
-            mf._aulPoints[i] = p->_ulProp;
+        {
+            remap[i] = remap[remap[i]];
+        }
     }
+    rPoints.resize(ptIdx);
 
-    // check for degenerated facet (one edge has length 0)
-    if ((mf._aulPoints[0] == mf._aulPoints[1]) || (mf._aulPoints[0] == mf._aulPoints[2]) || (mf._aulPoints[1] == mf._aulPoints[2]))
-        return;
+    // Remap the added facets and drop the degenerated ones (one edge has length 0)
+    MeshFacetArray& rFacets = _meshKernel._aclFacetArray;
+    unsigned long facetIdx = _facetIdx;
+    for (unsigned long i = _facetIdx; i < rFacets.size(); i++)
+    {
+        MeshFacet mf = rFacets[i];
+        for (int j = 0; j < 3; j++)
+            mf._aulPoints[j] = remap[mf._aulPoints[j]];
+        if ((mf._aulPoints[0] == mf._aulPoints[1]) || (mf._aulPoints[0] == mf._aulPoints[2]) || (mf._aulPoints[1] == mf._aulPoints[2]))
+            continue;
+        rFacets[facetIdx++] = mf;
+    }
+    rFacets.resize(facetIdx);
 
-    _meshKernel._aclFacetArray.push_back(mf);
+    // The point array was sized for all the added points, which are usually
+    // six times more than the merged ones
+    size_t cap = rPoints.capacity();
+    size_t siz = rPoints.size();
+    if ( cap > siz+siz/20 )
+    {
+        try {
+            MeshPointArray points(static_cast<unsigned long>(siz));
+            std::copy(rPoints.begin(), rPoints.end(), points.begin());
+            rPoints.swap(points);
+        } catch ( const Base::MemoryException&) {
+            // sorry, we cannot reduce the memory
+        }
+    }
 }
 
 void MeshBuilder::SetNeighbourhood ()
@@ -217,20 +251,8 @@ void MeshBuilder::RemoveUnreferencedPoints()
 
 void MeshBuilder::Finish (bool freeMemory)
 {
-    // now we can resize the vertex array to the exact size and copy the vertices with their correct positions in the array
-    unsigned long i=0;
-    _meshKernel._aclPointArray.resize(_pointsIterator.size());
-    for ( std::vector<MeshPointIterator>::iterator it = _pointsIterator.begin(); it != _pointsIterator.end(); ++it)
-        _meshKernel._aclPointArray[i++] = *(it->first);
-
-    // free all memory of the internal structures
-    // Note: this scope is needed to free memory immediately
-#if defined(_MSC_VER) && defined(_DEBUG)
-    // Just do nothing here as it may take a long time when running the debugger
-#else
-    { std::vector<MeshPointIterator>().swap(_pointsIterator); }
-#endif
-    _points.clear();
+    // now we can merge the points of the added facets
+    MergePoints();
 
     SetNeighbourhood();
     RemoveUnreferencedPoints();
@@ -99,14 +99,15 @@ private:
     //@}
 
     MeshKernel& _meshKernel;
-    std::set<MeshPoint> _points;
     Base::SequencerLauncher* _seq;
 
-    // keep an array of iterators pointing to the vertex inside the set to save memory
-    typedef std::pair<std::set<MeshPoint>::iterator, bool> MeshPointIterator;
-    std::vector<MeshPointIterator> _pointsIterator;
+    // The points of the added facets are appended to the point array of the
+    // kernel as they come and are merged in Finish(). These are the numbers
+    // of points and facets the kernel had before.
     size_t _ptIdx;
+    size_t _facetIdx;
 
+    void MergePoints       ();
     void SetNeighbourhood  ();
     // As it's forbidden to insert a degenerated facet but insert its vertices anyway we must remove them 
     void RemoveUnreferencedPoints();
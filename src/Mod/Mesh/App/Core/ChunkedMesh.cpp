@@ -0,0 +1,991 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <cctype>
+# include <cfloat>
+# include <climits>
+# include <cstdlib>
+# include <cstring>
+# include <memory>
+#endif
+
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include "ChunkedMesh.h"
+#include "MeshKernel.h"
+#include "MeshIO.h"
+#include "Builder.h"
+#include "Decimation.h"
+#include "Smoothing.h"
+#include "Iterator.h"
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Sequencer.h>
+
+using namespace MeshCore;
+
+namespace MeshCore {
+
+// Layout of the header:
+// signature (8 bytes), version (uint32), number of chunks (uint32),
+// offset of the chunk table (uint64), number of points (uint64),
+// number of facets (uint64), bounding box (6 floats)
+static const char chunkSignature[8] = {'F','C','M','E','S','H','C','K'};
+static const uint32_t chunkVersion = 1;
+static const uint64_t chunkHeaderSize = 64;
+// Layout of an entry of the chunk table:
+// offset (uint64), number of points (uint32), number of facets (uint32),
+// bounding box (6 floats)
+static const uint64_t chunkTableEntrySize = 40;
+
+template <typename T>
+static void writeValue(std::ostream& str, T value)
+{
+    str.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static T readValue(const unsigned char*& data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+    return value;
+}
+
+static void writeBox(std::ostream& str, const Base::BoundBox3f& box)
+{
+    writeValue<float>(str, box.MinX);
+    writeValue<float>(str, box.MinY);
+    writeValue<float>(str, box.MinZ);
+    writeValue<float>(str, box.MaxX);
+    writeValue<float>(str, box.MaxY);
+    writeValue<float>(str, box.MaxZ);
+}
+
+static Base::BoundBox3f readBox(const unsigned char*& data)
+{
+    Base::BoundBox3f box;
+    box.MinX = readValue<float>(data);
+    box.MinY = readValue<float>(data);
+    box.MinZ = readValue<float>(data);
+    box.MaxX = readValue<float>(data);
+    box.MaxY = readValue<float>(data);
+    box.MaxZ = readValue<float>(data);
+    return box;
+}
+
+/*
+ * Collects the points and edges of a chunk that are not surrounded by facets.
+ * For a chunk these are the real border of the mesh plus the seams to the
+ * neighbouring chunks.
+ */
+static void chunkBorder(const MeshKernel& kernel, std::vector<char>& borderPoints,
+                        std::vector<std::pair<unsigned long, unsigned long> >* borderEdges)
+{
+    const MeshFacetArray& facets = kernel.GetFacets();
+    borderPoints.assign(kernel.CountPoints(), 0);
+    for (MeshFacetArray::_TConstIterator it = facets.begin(); it != facets.end(); ++it) {
+        for (int j = 0; j < 3; j++) {
+            if (it->_aulNeighbours[j] == ULONG_MAX) {
+                unsigned long p0 = it->_aulPoints[j];
+                unsigned long p1 = it->_aulPoints[(j+1)%3];
+                borderPoints[p0] = 1;
+                borderPoints[p1] = 1;
+                if (borderEdges)
+                    borderEdges->push_back(std::make_pair(p0, p1));
+            }
+        }
+    }
+}
+
+struct Vector3fLess
+{
+    bool operator()(const Base::Vector3f& a, const Base::Vector3f& b) const
+    {
+        if (a.x != b.x)
+            return a.x < b.x;
+        if (a.y != b.y)
+            return a.y < b.y;
+        return a.z < b.z;
+    }
+};
+
+struct EdgeLess
+{
+    typedef std::pair<Base::Vector3f, Base::Vector3f> Edge;
+    bool operator()(const Edge& a, const Edge& b) const
+    {
+        Vector3fLess less;
+        if (less(a.first, b.first))
+            return true;
+        if (less(b.first, a.first))
+            return false;
+        return less(a.second, b.second);
+    }
+};
+
+struct ChunkJob
+{
+    unsigned long index;
+    MeshKernel kernel;
+    std::string error;
+};
+
+/*
+ * Loads and processes a chunk in a worker thread. Every job fills its own
+ * kernel, the chunked file is shared read-only. The message of a failed chunk
+ * is kept in the job and Process() raises it in chunk order after the batch.
+ */
+class ChunkJobRunner
+{
+public:
+    ChunkJobRunner(const MeshChunkedFile& file,
+                   const std::function<void (unsigned long, MeshKernel&)>& func)
+      : file(file)
+      , func(func)
+    {
+    }
+    void operator()(ChunkJob& job) const
+    {
+        try {
+            file.LoadChunk(job.index, job.kernel);
+            if (func)
+                func(job.index, job.kernel);
+        }
+        catch (const Base::Exception& e) {
+            job.error = e.what();
+        }
+        catch (const std::exception& e) {
+            job.error = e.what();
+        }
+    }
+
+private:
+    const MeshChunkedFile& file;
+    const std::function<void (unsigned long, MeshKernel&)>& func;
+};
+
+/*
+ * Reads the triangles of a binary or ASCII STL file one by one.
+ */
+class STLTriangleReader
+{
+public:
+    STLTriangleReader(std::istream& str)
+      : str(str)
+      , binary(false)
+    {
+        std::streambuf* buf = str.rdbuf();
+        std::streamoff size = buf->pubseekoff(0, std::ios::end, std::ios::in);
+        buf->pubseekoff(0, std::ios::beg, std::ios::in);
+
+        // a binary file has exactly the size given by the number of facets
+        char header[84];
+        if (size >= 84 && str.read(header, 84)) {
+            uint32_t count;
+            std::memcpy(&count, header + 80, sizeof(count));
+            binary = (size == static_cast<std::streamoff>(84 + 50 * static_cast<uint64_t>(count)));
+        }
+        Rewind();
+    }
+    void Rewind()
+    {
+        str.clear();
+        str.seekg(binary ? 84 : 0, std::ios::beg);
+    }
+    bool Next(MeshGeomFacet& facet)
+    {
+        return binary ? NextBinary(facet) : NextAscii(facet);
+    }
+
+private:
+    bool NextBinary(MeshGeomFacet& facet)
+    {
+        char record[50];
+        if (!str.read(record, 50))
+            return false;
+        // skip the normal that is recomputed from the points
+        float coords[9];
+        std::memcpy(coords, record + 12, sizeof(coords));
+        for (int i = 0; i < 3; i++)
+            facet._aclPoints[i].Set(coords[3*i], coords[3*i+1], coords[3*i+2]);
+        facet.CalcNormal();
+        return true;
+    }
+    bool NextAscii(MeshGeomFacet& facet)
+    {
+        int count = 0;
+        while (count < 3 && std::getline(str, line)) {
+            std::string::size_type pos = line.find_first_not_of(" \t");
+            if (pos == std::string::npos || line.size() - pos < 6)
+                continue;
+            bool isVertex = true;
+            for (int i = 0; i < 6 && isVertex; i++)
+                isVertex = std::tolower(static_cast<unsigned char>(line[pos+i])) == "vertex"[i];
+            if (!isVertex)
+                continue;
+
+            const char* ptr = line.c_str() + pos + 6;
+            char* end;
+            float x = std::strtof(ptr, &end);
+            float y = std::strtof(end, &end);
+            float z = std::strtof(end, &end);
+            facet._aclPoints[count++].Set(x, y, z);
+        }
+
+        if (count < 3)
+            return false;
+        facet.CalcNormal();
+        return true;
+    }
+
+private:
+    std::istream& str;
+    std::string line;
+    bool binary;
+};
+
+}
+
+// ----------------------------------------------------------------------------
+
+struct MeshChunkedFile::Private
+{
+    QFile file;
+    QMutex mutex;
+    const unsigned char* data;
+
+    Private() : data(0) {}
+};
+
+MeshChunkedFile::MeshChunkedFile()
+  : d(0)
+  , countPoints(0)
+  , countFacets(0)
+{
+}
+
+MeshChunkedFile::~MeshChunkedFile()
+{
+    Close();
+}
+
+bool MeshChunkedFile::IsChunkedFile(const std::string& fileName)
+{
+    Base::FileInfo fi(fileName);
+    Base::ifstream str(fi, std::ios::in | std::ios::binary);
+    char signature[8];
+    if (!str || !str.read(signature, sizeof(signature)))
+        return false;
+    return std::memcmp(signature, chunkSignature, sizeof(signature)) == 0;
+}
+
+bool MeshChunkedFile::Open(const std::string& fileName)
+{
+    Close();
+
+    d = new Private();
+    d->file.setFileName(QString::fromUtf8(fileName.c_str()));
+    if (!d->file.open(QIODevice::ReadOnly) ||
+        static_cast<uint64_t>(d->file.size()) < chunkHeaderSize) {
+        Close();
+        return false;
+    }
+
+    // mapping may fail, e.g. for very big files on 32-bit systems
+    uint64_t size = static_cast<uint64_t>(d->file.size());
+    d->data = d->file.map(0, d->file.size());
+
+    unsigned char header[chunkHeaderSize];
+    if (!ReadAt(0, header, chunkHeaderSize) ||
+        std::memcmp(header, chunkSignature, sizeof(chunkSignature)) != 0) {
+        Close();
+        return false;
+    }
+
+    const unsigned char* ptr = header + sizeof(chunkSignature);
+    uint32_t version = readValue<uint32_t>(ptr);
+    uint32_t countChunks = readValue<uint32_t>(ptr);
+    uint64_t tableOffset = readValue<uint64_t>(ptr);
+    countPoints = readValue<uint64_t>(ptr);
+    countFacets = readValue<uint64_t>(ptr);
+    boundBox = readBox(ptr);
+    if (version != chunkVersion || tableOffset + countChunks * chunkTableEntrySize > size) {
+        Close();
+        return false;
+    }
+
+    std::vector<unsigned char> table(countChunks * chunkTableEntrySize);
+    if (!table.empty() && !ReadAt(tableOffset, &table[0], table.size())) {
+        Close();
+        return false;
+    }
+
+    ptr = table.empty() ? 0 : &table[0];
+    chunks.resize(countChunks);
+    for (std::vector<MeshChunkInfo>::iterator it = chunks.begin(); it != chunks.end(); ++it) {
+        it->offset = readValue<uint64_t>(ptr);
+        it->countPoints = readValue<uint32_t>(ptr);
+        it->countFacets = readValue<uint32_t>(ptr);
+        it->box = readBox(ptr);
+        uint64_t chunkSize = 12 * static_cast<uint64_t>(it->countPoints) +
+                             12 * static_cast<uint64_t>(it->countFacets);
+        if (it->offset + chunkSize > tableOffset) {
+            Close();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void MeshChunkedFile::Close()
+{
+    if (d) {
+        if (d->data)
+            d->file.unmap(const_cast<uchar*>(d->data));
+        d->file.close();
+        delete d;
+        d = 0;
+    }
+
+    chunks.clear();
+    countPoints = 0;
+    countFacets = 0;
+    boundBox = Base::BoundBox3f();
+}
+
+bool MeshChunkedFile::IsOpen() const
+{
+    return d != 0;
+}
+
+bool MeshChunkedFile::ReadAt(uint64_t offset, void* buffer, uint64_t size) const
+{
+    if (d->data) {
+        std::memcpy(buffer, d->data + offset, size);
+        return true;
+    }
+
+    QMutexLocker lock(&d->mutex);
+    if (!d->file.seek(static_cast<qint64>(offset)))
+        return false;
+    return d->file.read(static_cast<char*>(buffer), static_cast<qint64>(size)) ==
+           static_cast<qint64>(size);
+}
+
+void MeshChunkedFile::LoadChunk(unsigned long index, MeshKernel& kernel) const
+{
+    if (!d)
+        throw Base::FileException("Chunked mesh file is not open");
+    if (index >= chunks.size())
+        throw Base::IndexError("Chunk index out of range");
+
+    const MeshChunkInfo& info = chunks[index];
+    std::vector<float> coords(3 * static_cast<std::size_t>(info.countPoints));
+    std::vector<uint32_t> indices(3 * static_cast<std::size_t>(info.countFacets));
+    if (!coords.empty() && !ReadAt(info.offset, &coords[0], coords.size() * sizeof(float)))
+        throw Base::FileException("Failed to read mesh chunk");
+    if (!indices.empty() && !ReadAt(info.offset + coords.size() * sizeof(float),
+                                    &indices[0], indices.size() * sizeof(uint32_t)))
+        throw Base::FileException("Failed to read mesh chunk");
+
+    MeshPointArray points(info.countPoints);
+    for (std::size_t i = 0; i < points.size(); i++)
+        points[i].Set(coords[3*i], coords[3*i+1], coords[3*i+2]);
+
+    MeshFacetArray facets(info.countFacets);
+    for (std::size_t i = 0; i < facets.size(); i++) {
+        for (int j = 0; j < 3; j++) {
+            uint32_t pointIndex = indices[3*i+j];
+            if (pointIndex >= info.countPoints)
+                throw Base::BadFormatError("Invalid point index in mesh chunk");
+            facets[i]._aulPoints[j] = pointIndex;
+        }
+    }
+
+    kernel.Adopt(points, facets, true);
+}
+
+// ----------------------------------------------------------------------------
+
+MeshChunkedWriter::MeshChunkedWriter(const std::string& fileName)
+  : str(Base::FileInfo(fileName), std::ios::out | std::ios::binary)
+  , countPoints(0)
+  , countFacets(0)
+{
+    // the header is written by Finish()
+    std::vector<char> header(chunkHeaderSize, 0);
+    str.write(&header[0], header.size());
+}
+
+MeshChunkedWriter::~MeshChunkedWriter()
+{
+}
+
+bool MeshChunkedWriter::IsOpen() const
+{
+    return str.is_open() && str.good();
+}
+
+void MeshChunkedWriter::AddChunk(const MeshKernel& kernel)
+{
+    const MeshPointArray& points = kernel.GetPoints();
+    const MeshFacetArray& facets = kernel.GetFacets();
+    if (facets.empty())
+        return;
+    if (points.size() > UINT_MAX || facets.size() > UINT_MAX)
+        throw Base::ValueError("Mesh chunk is too big");
+
+    MeshChunkInfo info;
+    info.offset = static_cast<uint64_t>(str.tellp());
+    info.countPoints = static_cast<uint32_t>(points.size());
+    info.countFacets = static_cast<uint32_t>(facets.size());
+
+    for (MeshPointArray::_TConstIterator it = points.begin(); it != points.end(); ++it) {
+        info.box.Add(*it);
+        writeValue<float>(str, it->x);
+        writeValue<float>(str, it->y);
+        writeValue<float>(str, it->z);
+    }
+    for (MeshFacetArray::_TConstIterator it = facets.begin(); it != facets.end(); ++it) {
+        for (int j = 0; j < 3; j++)
+            writeValue<uint32_t>(str, static_cast<uint32_t>(it->_aulPoints[j]));
+    }
+
+    if (!str.good())
+        throw Base::FileException("Failed to write mesh chunk");
+
+    chunks.push_back(info);
+    countPoints += info.countPoints;
+    countFacets += info.countFacets;
+    boundBox.Add(info.box);
+}
+
+bool MeshChunkedWriter::Finish()
+{
+    uint64_t tableOffset = static_cast<uint64_t>(str.tellp());
+    for (std::vector<MeshChunkInfo>::iterator it = chunks.begin(); it != chunks.end(); ++it) {
+        writeValue<uint64_t>(str, it->offset);
+        writeValue<uint32_t>(str, it->countPoints);
+        writeValue<uint32_t>(str, it->countFacets);
+        writeBox(str, it->box);
+    }
+
+    str.seekp(0, std::ios::beg);
+    str.write(chunkSignature, sizeof(chunkSignature));
+    writeValue<uint32_t>(str, chunkVersion);
+    writeValue<uint32_t>(str, static_cast<uint32_t>(chunks.size()));
+    writeValue<uint64_t>(str, tableOffset);
+    writeValue<uint64_t>(str, countPoints);
+    writeValue<uint64_t>(str, countFacets);
+    writeBox(str, boundBox);
+    str.flush();
+
+    bool ok = str.good();
+    str.close();
+    return ok;
+}
+
+// ----------------------------------------------------------------------------
+
+MeshChunkedStatistics::MeshChunkedStatistics()
+  : countFacets(0)
+  , countPoints(0)
+  , countBorderEdges(0)
+  , countDegenerated(0)
+  , area(0.0)
+  , volume(0.0)
+{
+}
+
+// ----------------------------------------------------------------------------
+
+MeshChunkedProcessor::MeshChunkedProcessor(const MeshChunkedFile& file)
+  : file(file)
+{
+}
+
+void MeshChunkedProcessor::Process(const std::function<void (unsigned long, MeshKernel&)>& func,
+                                   const std::function<void (unsigned long, MeshKernel&)>& done) const
+{
+    unsigned long count = file.CountChunks();
+    unsigned long batch = static_cast<unsigned long>(std::max(1, QThread::idealThreadCount()));
+    Base::SequencerLauncher seq("Processing mesh chunks...", count);
+
+    for (unsigned long first = 0; first < count; first += batch) {
+        std::vector<ChunkJob> jobs(std::min(batch, count - first));
+        for (std::size_t i = 0; i < jobs.size(); i++)
+            jobs[i].index = first + static_cast<unsigned long>(i);
+
+        QtConcurrent::blockingMap(jobs, ChunkJobRunner(file, func));
+
+        for (std::vector<ChunkJob>::iterator it = jobs.begin(); it != jobs.end(); ++it) {
+            if (!it->error.empty())
+                throw Base::RuntimeError(it->error);
+            if (done)
+                done(it->index, it->kernel);
+            seq.next(true); // allow to cancel
+        }
+    }
+}
+
+bool MeshChunkedProcessor::Modify(const std::function<void (unsigned long, MeshKernel&)>& func,
+                                  const std::string& output) const
+{
+    MeshChunkedWriter writer(output);
+    if (!writer.IsOpen())
+        return false;
+
+    Process(func, [&writer](unsigned long, MeshKernel& kernel) {
+        writer.AddChunk(kernel);
+    });
+
+    return writer.Finish();
+}
+
+bool MeshChunkedProcessor::Transform(const Base::Matrix4D& mat, const std::string& output) const
+{
+    return Modify([&mat](unsigned long, MeshKernel& kernel) {
+        kernel.Transform(mat);
+    }, output);
+}
+
+bool MeshChunkedProcessor::Smooth(int iterations, float lambda, const std::string& output) const
+{
+    // the Laplace smoothing keeps the border points fixed
+    return Modify([iterations, lambda](unsigned long, MeshKernel& kernel) {
+        LaplaceSmoothing smooth(kernel);
+        smooth.SetLambda(lambda);
+        smooth.Smooth(static_cast<unsigned int>(std::max(iterations, 0)));
+    }, output);
+}
+
+bool MeshChunkedProcessor::Decimate(float reduction, float maxError, const std::string& output) const
+{
+    return Modify([reduction, maxError](unsigned long, MeshKernel& kernel) {
+        std::vector<char> border;
+        chunkBorder(kernel, border, 0);
+        std::vector<unsigned long> locked;
+        for (std::size_t i = 0; i < border.size(); i++) {
+            if (border[i])
+                locked.push_back(static_cast<unsigned long>(i));
+        }
+
+        int targetSize = static_cast<int>(static_cast<float>(kernel.CountFacets()) * (1.0f - reduction));
+        MeshSimplify simplify(kernel);
+        simplify.setLockedPoints(locked);
+        simplify.simplify(targetSize, maxError > 0.0f ? maxError : FLT_MAX);
+    }, output);
+}
+
+MeshChunkedStatistics MeshChunkedProcessor::Evaluate() const
+{
+    struct ChunkResult {
+        uint64_t countInnerPoints;
+        uint64_t countDegenerated;
+        double area;
+        double volume;
+        std::vector<Base::Vector3f> borderPoints;
+        std::vector<EdgeLess::Edge> borderEdges;
+    };
+
+    // the results of the chunks of the current batch
+    std::vector<ChunkResult> results(file.CountChunks());
+    MeshChunkedStatistics stat;
+    std::vector<Base::Vector3f> borderPoints;
+    std::vector<EdgeLess::Edge> borderEdges;
+
+    Process([&results](unsigned long index, MeshKernel& kernel) {
+        ChunkResult& res = results[index];
+        res.countDegenerated = 0;
+        res.area = 0.0;
+        res.volume = 0.0;
+
+        MeshFacetIterator it(kernel);
+        for (it.Init(); it.More(); it.Next()) {
+            const MeshGeomFacet& facet = *it;
+            if (facet.IsDegenerated(MeshDefinitions::_fMinPointDistanceD1))
+                res.countDegenerated++;
+            res.area += facet.Area();
+            // signed volume of the tetrahedron with the origin
+            Base::Vector3d p0(facet._aclPoints[0].x, facet._aclPoints[0].y, facet._aclPoints[0].z);
+            Base::Vector3d p1(facet._aclPoints[1].x, facet._aclPoints[1].y, facet._aclPoints[1].z);
+            Base::Vector3d p2(facet._aclPoints[2].x, facet._aclPoints[2].y, facet._aclPoints[2].z);
+            res.volume += (p0 * (p1 % p2)) / 6.0;
+        }
+
+        std::vector<char> border;
+        std::vector<std::pair<unsigned long, unsigned long> > edges;
+        chunkBorder(kernel, border, &edges);
+
+        const MeshPointArray& points = kernel.GetPoints();
+        res.countInnerPoints = 0;
+        for (std::size_t i = 0; i < border.size(); i++) {
+            if (border[i])
+                res.borderPoints.push_back(points[i]);
+            else
+                res.countInnerPoints++;
+        }
+
+        Vector3fLess less;
+        for (std::vector<std::pair<unsigned long, unsigned long> >::iterator jt = edges.begin(); jt != edges.end(); ++jt) {
+            Base::Vector3f p = points[jt->first];
+            Base::Vector3f q = points[jt->second];
+            if (less(q, p))
+                std::swap(p, q);
+            res.borderEdges.push_back(std::make_pair(p, q));
+        }
+    },
+    [&](unsigned long index, MeshKernel& kernel) {
+        ChunkResult& res = results[index];
+        stat.countFacets += kernel.CountFacets();
+        stat.countPoints += res.countInnerPoints;
+        stat.countDegenerated += res.countDegenerated;
+        stat.area += res.area;
+        stat.volume += res.volume;
+        stat.box.Add(kernel.GetBoundBox());
+        borderPoints.insert(borderPoints.end(), res.borderPoints.begin(), res.borderPoints.end());
+        borderEdges.insert(borderEdges.end(), res.borderEdges.begin(), res.borderEdges.end());
+
+        // release the memory of the processed chunk
+        std::vector<Base::Vector3f>().swap(res.borderPoints);
+        std::vector<EdgeLess::Edge>().swap(res.borderEdges);
+    });
+
+    // seam points are stored in several chunks
+    std::sort(borderPoints.begin(), borderPoints.end(), Vector3fLess());
+    Vector3fLess less;
+    stat.countPoints += std::unique(borderPoints.begin(), borderPoints.end(),
+        [&less](const Base::Vector3f& a, const Base::Vector3f& b) {
+            return !less(a, b) && !less(b, a);
+        }) - borderPoints.begin();
+
+    // seam edges are border edges of two chunks, the other ones are open edges of the mesh
+    EdgeLess edgeLess;
+    std::sort(borderEdges.begin(), borderEdges.end(), edgeLess);
+    for (std::size_t i = 0; i < borderEdges.size();) {
+        std::size_t j = i + 1;
+        while (j < borderEdges.size() && !edgeLess(borderEdges[i], borderEdges[j]))
+            j++;
+        if (j - i == 1)
+            stat.countBorderEdges++;
+        i = j;
+    }
+
+    return stat;
+}
+
+bool MeshChunkedProcessor::SaveSTL(const std::string& output, bool binary) const
+{
+    Base::FileInfo fi(output);
+    Base::ofstream str(fi, std::ios::out | std::ios::binary);
+    if (!str || str.bad())
+        return false;
+
+    if (binary) {
+        if (file.CountFacets() > UINT_MAX)
+            throw Base::ValueError("Too many facets for a binary STL file");
+        MeshOutput::SaveBinarySTLHeader(str, static_cast<uint32_t>(file.CountFacets()));
+    }
+    else {
+        str << "solid Mesh\n";
+    }
+
+    bool ok = true;
+    Process(std::function<void (unsigned long, MeshKernel&)>(),
+            [&str, &ok, binary](unsigned long, MeshKernel& kernel) {
+        MeshOutput out(kernel);
+        if (binary)
+            ok = out.SaveBinarySTLFacets(str) && ok;
+        else
+            ok = out.SaveAsciiSTLFacets(str) && ok;
+    });
+
+    if (!binary)
+        str << "endsolid Mesh\n";
+
+    return ok && str.good();
+}
+
+void MeshChunkedProcessor::Load(MeshKernel& kernel) const
+{
+    // the builder reserves three vertices per facet in an int sized array
+    if (file.CountFacets() > static_cast<uint64_t>(INT_MAX / 3))
+        throw Base::ValueError("Mesh is too big to be loaded");
+
+    // the seam points have identical coordinates and are merged again
+    MeshFastBuilder builder(kernel);
+    builder.Initialize(static_cast<MeshFastBuilder::size_type>(file.CountFacets()));
+    Process(std::function<void (unsigned long, MeshKernel&)>(),
+            [&builder](unsigned long, MeshKernel& chunk) {
+        MeshFacetIterator it(chunk);
+        for (it.Init(); it.More(); it.Next())
+            builder.AddFacet(*it);
+    });
+    builder.Finish();
+}
+
+bool MeshChunkedProcessor::ImportSTL(const std::string& input, const std::string& output,
+                                     unsigned long facetsPerChunk)
+{
+    Base::FileInfo fi(input);
+    Base::ifstream str(fi, std::ios::in | std::ios::binary);
+    if (!str || str.bad())
+        return false;
+
+    // first pass: bounding box and number of facets
+    STLTriangleReader reader(str);
+    MeshGeomFacet facet;
+    Base::BoundBox3f box;
+    uint64_t countFacets = 0;
+    while (reader.Next(facet)) {
+        for (int i = 0; i < 3; i++)
+            box.Add(facet._aclPoints[i]);
+        countFacets++;
+    }
+
+    if (countFacets == 0)
+        return false;
+
+    // a chunk must fit into MeshFastBuilder
+    const unsigned long maxFacets = static_cast<unsigned long>(INT_MAX / 3);
+    facetsPerChunk = std::max<unsigned long>(std::min(facetsPerChunk, maxFacets), 1);
+
+    // split the bounding box into cells: halve the longest cell edge until
+    // there are enough cells for the requested chunk size
+    uint64_t countCells = (countFacets + facetsPerChunk - 1) / facetsPerChunk;
+    int grid[3] = {1, 1, 1};
+    float length[3] = {box.LengthX(), box.LengthY(), box.LengthZ()};
+    while (static_cast<uint64_t>(grid[0]) * grid[1] * grid[2] < countCells) {
+        int axis = 0;
+        for (int i = 1; i < 3; i++) {
+            if (length[i] / grid[i] > length[axis] / grid[axis])
+                axis = i;
+        }
+        grid[axis] *= 2;
+    }
+
+    float minimum[3] = {box.MinX, box.MinY, box.MinZ};
+    std::size_t numCells = static_cast<std::size_t>(grid[0]) * grid[1] * grid[2];
+    auto cellOf = [&](const MeshGeomFacet& f) {
+        Base::Vector3f center = f.GetGravityPoint();
+        float coord[3] = {center.x, center.y, center.z};
+        std::size_t index = 0;
+        for (int i = 0; i < 3; i++) {
+            int pos = 0;
+            if (length[i] > 0.0f)
+                pos = static_cast<int>((coord[i] - minimum[i]) / length[i] * grid[i]);
+            pos = std::max(0, std::min(pos, grid[i] - 1));
+            index = index * grid[i] + pos;
+        }
+        return index;
+    };
+
+    // second pass: distribute the triangles to the cells. The triangles of a
+    // cell are buffered and flushed as a block to a temporary file
+    struct Block {
+        uint64_t offset;
+        uint32_t count;
+    };
+
+    std::string tmpName = Base::FileInfo::getTempFileName();
+    Base::FileInfo tmp(tmpName);
+    std::vector<std::vector<Block> > blocks(numCells);
+    const std::size_t blockSize = std::max<std::size_t>(256, std::min<std::size_t>(8192, facetsPerChunk / 4));
+
+    bool ok = false;
+    try {
+        Base::ofstream tmpOut(tmp, std::ios::out | std::ios::binary);
+        if (!tmpOut) {
+            tmp.deleteFile();
+            return false;
+        }
+
+        auto writeBlock = [&tmpOut](std::vector<float>& buffer, std::vector<Block>& list) {
+            if (buffer.empty())
+                return;
+            Block block;
+            block.offset = static_cast<uint64_t>(tmpOut.tellp());
+            block.count = static_cast<uint32_t>(buffer.size() / 9);
+            tmpOut.write(reinterpret_cast<const char*>(&buffer[0]), buffer.size() * sizeof(float));
+            list.push_back(block);
+            buffer.clear();
+        };
+
+        std::vector<std::vector<float> > buffers(numCells);
+        reader.Rewind();
+        while (reader.Next(facet)) {
+            std::size_t cell = cellOf(facet);
+            std::vector<float>& buffer = buffers[cell];
+            for (int i = 0; i < 3; i++) {
+                buffer.push_back(facet._aclPoints[i].x);
+                buffer.push_back(facet._aclPoints[i].y);
+                buffer.push_back(facet._aclPoints[i].z);
+            }
+            if (buffer.size() >= 9 * blockSize)
+                writeBlock(buffer, blocks[cell]);
+        }
+
+        for (std::size_t cell = 0; cell < numCells; cell++)
+            writeBlock(buffers[cell], blocks[cell]);
+        buffers.clear();
+
+        tmpOut.flush();
+        if (!tmpOut.good()) {
+            tmpOut.close();
+            tmp.deleteFile();
+            return false;
+        }
+
+        // third pass: weld the triangles of each cell and write it as chunk.
+        // A dense region can put many more triangles into a cell than requested,
+        // so such a cell is halved at the middle of its triangle centers and the
+        // halves are appended to the temporary file until each part fits. A part
+        // that cannot be split any more is written as several chunks.
+        Base::ifstream tmpIn(tmp, std::ios::in | std::ios::binary);
+        auto readBlock = [&tmpIn](const Block& block, std::vector<float>& buffer) {
+            buffer.resize(9 * static_cast<std::size_t>(block.count));
+            tmpIn.seekg(static_cast<std::streamoff>(block.offset), std::ios::beg);
+            tmpIn.read(reinterpret_cast<char*>(&buffer[0]), buffer.size() * sizeof(float));
+        };
+        auto centerOf = [](const float* data) {
+            return Base::Vector3f((data[0] + data[3] + data[6]) / 3.0f,
+                                  (data[1] + data[4] + data[7]) / 3.0f,
+                                  (data[2] + data[5] + data[8]) / 3.0f);
+        };
+
+        std::vector<float> buffer;
+        auto splitPart = [&](const std::vector<Block>& part, std::vector<std::vector<Block> >& parts) {
+            Base::BoundBox3f bbox;
+            for (std::vector<Block>::const_iterator it = part.begin(); it != part.end(); ++it) {
+                readBlock(*it, buffer);
+                for (uint32_t i = 0; i < it->count; i++)
+                    bbox.Add(centerOf(&buffer[9*i]));
+            }
+
+            float length[3] = {bbox.LengthX(), bbox.LengthY(), bbox.LengthZ()};
+            float minimum[3] = {bbox.MinX, bbox.MinY, bbox.MinZ};
+            int axis = 0;
+            for (int i = 1; i < 3; i++) {
+                if (length[i] > length[axis])
+                    axis = i;
+            }
+
+            // both halves must get triangles
+            float middle = minimum[axis] + 0.5f * length[axis];
+            if (!(middle > minimum[axis]))
+                return false;
+
+            std::vector<float> halves[2];
+            std::vector<Block> lists[2];
+            for (std::vector<Block>::const_iterator it = part.begin(); it != part.end(); ++it) {
+                readBlock(*it, buffer);
+                for (uint32_t i = 0; i < it->count; i++) {
+                    const float* data = &buffer[9*i];
+                    Base::Vector3f center = centerOf(data);
+                    float coord[3] = {center.x, center.y, center.z};
+                    std::vector<float>& half = halves[coord[axis] < middle ? 0 : 1];
+                    half.insert(half.end(), data, data + 9);
+                    if (half.size() >= 9 * blockSize)
+                        writeBlock(half, lists[coord[axis] < middle ? 0 : 1]);
+                }
+            }
+
+            writeBlock(halves[0], lists[0]);
+            writeBlock(halves[1], lists[1]);
+            tmpOut.flush();
+            parts.push_back(lists[1]);
+            parts.push_back(lists[0]);
+            return true;
+        };
+
+        MeshChunkedWriter writer(output);
+        if (tmpIn && writer.IsOpen()) {
+            Base::SequencerLauncher seq("Creating mesh chunks...", numCells);
+            std::vector<std::vector<Block> > parts;
+            for (std::size_t cell = 0; cell < numCells; cell++) {
+                parts.push_back(blocks[cell]);
+                std::vector<Block>().swap(blocks[cell]);
+                while (!parts.empty()) {
+                    std::vector<Block> part;
+                    part.swap(parts.back());
+                    parts.pop_back();
+
+                    uint64_t count = 0;
+                    for (std::vector<Block>::iterator it = part.begin(); it != part.end(); ++it)
+                        count += it->count;
+                    if (count == 0)
+                        continue;
+                    if (count > facetsPerChunk && splitPart(part, parts))
+                        continue;
+
+                    MeshKernel kernel;
+                    std::unique_ptr<MeshFastBuilder> builder;
+                    uint64_t added = 0;
+                    for (std::vector<Block>::iterator it = part.begin(); it != part.end(); ++it) {
+                        readBlock(*it, buffer);
+                        for (uint32_t i = 0; i < it->count; i++) {
+                            if (!builder) {
+                                builder.reset(new MeshFastBuilder(kernel));
+                                builder->Initialize(static_cast<MeshFastBuilder::size_type>
+                                    (std::min<uint64_t>(count - added, facetsPerChunk)));
+                            }
+                            Base::Vector3f points[3];
+                            for (int j = 0; j < 3; j++)
+                                points[j].Set(buffer[9*i+3*j], buffer[9*i+3*j+1], buffer[9*i+3*j+2]);
+                            builder->AddFacet(points);
+                            if (++added % facetsPerChunk == 0) {
+                                builder->Finish();
+                                writer.AddChunk(kernel);
+                                builder.reset();
+                            }
+                        }
+                    }
+                    if (builder) {
+                        builder->Finish();
+                        writer.AddChunk(kernel);
+                    }
+                }
+                seq.next(true); // allow to cancel
+            }
+
+            ok = tmpIn.good() && tmpOut.good() && writer.Finish();
+        }
+    }
+    catch (...) {
+        tmp.deleteFile();
+        throw;
+    }
+
+    tmp.deleteFile();
+    return ok;
+}
@@ -0,0 +1,205 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef MESH_CHUNKEDMESH_H
+#define MESH_CHUNKEDMESH_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <Base/BoundBox.h>
+#include <Base/Matrix.h>
+#include <Base/Stream.h>
+
+namespace MeshCore
+{
+class MeshKernel;
+
+/**
+ * Describes a chunk of a chunked mesh file.
+ */
+struct MeshExport MeshChunkInfo
+{
+    uint64_t offset;        /**< file offset of the point array */
+    uint32_t countPoints;
+    uint32_t countFacets;
+    Base::BoundBox3f box;
+};
+
+/**
+ * The MeshChunkedFile class gives read access to a mesh that is too big to be
+ * kept in memory as a whole.
+ *
+ * The file consists of a header, the chunks and a chunk table at the end.
+ * Each chunk is a self-contained mesh of a spatial cell: a point array of
+ * float triples followed by a facet array of 32-bit index triples. The points
+ * on the seam between two chunks are stored in both chunks with identical
+ * coordinates, so algorithms can work on a chunk in isolation as long as they
+ * keep the chunk boundary fixed.
+ *
+ * The file is memory-mapped if possible, hence loading a chunk only touches
+ * the pages of this chunk. LoadChunk() can be called from several threads.
+ */
+class MeshExport MeshChunkedFile
+{
+public:
+    MeshChunkedFile();
+    ~MeshChunkedFile();
+
+    /** Opens the file. Returns false if the file doesn't exist or isn't a
+     * chunked mesh file. */
+    bool Open(const std::string& fileName);
+    void Close();
+    bool IsOpen() const;
+
+    unsigned long CountChunks() const
+    { return static_cast<unsigned long>(chunks.size()); }
+    /** The number of points of all chunks. Seam points are counted once per chunk. */
+    uint64_t CountPoints() const
+    { return countPoints; }
+    uint64_t CountFacets() const
+    { return countFacets; }
+    const Base::BoundBox3f& GetBoundBox() const
+    { return boundBox; }
+    const MeshChunkInfo& GetChunkInfo(unsigned long index) const
+    { return chunks[index]; }
+    /** Replaces the content of \a kernel with the chunk \a index. */
+    void LoadChunk(unsigned long index, MeshKernel& kernel) const;
+
+    /** Returns true if the file starts with the signature of a chunked mesh. */
+    static bool IsChunkedFile(const std::string& fileName);
+
+private:
+    MeshChunkedFile(const MeshChunkedFile&);
+    MeshChunkedFile& operator = (const MeshChunkedFile&);
+
+private:
+    bool ReadAt(uint64_t offset, void* buffer, uint64_t size) const;
+
+private:
+    struct Private;
+    Private* d;
+    std::vector<MeshChunkInfo> chunks;
+    uint64_t countPoints;
+    uint64_t countFacets;
+    Base::BoundBox3f boundBox;
+};
+
+/**
+ * The MeshChunkedWriter class writes a chunked mesh file chunk by chunk.
+ * Only the chunk table is kept in memory.
+ */
+class MeshExport MeshChunkedWriter
+{
+public:
+    MeshChunkedWriter(const std::string& fileName);
+    ~MeshChunkedWriter();
+
+    bool IsOpen() const;
+    /** Appends \a kernel as new chunk. Empty meshes are skipped. */
+    void AddChunk(const MeshKernel& kernel);
+    /** Writes the chunk table and the header. Must be called after the last chunk. */
+    bool Finish();
+
+private:
+    Base::ofstream str;
+    std::vector<MeshChunkInfo> chunks;
+    uint64_t countPoints;
+    uint64_t countFacets;
+    Base::BoundBox3f boundBox;
+};
+
+/**
+ * Global properties of a chunked mesh that are computed by
+ * MeshChunkedProcessor::Evaluate().
+ */
+struct MeshExport MeshChunkedStatistics
+{
+    MeshChunkedStatistics();
+
+    uint64_t countFacets;
+    uint64_t countPoints;           /**< unique points, seam points are counted once */
+    uint64_t countBorderEdges;      /**< open edges of the whole mesh */
+    uint64_t countDegenerated;
+    double area;
+    double volume;                  /**< only meaningful for a closed mesh */
+    Base::BoundBox3f box;
+};
+
+/**
+ * The MeshChunkedProcessor class runs algorithms on a chunked mesh with
+ * bounded memory: at any time only a batch of as many chunks as there are
+ * cores is loaded, the chunks of a batch are processed concurrently and
+ * written sequentially.
+ *
+ * Algorithms that change the mesh keep the seam points between chunks fixed,
+ * so the chunks of the result still fit together. Hence smoothing and
+ * decimation don't touch a small band around each seam.
+ */
+class MeshExport MeshChunkedProcessor
+{
+public:
+    MeshChunkedProcessor(const MeshChunkedFile& file);
+
+    /** Imports the STL file \a input into the chunked file \a output. The file is
+     * read three times: to compute the bounding box, to distribute the triangles
+     * to spatial cells of about \a facetsPerChunk triangles and to weld each cell
+     * to a chunk. The triangles of a cell are buffered in a temporary file. Cells
+     * with more than \a facetsPerChunk triangles are split, so no chunk exceeds it.
+     */
+    static bool ImportSTL(const std::string& input, const std::string& output,
+                          unsigned long facetsPerChunk = 1000000);
+
+    /** Transforms all chunks and writes the result to \a output. */
+    bool Transform(const Base::Matrix4D& mat, const std::string& output) const;
+    /** Laplace smoothing of all chunks where the chunk boundaries are kept fixed. */
+    bool Smooth(int iterations, float lambda, const std::string& output) const;
+    /** Decimates all chunks to \a reduction of their facets where the chunk
+     * boundaries are locked. Edge collapses are rejected if they exceed
+     * the tolerance \a maxError. */
+    bool Decimate(float reduction, float maxError, const std::string& output) const;
+    /** Computes the statistics of the whole mesh. */
+    MeshChunkedStatistics Evaluate() const;
+    /** Writes the whole mesh as a binary or ASCII STL file. */
+    bool SaveSTL(const std::string& output, bool binary = true) const;
+    /** Loads the whole mesh into \a kernel. Only useful if it fits into memory. */
+    void Load(MeshKernel& kernel) const;
+
+    /** Calls \a func for each chunk. The chunks of a batch are loaded and
+     * processed concurrently while \a done is called in order of the chunks
+     * from the calling thread. */
+    void Process(const std::function<void (unsigned long, MeshKernel&)>& func,
+                 const std::function<void (unsigned long, MeshKernel&)>& done) const;
+
+private:
+    bool Modify(const std::function<void (unsigned long, MeshKernel&)>& func,
+                const std::string& output) const;
+
+private:
+    const MeshChunkedFile& file;
+};
+
+} // namespace MeshCore
+
+
+#endif  // MESH_CHUNKEDMESH_H
@@ -35,7 +35,8 @@
 #include <Eigen/Eigenvalues>
 #else
 #include <Mod/Mesh/App/WildMagic4/Wm4Vector3.h>
-#include <Mod/Mesh/App/WildMagic4/Wm4MeshCurvature.h>
+#include <Mod/Mesh/App/WildMagic4/Wm4Matrix2.h>
+#include <Mod/Mesh/App/WildMagic4/Wm4Matrix3.h>
 #endif
 
 #include "Curvature.h"
@@ -44,6 +45,7 @@
 #include "MeshKernel.h"
 #include "Iterator.h"
 #include "Tools.h"
+#include "Functional.h"
 #include <Base/Sequencer.h>
 #include <Base/Tools.h>
 
@@ -90,6 +92,12 @@ void MeshCurvature::ComputePerFace(bool parallel)
     }
 }
 
+void MeshCurvature::ComputePerVertex()
+{
+    MeshCompactPointToFacets pt2f(myKernel);
+    ComputePerVertex(pt2f);
+}
+
 #ifdef OPTIMIZE_CURVATURE
 namespace MeshCore {
 void GenerateComplementBasis (Eigen::Vector3f& rkU, Eigen::Vector3f& rkV,
@@ -122,7 +130,7 @@ void GenerateComplementBasis (Eigen::Vector3f& rkU, Eigen::Vector3f& rkV,
 }
 }
 
-void MeshCurvature::ComputePerVertex()
+void MeshCurvature::ComputePerVertex(const MeshCompactPointToFacets&)
 {
     // get all points
     const MeshPointArray& pts = myKernel.GetPoints();
@@ -289,51 +297,131 @@ void MeshCurvature::ComputePerVertex()
     }
 }
 #else
-void MeshCurvature::ComputePerVertex()
+void MeshCurvature::ComputePerVertex(const MeshCompactPointToFacets& pt2f)
 {
     myCurvature.clear();
 
-    // get all points
-    std::vector< Wm4::Vector3<double> > aPnts;
-    aPnts.reserve(myKernel.CountPoints());
-    MeshPointIterator cPIt(myKernel);
-    for (cPIt.Init(); cPIt.More(); cPIt.Next()) {
-        Wm4::Vector3<double> cP(cPIt->x, cPIt->y, cPIt->z);
-        aPnts.push_back(cP);
-    }
-
-    // get all point connections
-    std::vector<int> aIdx;
-    aIdx.reserve(3*myKernel.CountFacets());
-    const MeshFacetArray& raFts = myKernel.GetFacets();
-    for (MeshFacetArray::const_iterator jt = raFts.begin(); jt != raFts.end(); ++jt) {
-        for (int i=0; i<3; i++) {
-            aIdx.push_back((int)jt->_aulPoints[i]);
-        }
-    }
-
     // in case of an empty mesh no curvature can be calculated
     if (myKernel.CountPoints() == 0 || myKernel.CountFacets() == 0)
         return;
 
-    // compute vertex based curvatures
-    Wm4::MeshCurvature<double> meshCurv(myKernel.CountPoints(), &(aPnts[0]), myKernel.CountFacets(), &(aIdx[0]));
+    // This is the estimation of Wm4::MeshCurvature but instead of scattering the
+    // contributions of each triangle to its vertexes they are gathered per vertex
+    // from its adjacent facets. So, all vertexes can be handled concurrently.
+    const MeshPointArray& rPoints = myKernel.GetPoints();
+    const MeshFacetArray& rFacets = myKernel.GetFacets();
+    unsigned long numPoints = rPoints.size();
+    int threads = std::max(1, QThread::idealThreadCount());
+
+    std::vector< Wm4::Vector3<double> > aPnts(numPoints);
+    parallel_for(0, numPoints, [&](unsigned long first, unsigned long last) {
+        for (unsigned long i = first; i < last; i++) {
+            const MeshPoint& p = rPoints[i];
+            aPnts[i] = Wm4::Vector3<double>(p.x, p.y, p.z);
+        }
+    }, threads);
+
+    // compute normal vectors, the length of the cross products provides a weighted sum
+    std::vector< Wm4::Vector3<double> > aNormals(numPoints);
+    parallel_for(0, numPoints, [&](unsigned long first, unsigned long last) {
+        for (unsigned long i = first; i < last; i++) {
+            Wm4::Vector3<double> kNormal(0, 0, 0);
+            for (const unsigned long* it = pt2f.Begin(i); it != pt2f.End(i); ++it) {
+                const MeshFacet& rFacet = rFacets[*it];
+                const Wm4::Vector3<double>& rV0 = aPnts[rFacet._aulPoints[0]];
+                kNormal += (aPnts[rFacet._aulPoints[1]] - rV0).Cross(aPnts[rFacet._aulPoints[2]] - rV0);
+            }
+            kNormal.Normalize();
+            aNormals[i] = kNormal;
+        }
+    }, threads);
+
+    myCurvature.resize(numPoints);
+    parallel_for(0, numPoints, [&](unsigned long first, unsigned long last) {
+        for (unsigned long i = first; i < last; i++) {
+            const Wm4::Vector3<double>& kN = aNormals[i];
+
+            // Compute the edges from the vertex to the other two points of each
+            // adjacent facet, project them to the tangent plane of the vertex,
+            // and compute the difference of the adjacent normals.
+            Wm4::Matrix3<double> kWWTrn, kDWTrn;
+            for (const unsigned long* it = pt2f.Begin(i); it != pt2f.End(i); ++it) {
+                const MeshFacet& rFacet = rFacets[*it];
+                for (int j = 0; j < 3; j++) {
+                    unsigned long iV1 = rFacet._aulPoints[j];
+                    if (iV1 == i)
+                        continue;
+                    Wm4::Vector3<double> kE = aPnts[iV1] - aPnts[i];
+                    Wm4::Vector3<double> kW = kE - (kE.Dot(kN))*kN;
+                    Wm4::Vector3<double> kD = aNormals[iV1] - kN;
+                    for (int iRow = 0; iRow < 3; iRow++) {
+                        for (int iCol = 0; iCol < 3; iCol++) {
+                            kWWTrn[iRow][iCol] += kW[iRow]*kW[iCol];
+                            kDWTrn[iRow][iCol] += kD[iRow]*kW[iCol];
+                        }
+                    }
+                }
+            }
+
+            // Add in N*N^T to W*W^T for numerical stability and compute the
+            // matrix of normal derivatives.
+            for (int iRow = 0; iRow < 3; iRow++) {
+                for (int iCol = 0; iCol < 3; iCol++) {
+                    kWWTrn[iRow][iCol] = 0.5*kWWTrn[iRow][iCol] + kN[iRow]*kN[iCol];
+                    kDWTrn[iRow][iCol] *= 0.5;
+                }
+            }
+            Wm4::Matrix3<double> kDNormal = kDWTrn*kWWTrn.Inverse();
+
+            // The principal curvatures are the eigenvalues of the shape matrix
+            // S = J^T * dN/dX * J with J = [U | V], see Wm4::MeshCurvature.
+            Wm4::Vector3<double> kU, kV;
+            Wm4::Vector3<double>::GenerateComplementBasis(kU, kV, kN);
+
+            double fS01 = kU.Dot(kDNormal*kV);
+            double fS10 = kV.Dot(kDNormal*kU);
+            double fSAvr = 0.5*(fS01+fS10);
+            Wm4::Matrix2<double> kS(kU.Dot(kDNormal*kU), fSAvr,
+                                    fSAvr, kV.Dot(kDNormal*kV));
+
+            double fTrace = kS[0][0] + kS[1][1];
+            double fDet = kS[0][0]*kS[1][1] - kS[0][1]*kS[1][0];
+            double fDiscr = fTrace*fTrace - 4.0*fDet;
+            double fRootDiscr = sqrt(fabs(fDiscr));
+            double fMinCurvature = 0.5*(fTrace - fRootDiscr);
+            double fMaxCurvature = 0.5*(fTrace + fRootDiscr);
+
+            // compute the eigenvectors of S
+            Wm4::Vector3<double> kMinDir, kMaxDir;
+            Wm4::Vector2<double> kW0(kS[0][1], fMinCurvature-kS[0][0]);
+            Wm4::Vector2<double> kW1(fMinCurvature-kS[1][1], kS[1][0]);
+            if (kW0.SquaredLength() >= kW1.SquaredLength()) {
+                kW0.Normalize();
+                kMinDir = kW0.X()*kU + kW0.Y()*kV;
+            }
+            else {
+                kW1.Normalize();
+                kMinDir = kW1.X()*kU + kW1.Y()*kV;
+            }
 
-    // get curvature information now
-    const Wm4::Vector3<double>* aMaxCurvDir = meshCurv.GetMaxDirections();
-    const Wm4::Vector3<double>* aMinCurvDir = meshCurv.GetMinDirections();
-    const double* aMaxCurv = meshCurv.GetMaxCurvatures();
-    const double* aMinCurv = meshCurv.GetMinCurvatures();
+            kW0 = Wm4::Vector2<double>(kS[0][1], fMaxCurvature-kS[0][0]);
+            kW1 = Wm4::Vector2<double>(fMaxCurvature-kS[1][1], kS[1][0]);
+            if (kW0.SquaredLength() >= kW1.SquaredLength()) {
+                kW0.Normalize();
+                kMaxDir = kW0.X()*kU + kW0.Y()*kV;
+            }
+            else {
+                kW1.Normalize();
+                kMaxDir = kW1.X()*kU + kW1.Y()*kV;
+            }
 
-    myCurvature.reserve(myKernel.CountPoints());
-    for (unsigned long i=0; i<myKernel.CountPoints(); i++) {
-        CurvatureInfo ci;
-        ci.cMaxCurvDir = Base::Vector3f((float)aMaxCurvDir[i].X(), (float)aMaxCurvDir[i].Y(), (float)aMaxCurvDir[i].Z());
-        ci.cMinCurvDir = Base::Vector3f((float)aMinCurvDir[i].X(), (float)aMinCurvDir[i].Y(), (float)aMinCurvDir[i].Z());
-        ci.fMaxCurvature = (float)aMaxCurv[i];
-        ci.fMinCurvature = (float)aMinCurv[i];
-        myCurvature.push_back(ci);
-    }
+            CurvatureInfo& ci = myCurvature[i];
+            ci.cMaxCurvDir = Base::Vector3f((float)kMaxDir.X(), (float)kMaxDir.Y(), (float)kMaxDir.Z());
+            ci.cMinCurvDir = Base::Vector3f((float)kMinDir.X(), (float)kMinDir.Y(), (float)kMinDir.Z());
+            ci.fMaxCurvature = (float)fMaxCurvature;
+            ci.fMinCurvature = (float)fMinCurvature;
+        }
+    }, threads);
 }
 #endif // OPTIMIZE_CURVATURE
 
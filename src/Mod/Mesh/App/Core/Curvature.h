@@ -30,6 +30,7 @@ namespace MeshCore {
 
 class MeshKernel;
 class MeshRefPointToFacets;
+class MeshCompactPointToFacets;
 
 /** Curvature information. */
 struct MeshExport CurvatureInfo
@@ -60,6 +61,8 @@ public:
     void SetRadius(float r) { myRadius = r; }
     void ComputePerFace(bool parallel);
     void ComputePerVertex();
+    /// Computes the curvature of all points concurrently using the given point to facets structure.
+    void ComputePerVertex(const MeshCompactPointToFacets&);
     const std::vector<CurvatureInfo>& GetCurvature() const { return myCurvature; }
 
 private:
@@ -23,14 +23,20 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
+# include <unordered_map>
 #endif
 
+#include <QThread>
+#include <QtConcurrentMap>
+
 #include "Decimation.h"
 #include "MeshKernel.h"
 #include "Algorithm.h"
 #include "Iterator.h"
 #include "TopoAlgorithm.h"
 #include <Base/Tools.h>
+#include "Functional.h"
 #include "Simplify.h"
 
 
@@ -53,6 +59,8 @@ void MeshSimplify::simplify(float tolerance, float reduction)
     for (std::size_t i = 0; i < points.size(); i++) {
         Simplify::Vertex v;
         v.tstart = 0;
+        v.locked = 0;
+        v.id = static_cast<int>(i);
         v.p = points[i];
         alg.vertices.push_back(v);
     }
@@ -107,6 +115,8 @@ void MeshSimplify::simplify(int targetSize)
     for (std::size_t i = 0; i < points.size(); i++) {
         Simplify::Vertex v;
         v.tstart = 0;
+        v.locked = 0;
+        v.id = static_cast<int>(i);
         v.p = points[i];
         alg.vertices.push_back(v);
     }
@@ -150,3 +160,281 @@ void MeshSimplify::simplify(int targetSize)
 
     myKernel.Adopt(new_points, new_facets, true);
 }
+
+// ----------------------------------------------------------------------
+
+namespace MeshCore {
+
+/*
+ * A spatial partition of the facets, sorted by their index.
+ */
+struct SimplifyPartition
+{
+    std::vector<unsigned long> facets;
+    int targetSize;
+};
+
+/*
+ * Splits the facets recursively at the median of their centers along the
+ * longest side until there are \a parts partitions.
+ */
+static void SplitPartitions(std::vector<unsigned long>::iterator first,
+                            std::vector<unsigned long>::iterator last,
+                            const std::vector<Base::Vector3f>& centers, int parts,
+                            std::vector<SimplifyPartition>& partitions)
+{
+    if (parts <= 1 || last - first < 2) {
+        SimplifyPartition part;
+        part.facets.assign(first, last);
+        part.targetSize = 0;
+        std::sort(part.facets.begin(), part.facets.end());
+        partitions.push_back(part);
+        return;
+    }
+
+    Base::BoundBox3f box;
+    for (std::vector<unsigned long>::iterator it = first; it != last; ++it)
+        box.Add(centers[*it]);
+
+    float Base::Vector3f::* coord = &Base::Vector3f::x;
+    if (box.LengthY() > box.LengthX() && box.LengthY() >= box.LengthZ())
+        coord = &Base::Vector3f::y;
+    else if (box.LengthZ() > box.LengthX() && box.LengthZ() > box.LengthY())
+        coord = &Base::Vector3f::z;
+
+    std::vector<unsigned long>::iterator mid = first + (last - first) / 2;
+    std::nth_element(first, mid, last, [&centers, coord](unsigned long a, unsigned long b) {
+        return centers[a].*coord < centers[b].*coord;
+    });
+
+    SplitPartitions(first, mid, centers, parts / 2, partitions);
+    SplitPartitions(mid, last, centers, parts - parts / 2, partitions);
+}
+
+/*
+ * Decimates the facets of a partition in place. Locked points are neither
+ * moved nor removed, all other points must only be used by the facets of the
+ * partition. The remaining facets are written to the first slots of the
+ * partition, the other slots are marked as invalid.
+ */
+class PartitionSimplifier
+{
+public:
+    PartitionSimplifier(MeshPointArray& points, MeshFacetArray& facets,
+                        const std::vector<char>& locked, std::vector<int>& localIndex,
+                        float maxError)
+      : points(points)
+      , facets(facets)
+      , locked(locked)
+      , localIndex(localIndex)
+      , maxError(maxError)
+    {
+    }
+    void operator()(SimplifyPartition& part) const
+    {
+        Simplify alg;
+        if (maxError < FLT_MAX)
+            alg.max_error = static_cast<double>(maxError) * static_cast<double>(maxError);
+
+        // the index of an unlocked point is only written by this partition
+        // while locked points may be shared with other partitions
+        std::unordered_map<unsigned long, int> lockedIndex;
+        alg.triangles.reserve(part.facets.size());
+        for (std::vector<unsigned long>::const_iterator it = part.facets.begin(); it != part.facets.end(); ++it) {
+            const MeshFacet& face = facets[*it];
+            Simplify::Triangle t;
+            for (int j = 0; j < 4; j++)
+                t.err[j] = 0.0;
+            for (int j = 0; j < 3; j++) {
+                unsigned long index = face._aulPoints[j];
+                int* local;
+                if (locked[index]) {
+                    local = &lockedIndex.insert(std::make_pair(index, -1)).first->second;
+                }
+                else {
+                    local = &localIndex[index];
+                }
+
+                if (*local < 0) {
+                    Simplify::Vertex v;
+                    v.tstart = 0;
+                    v.locked = locked[index];
+                    v.id = static_cast<int>(index);
+                    v.p = points[index];
+                    *local = static_cast<int>(alg.vertices.size());
+                    alg.vertices.push_back(v);
+                }
+                t.v[j] = *local;
+            }
+            alg.triangles.push_back(t);
+        }
+
+        alg.simplify_mesh(part.targetSize, alg.max_error);
+
+        for (std::vector<Simplify::Vertex>::iterator it = alg.vertices.begin(); it != alg.vertices.end(); ++it) {
+            if (!locked[it->id])
+                points[it->id].Set(it->p.x, it->p.y, it->p.z);
+        }
+
+        std::size_t index = 0;
+        for (; index < alg.triangles.size(); index++) {
+            const Simplify::Triangle& t = alg.triangles[index];
+            facets[part.facets[index]] = MeshFacet(alg.vertices[t.v[0]].id,
+                                                   alg.vertices[t.v[1]].id,
+                                                   alg.vertices[t.v[2]].id);
+        }
+        for (; index < part.facets.size(); index++) {
+            facets[part.facets[index]].SetInvalid();
+        }
+    }
+
+private:
+    MeshPointArray& points;
+    MeshFacetArray& facets;
+    const std::vector<char>& locked;
+    std::vector<int>& localIndex;
+    float maxError;
+};
+
+}
+
+void MeshSimplify::simplify(int targetSize, float maxError)
+{
+    // Take over the arrays of the kernel to work on them in place
+    MeshPointArray points;
+    MeshFacetArray facets;
+    myKernel.Adopt(points, facets, false);
+
+    try {
+        unsigned long countFacets = facets.size();
+        int threads = std::max(1, QThread::idealThreadCount());
+
+        // A partition should not become too small as its boundary is locked
+        const unsigned long minPartitionSize = 20000;
+        int numPartitions = 1;
+        while (numPartitions < 2 * threads && countFacets / (2 * numPartitions) >= minPartitionSize)
+            numPartitions *= 2;
+
+        std::vector<SimplifyPartition> partitions;
+        if (numPartitions > 1) {
+            std::vector<Base::Vector3f> centers(countFacets);
+            parallel_for(0, countFacets, [&](unsigned long first, unsigned long last) {
+                for (unsigned long i = first; i < last; i++) {
+                    const MeshFacet& face = facets[i];
+                    centers[i] = (points[face._aulPoints[0]] +
+                                  points[face._aulPoints[1]] +
+                                  points[face._aulPoints[2]]) / 3.0f;
+                }
+            }, threads);
+
+            std::vector<unsigned long> order(countFacets);
+            for (unsigned long i = 0; i < countFacets; i++)
+                order[i] = i;
+            SplitPartitions(order.begin(), order.end(), centers, numPartitions, partitions);
+        }
+        else {
+            SimplifyPartition part;
+            part.facets.resize(countFacets);
+            for (unsigned long i = 0; i < countFacets; i++)
+                part.facets[i] = i;
+            partitions.push_back(part);
+        }
+
+        // Lock the points that are shared by facets of different partitions
+        std::vector<int> owner(points.size(), -1);
+        for (std::size_t i = 0; i < partitions.size(); i++) {
+            SimplifyPartition& part = partitions[i];
+            part.targetSize = static_cast<int>(static_cast<double>(targetSize) *
+                static_cast<double>(part.facets.size()) / static_cast<double>(countFacets));
+            for (std::vector<unsigned long>::iterator it = part.facets.begin(); it != part.facets.end(); ++it) {
+                for (int j = 0; j < 3; j++) {
+                    int& pointOwner = owner[facets[*it]._aulPoints[j]];
+                    if (pointOwner == -1)
+                        pointOwner = static_cast<int>(i);
+                    else if (pointOwner != static_cast<int>(i))
+                        pointOwner = -2;
+                }
+            }
+        }
+
+        std::vector<char> userLocked(points.size());
+        for (std::vector<unsigned long>::const_iterator it = lockedPoints.begin(); it != lockedPoints.end(); ++it) {
+            if (*it < points.size())
+                userLocked[*it] = 1;
+        }
+
+        std::vector<char> locked(points.size());
+        for (std::size_t i = 0; i < points.size(); i++)
+            locked[i] = owner[i] == -2 || userLocked[i];
+
+        std::vector<int> localIndex(points.size(), -1);
+        PartitionSimplifier simplifier(points, facets, locked, localIndex, maxError);
+        if (partitions.size() > 1)
+            QtConcurrent::blockingMap(partitions, simplifier);
+        else
+            simplifier(partitions.front());
+
+        // Decimate the seams: all facets around the previously locked points
+        // where only these points are unlocked
+        if (partitions.size() > 1) {
+            SimplifyPartition seam;
+            unsigned long countValid = 0;
+            for (unsigned long i = 0; i < countFacets; i++) {
+                const MeshFacet& face = facets[i];
+                if (!face.IsValid())
+                    continue;
+                countValid++;
+                if (owner[face._aulPoints[0]] == -2 || owner[face._aulPoints[1]] == -2 || owner[face._aulPoints[2]] == -2)
+                    seam.facets.push_back(i);
+            }
+
+            if (countValid > static_cast<unsigned long>(std::max(targetSize, 0)) && !seam.facets.empty()) {
+                unsigned long excess = countValid - static_cast<unsigned long>(std::max(targetSize, 0));
+                seam.targetSize = static_cast<int>(seam.facets.size() > excess ? seam.facets.size() - excess : 0);
+                for (std::size_t i = 0; i < points.size(); i++)
+                    locked[i] = owner[i] != -2 || userLocked[i];
+                PartitionSimplifier seamSimplifier(points, facets, locked, localIndex, maxError);
+                seamSimplifier(seam);
+            }
+        }
+
+        // Remove the invalid facets and the points that are not used any more
+        facets.erase(std::remove_if(facets.begin(), facets.end(), [](const MeshFacet& face) {
+            return !face.IsValid();
+        }), facets.end());
+
+        std::vector<unsigned long> pointIndex(points.size(), ULONG_MAX);
+        for (MeshFacetArray::_TConstIterator it = facets.begin(); it != facets.end(); ++it) {
+            for (int j = 0; j < 3; j++)
+                pointIndex[it->_aulPoints[j]] = 0;
+        }
+
+        unsigned long countPoints = 0;
+        for (unsigned long i = 0; i < points.size(); i++) {
+            if (pointIndex[i] != ULONG_MAX) {
+                pointIndex[i] = countPoints;
+                points[countPoints++] = points[i];
+            }
+        }
+        points.resize(countPoints);
+
+        parallel_for(0, facets.size(), [&](unsigned long first, unsigned long last) {
+            for (unsigned long i = first; i < last; i++) {
+                MeshFacet& face = facets[i];
+                for (int j = 0; j < 3; j++)
+                    face._aulPoints[j] = pointIndex[face._aulPoints[j]];
+            }
+        }, threads);
+    }
+    catch (...) {
+        myKernel.Adopt(points, facets, true);
+        throw;
+    }
+
+    myKernel.Adopt(points, facets, true);
+}
+
+void MeshSimplify::setLockedPoints(const std::vector<unsigned long>& points)
+{
+    lockedPoints = points;
+}
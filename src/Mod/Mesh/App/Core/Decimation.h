@@ -24,6 +24,7 @@
 #ifndef MESH_DECIMATION_H
 #define MESH_DECIMATION_H
 
+#include <vector>
 
 namespace MeshCore
 {
@@ -36,9 +37,29 @@ public:
     ~MeshSimplify();
     void simplify(float tolerance, float reduction);
     void simplify(int targetSize);
+    /**
+     * Decimates the mesh concurrently. The mesh is split into spatial
+     * partitions that are decimated independently while the points shared
+     * by several partitions are locked. Afterwards the seams between the
+     * partitions are decimated. An edge collapse is rejected if its quadric
+     * error, i.e. the sum of the squared distances of the new point to the
+     * planes of the facets merged into it, exceeds \a maxError squared. In
+     * this case the result keeps more than \a targetSize facets.
+     * @note This is a bound on the quadric error of each pass, not on the
+     * distance to the original facets. The planes are unbounded and the
+     * quadrics of the seam pass are built from the decimated partitions.
+     */
+    void simplify(int targetSize, float maxError);
+    /**
+     * Sets the points that are neither moved nor removed by
+     * simplify(int, float), e.g. the boundary of a mesh chunk that must
+     * stay compatible with its neighbours.
+     */
+    void setLockedPoints(const std::vector<unsigned long>& points);
 
 private:
     MeshKernel& myKernel;
+    std::vector<unsigned long> lockedPoints;
 };
 
 } // namespace MeshCore
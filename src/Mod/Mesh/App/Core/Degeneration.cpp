@@ -38,6 +38,7 @@
 #include "Info.h"
 #include "Grid.h"
 #include "TopoAlgorithm.h"
+#include "Functional.h"
 
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <Base/Sequencer.h>
@@ -94,81 +95,54 @@ bool MeshFixInvalids::Fixup()
 
 namespace MeshCore {
 
-typedef MeshPointArray::_TConstIterator VertexIterator;
 /*
  * When building up a mesh then usually the class MeshBuilder is used. This
- * class uses internally a std::set<MeshPoint> which uses the '<' operator of
- * MeshPoint to sort the points. Thus to be consistent (and avoid using the
- * '==' operator of MeshPoint) we use the same operator when comparing the
- * points in the function object.
+ * class merges the points by sorting them with the '<' operator of
+ * MeshPoint. Thus to be consistent (and avoid using the '==' operator of
+ * MeshPoint) we use the same operator when comparing the points in the
+ * function object.
  */
-struct Vertex_EqualTo
+struct Vertex_Less
 {
-    bool operator()(const VertexIterator& x,
-                    const VertexIterator& y) const
+    Vertex_Less(const MeshPointArray& rPoints) : rPoints(rPoints) {}
+    bool operator()(unsigned long x, unsigned long y) const
     {
-        if ( (*x) < (*y) )
-            return false;
-        else if ( (*y) < (*x) )
-            return false;
-        return true;
+        return rPoints[x] < rPoints[y];
     }
+    const MeshPointArray& rPoints;
 };
 
-struct Vertex_Less
+/*
+ * Maps every point to the point with the lowest index that has the same
+ * coordinates.
+ */
+static std::vector<unsigned long> GetDuplicatePointMap(const MeshPointArray& rPoints)
 {
-    bool operator()(const VertexIterator& x,
-                    const VertexIterator& y) const
-    {
-        return (*x) < (*y);
-    }
-};
+    int threads = std::max(1, QThread::idealThreadCount());
+    return parallel_group(rPoints.size(), Vertex_Less(rPoints), threads);
+}
 
 }
 
 bool MeshEvalDuplicatePoints::Evaluate()
 {
-    // get an const iterator to each vertex and sort them in ascending order by
-    // their (x,y,z) coordinates
-    const MeshPointArray& rPoints = _rclMesh.GetPoints();
-    std::vector<VertexIterator> vertices;
-    vertices.reserve(rPoints.size());
-    for (MeshPointArray::_TConstIterator it = rPoints.begin(); it != rPoints.end(); ++it) {
-        vertices.push_back(it);
+    // if there are two vertices which have the same coordinates
+    std::vector<unsigned long> remap = GetDuplicatePointMap(_rclMesh.GetPoints());
+    for (unsigned long i = 0; i < remap.size(); i++) {
+        if (remap[i] != i)
+            return false;
     }
-
-    // if there are two adjacent vertices which have the same coordinates
-    std::sort(vertices.begin(), vertices.end(), Vertex_Less());
-    if (std::adjacent_find(vertices.begin(), vertices.end(), Vertex_EqualTo()) < vertices.end() )
-        return false;
     return true;
 }
 
 std::vector<unsigned long> MeshEvalDuplicatePoints::GetIndices() const
 {
-    //Note: We must neither use map or set to get duplicated indices because
-    //the sort algorithms deliver different results compared to std::sort of
-    //a vector.
-    const MeshPointArray& rPoints = _rclMesh.GetPoints();
-    std::vector<VertexIterator> vertices;
-    vertices.reserve(rPoints.size());
-    for (MeshPointArray::_TConstIterator it = rPoints.begin(); it != rPoints.end(); ++it) {
-        vertices.push_back(it);
-    }
-
-    // if there are two adjacent vertices which have the same coordinates
+    // all points but the first one of each group of equal points
+    std::vector<unsigned long> remap = GetDuplicatePointMap(_rclMesh.GetPoints());
     std::vector<unsigned long> aInds;
-    Vertex_EqualTo pred;
-    std::sort(vertices.begin(), vertices.end(), Vertex_Less());
-
-    std::vector<VertexIterator>::iterator vt = vertices.begin();
-    while (vt < vertices.end()) {
-        // get first item which adjacent element has the same vertex
-        vt = std::adjacent_find(vt, vertices.end(), pred);
-        if (vt < vertices.end()) {
-            ++vt;
-            aInds.push_back(*vt - rPoints.begin());
-        }
+    for (unsigned long i = 0; i < remap.size(); i++) {
+        if (remap[i] != i)
+            aInds.push_back(i);
     }
 
     return aInds;
@@ -176,48 +150,30 @@ std::vector<unsigned long> MeshEvalDuplicatePoints::GetIndices() const
 
 bool MeshFixDuplicatePoints::Fixup()
 {
-    //Note: We must neither use map or set to get duplicated indices because
-    //the sort algorithms deliver different results compared to std::sort of
-    //a vector.
+    // the point with the lowest index of each group of equal points is kept
     const MeshPointArray& rPoints = _rclMesh.GetPoints();
-    std::vector<VertexIterator> vertices;
-    vertices.reserve(rPoints.size());
-    for (MeshPointArray::_TConstIterator it = rPoints.begin(); it != rPoints.end(); ++it) {
-        vertices.push_back(it);
-    }
-
-    // get the indices of adjacent vertices which have the same coordinates
-    std::vector<unsigned long> aInds;
-    std::sort(vertices.begin(), vertices.end(), Vertex_Less());
-
-    Vertex_EqualTo pred;
-    std::vector<VertexIterator>::iterator next = vertices.begin();
-    std::map<unsigned long, unsigned long> mapPointIndex;
+    std::vector<unsigned long> remap = GetDuplicatePointMap(rPoints);
     std::vector<unsigned long> pointIndices;
-    while (next < vertices.end()) {
-        next = std::adjacent_find(next, vertices.end(), pred);
-        if (next < vertices.end()) {
-            std::vector<VertexIterator>::iterator first = next;
-            unsigned long first_index = *first - rPoints.begin();
-            ++next;
-            while (next < vertices.end() && pred(*first, *next)) {
-                unsigned long next_index = *next - rPoints.begin();
-                mapPointIndex[next_index] = first_index;
-                pointIndices.push_back(next_index);
-                ++next;
-            }
-        }
+    for (unsigned long i = 0; i < remap.size(); i++) {
+        if (remap[i] != i)
+            pointIndices.push_back(i);
     }
+    if (pointIndices.empty())
+        return true;
 
     // now set all facets to the correct index
     MeshFacetArray& rFacets = _rclMesh._aclFacetArray;
-    for (MeshFacetArray::_TIterator it = rFacets.begin(); it != rFacets.end(); ++it) {
-        for (int i=0; i<3; i++) {
-            std::map<unsigned long, unsigned long>::iterator pt = mapPointIndex.find(it->_aulPoints[i]);
-            if (pt != mapPointIndex.end())
-                it->_aulPoints[i] = pt->second;
+    unsigned long ctPoints = remap.size();
+    int threads = std::max(1, QThread::idealThreadCount());
+    parallel_for(0, rFacets.size(), [&](unsigned long first, unsigned long last) {
+        for (unsigned long f = first; f < last; f++) {
+            MeshFacet& face = rFacets[f];
+            for (int i=0; i<3; i++) {
+                if (face._aulPoints[i] < ctPoints)
+                    face._aulPoints[i] = remap[face._aulPoints[i]];
+            }
         }
-    }
+    }, threads);
 
     // remove invalid indices
     _rclMesh.DeletePoints(pointIndices);
@@ -228,27 +184,31 @@ bool MeshFixDuplicatePoints::Fixup()
 
 // ----------------------------------------------------------------------
 
-bool MeshEvalNaNPoints::Evaluate()
+namespace {
+struct IsNaNPoint
 {
-    const MeshPointArray& rPoints = _rclMesh.GetPoints();
-    for (MeshPointArray::_TConstIterator it = rPoints.begin(); it != rPoints.end(); ++it) {
-        if (boost::math::isnan(it->x) || boost::math::isnan(it->y) || boost::math::isnan(it->z))
-            return false;
+    IsNaNPoint(const MeshPointArray& rPoints) : rPoints(rPoints) {}
+    bool operator()(unsigned long index) const
+    {
+        const MeshPoint& p = rPoints[index];
+        return boost::math::isnan(p.x) || boost::math::isnan(p.y) || boost::math::isnan(p.z);
     }
+    const MeshPointArray& rPoints;
+};
+}
 
-    return true;
+bool MeshEvalNaNPoints::Evaluate()
+{
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    int threads = std::max(1, QThread::idealThreadCount());
+    return !parallel_any(rPoints.size(), IsNaNPoint(rPoints), threads);
 }
 
 std::vector<unsigned long> MeshEvalNaNPoints::GetIndices() const
 {
-    std::vector<unsigned long> aInds;
     const MeshPointArray& rPoints = _rclMesh.GetPoints();
-    for (MeshPointArray::_TConstIterator it = rPoints.begin(); it != rPoints.end(); ++it) {
-        if (boost::math::isnan(it->x) || boost::math::isnan(it->y) || boost::math::isnan(it->z))
-            aInds.push_back(it - rPoints.begin());
-    }
-
-    return aInds;
+    int threads = std::max(1, QThread::idealThreadCount());
+    return parallel_select(rPoints.size(), IsNaNPoint(rPoints), threads);
 }
 
 bool MeshFixNaNPoints::Fixup()
@@ -313,102 +273,51 @@ struct MeshFacet_Less
 }
 
 /*
- * Two facets are equal if all its three point indices refer to the same
- * location in the point array of the mesh kernel they belong to.
+ * Maps every facet to the facet with the lowest index that references the
+ * same points.
  */
-struct MeshFacet_EqualTo
+static std::vector<unsigned long> GetDuplicateFacetMap(const MeshFacetArray& rFacets)
 {
-    bool operator()(const FaceIterator& x,
-                    const FaceIterator& y) const
-    {
-        for (int i=0; i<3; i++ ) {
-            if (x->_aulPoints[0] == y->_aulPoints[i]) {
-                if (x->_aulPoints[1] == y->_aulPoints[(i+1)%3] && 
-                    x->_aulPoints[2] == y->_aulPoints[(i+2)%3])
-                    return true;
-                else if (x->_aulPoints[1] == y->_aulPoints[(i+2)%3] &&
-                     x->_aulPoints[2] == y->_aulPoints[(i+1)%3])
-                    return true;
-            }
-        }
-
-        return false;
-    }
-};
+    MeshFacet_Less less;
+    MeshFacetArray::_TConstIterator first = rFacets.begin();
+    int threads = std::max(1, QThread::idealThreadCount());
+    return parallel_group(rFacets.size(), [&less, first](unsigned long x, unsigned long y) {
+        return less(first + x, first + y);
+    }, threads);
+}
 
 bool MeshEvalDuplicateFacets::Evaluate()
 {
-  std::set<FaceIterator, MeshFacet_Less> aFaces;
-  const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-  for (MeshFacetArray::_TConstIterator it = rFaces.begin(); it != rFaces.end(); ++it)
-  {
-    std::pair<std::set<FaceIterator, MeshFacet_Less>::iterator, bool>
-        pI = aFaces.insert(it);
-    if (!pI.second)
-        return false;
-  }
+    std::vector<unsigned long> remap = GetDuplicateFacetMap(_rclMesh.GetFacets());
+    for (unsigned long i = 0; i < remap.size(); i++) {
+        if (remap[i] != i)
+            return false;
+    }
 
-  return true;
+    return true;
 }
 
 std::vector<unsigned long> MeshEvalDuplicateFacets::GetIndices() const
 {
-#if 1
-    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    std::vector<FaceIterator> faces;
-    faces.reserve(rFacets.size());
-    for (MeshFacetArray::_TConstIterator it = rFacets.begin(); it != rFacets.end(); ++it) {
-        faces.push_back(it);
-    }
-
-    // if there are two adjacent faces which references the same vertices
+    // all facets but the first one of each group of equal facets
+    std::vector<unsigned long> remap = GetDuplicateFacetMap(_rclMesh.GetFacets());
     std::vector<unsigned long> aInds;
-    MeshFacet_EqualTo pred;
-    std::sort(faces.begin(), faces.end(), MeshFacet_Less());
-
-    std::vector<FaceIterator>::iterator ft = faces.begin();
-    while (ft < faces.end()) {
-        // get first item which adjacent element has the same face
-        ft = std::adjacent_find(ft, faces.end(), pred);
-        if (ft < faces.end()) {
-            ++ft;
-            aInds.push_back(*ft - rFacets.begin());
-        }
+    for (unsigned long i = 0; i < remap.size(); i++) {
+        if (remap[i] != i)
+            aInds.push_back(i);
     }
 
     return aInds;
-#else
-  std::vector<unsigned long> aInds;
-  const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-  unsigned long uIndex=0;
-
-  // get all facets
-  std::set<FaceIterator, MeshFacet_Less > aFaceSet;
-  for (MeshFacetArray::_TConstIterator it = rFaces.begin(); it != rFaces.end(); ++it, uIndex++)
-  {
-    std::pair<std::set<FaceIterator, MeshFacet_Less>::iterator, bool>
-        pI = aFaceSet.insert(it);
-    if (!pI.second)
-      aInds.push_back(uIndex);
-  }
-
-  return aInds;
-#endif
 }
 
 bool MeshFixDuplicateFacets::Fixup()
 {
-    unsigned long uIndex=0;
+    // the first facet of each group of equal facets is kept
     std::vector<unsigned long> aRemoveFaces;
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-
-    // get all facets
-    std::set<FaceIterator, MeshFacet_Less > aFaceSet;
-    for (MeshFacetArray::_TConstIterator it = rFaces.begin(); it != rFaces.end(); ++it, uIndex++) {
-        std::pair<std::set<FaceIterator, MeshFacet_Less>::iterator, bool>
-        pI = aFaceSet.insert(it);
-        if (!pI.second)
-            aRemoveFaces.push_back(uIndex);
+    std::vector<unsigned long> remap = GetDuplicateFacetMap(_rclMesh.GetFacets());
+    for (unsigned long i = 0; i < remap.size(); i++) {
+        if (remap[i] != i)
+            aRemoveFaces.push_back(i);
     }
 
     _rclMesh.DeleteFacets(aRemoveFaces);
@@ -445,13 +354,11 @@ bool MeshEvalInternalFacets::Evaluate()
 
 bool MeshEvalDegeneratedFacets::Evaluate()
 {
-    MeshFacetIterator it(_rclMesh);
-    for (it.Init(); it.More(); it.Next()) {
-        if (it->IsDegenerated(fEpsilon))
-            return false;
-    }
-
-    return true;
+    int threads = std::max(1, QThread::idealThreadCount());
+    float fEps = fEpsilon;
+    return !parallel_any(_rclMesh.CountFacets(), [this, fEps](unsigned long index) {
+        return _rclMesh.GetFacet(index).IsDegenerated(fEps);
+    }, threads);
 }
 
 unsigned long MeshEvalDegeneratedFacets::CountEdgeTooSmall (float fMinEdgeLength) const
@@ -472,14 +379,11 @@ unsigned long MeshEvalDegeneratedFacets::CountEdgeTooSmall (float fMinEdgeLength
 
 std::vector<unsigned long> MeshEvalDegeneratedFacets::GetIndices() const
 {
-    std::vector<unsigned long> aInds;
-    MeshFacetIterator it(_rclMesh);
-    for (it.Init(); it.More(); it.Next()) {
-        if (it->IsDegenerated(fEpsilon))
-            aInds.push_back(it.Position());
-    }
-
-    return aInds;
+    int threads = std::max(1, QThread::idealThreadCount());
+    float fEps = fEpsilon;
+    return parallel_select(_rclMesh.CountFacets(), [this, fEps](unsigned long index) {
+        return _rclMesh.GetFacet(index).IsDegenerated(fEps);
+    }, threads);
 }
 
 bool MeshFixDegeneratedFacets::Fixup()
@@ -770,13 +674,10 @@ bool MeshEvalDeformedFacets::Evaluate()
     float fCosMinAngle = cos(fMinAngle);
     float fCosMaxAngle = cos(fMaxAngle);
 
-    MeshFacetIterator it(_rclMesh);
-    for (it.Init(); it.More(); it.Next()) {
-        if (it->IsDeformed(fCosMinAngle, fCosMaxAngle))
-            return false;
-    }
-
-    return true;
+    int threads = std::max(1, QThread::idealThreadCount());
+    return !parallel_any(_rclMesh.CountFacets(), [&](unsigned long index) {
+        return _rclMesh.GetFacet(index).IsDeformed(fCosMinAngle, fCosMaxAngle);
+    }, threads);
 }
 
 std::vector<unsigned long> MeshEvalDeformedFacets::GetIndices() const
@@ -784,14 +685,10 @@ std::vector<unsigned long> MeshEvalDeformedFacets::GetIndices() const
     float fCosMinAngle = cos(fMinAngle);
     float fCosMaxAngle = cos(fMaxAngle);
 
-    std::vector<unsigned long> aInds;
-    MeshFacetIterator it(_rclMesh);
-    for (it.Init(); it.More(); it.Next()) {
-        if (it->IsDeformed(fCosMinAngle, fCosMaxAngle))
-            aInds.push_back(it.Position());
-    }
-
-    return aInds;
+    int threads = std::max(1, QThread::idealThreadCount());
+    return parallel_select(_rclMesh.CountFacets(), [&](unsigned long index) {
+        return _rclMesh.GetFacet(index).IsDeformed(fCosMinAngle, fCosMaxAngle);
+    }, threads);
 }
 
 bool MeshFixDeformedFacets::Fixup()
@@ -867,8 +764,8 @@ bool MeshFixDeformedFacets::Fixup()
 
 bool MeshFixMergeFacets::Fixup()
 {
-    MeshCore::MeshRefPointToPoints vv_it(_rclMesh);
-    MeshCore::MeshRefPointToFacets vf_it(_rclMesh);
+    MeshCore::MeshCompactPointToFacets vf_it(_rclMesh);
+    MeshCore::MeshCompactPointToPoints vv_it(_rclMesh, vf_it);
     unsigned long countPoints = _rclMesh.CountPoints();
 
     std::vector<MeshFacet> newFacets;
@@ -876,13 +773,11 @@ bool MeshFixMergeFacets::Fixup()
 
     MeshTopoAlgorithm topAlg(_rclMesh);
     for (unsigned long i=0; i<countPoints; i++) {
-        if (vv_it[i].size() == 3 && vf_it[i].size() == 3) {
+        if (vv_it.Count(i) == 3 && vf_it.Count(i) == 3) {
             VertexCollapse vc;
             vc._point = i;
-            const std::set<unsigned long>& adjPts = vv_it[i];
-            vc._circumPoints.insert(vc._circumPoints.begin(), adjPts.begin(), adjPts.end());
-            const std::set<unsigned long>& adjFts = vf_it[i];
-            vc._circumFacets.insert(vc._circumFacets.begin(), adjFts.begin(), adjFts.end());
+            vc._circumPoints.insert(vc._circumPoints.begin(), vv_it.Begin(i), vv_it.End(i));
+            vc._circumFacets.insert(vc._circumFacets.begin(), vf_it.Begin(i), vf_it.End(i));
             topAlg.CollapseVertex(vc);
         }
     }
@@ -1051,13 +946,13 @@ bool MeshFixFoldsOnBoundary::Fixup()
 
 bool MeshEvalFoldOversOnSurface::Evaluate()
 {
-    this->indices.clear();
     const MeshCore::MeshFacetArray& facets = _rclMesh.GetFacets();
-    MeshCore::MeshFacetArray::_TConstIterator f_it,
-        f_beg = facets.begin(), f_end = facets.end();
+    MeshCore::MeshFacetArray::_TConstIterator f_beg = facets.begin();
 
-    Base::Vector3f n1, n2;
-    for (f_it = facets.begin(); f_it != f_end; ++f_it) {
+    int threads = std::max(1, QThread::idealThreadCount());
+    this->indices = parallel_select(facets.size(), [&](unsigned long index) {
+        MeshCore::MeshFacetArray::_TConstIterator f_it = f_beg + index;
+        Base::Vector3f n1, n2;
         for (int i=0; i<3; i++) {
             unsigned long index1 = f_it->_aulNeighbours[i];
             unsigned long index2 = f_it->_aulNeighbours[(i+1)%3];
@@ -1069,13 +964,13 @@ bool MeshEvalFoldOversOnSurface::Evaluate()
                     n1 = _rclMesh.GetFacet(index1).GetNormal();
                     n2 = _rclMesh.GetFacet(index2).GetNormal();
                     if (n1 * n2 < -0.5f) { // angle > 120 deg
-                        this->indices.push_back(f_it-f_beg);
-                        break;
+                        return true;
                     }
                 }
             }
         }
-    }
+        return false;
+    }, threads);
 
     return this->indices.empty();
 }
@@ -1087,14 +982,14 @@ bool MeshEvalBorderFacet::Evaluate()
     const MeshCore::MeshFacetArray& facets = _rclMesh.GetFacets();
     MeshCore::MeshFacetArray::_TConstIterator f_it,
         f_beg = facets.begin(), f_end = facets.end();
-    MeshCore::MeshRefPointToPoints vv_it(_rclMesh);
-    MeshCore::MeshRefPointToFacets vf_it(_rclMesh);
+    MeshCore::MeshCompactPointToFacets vf_it(_rclMesh);
+    MeshCore::MeshCompactPointToPoints vv_it(_rclMesh, vf_it);
 
     for (f_it = facets.begin(); f_it != f_end; ++f_it) {
         bool ok = true;
         for (int i=0; i<3; i++) {
             unsigned long index = f_it->_aulPoints[i];
-            if (vv_it[index].size() == vf_it[index].size()) {
+            if (vv_it.Count(index) == vf_it.Count(index)) {
                 ok = false;
                 break;
             }
@@ -1109,39 +1004,37 @@ bool MeshEvalBorderFacet::Evaluate()
 
 // ----------------------------------------------------------------------
 
-bool MeshEvalRangeFacet::Evaluate()
+namespace {
+struct IsNeighbourOutOfRange
 {
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    unsigned long ulCtFacets = rFaces.size();
-
-    for (MeshFacetArray::_TConstIterator it = rFaces.begin(); it != rFaces.end(); ++it) {
+    IsNeighbourOutOfRange(const MeshFacetArray& rFaces) : rFaces(rFaces) {}
+    bool operator()(unsigned long index) const
+    {
+        unsigned long ulCtFacets = rFaces.size();
+        const MeshFacet& face = rFaces[index];
         for (int i = 0; i < 3; i++) {
-            if ((it->_aulNeighbours[i] >= ulCtFacets) && (it->_aulNeighbours[i] < ULONG_MAX)) {
-                return false;
+            if ((face._aulNeighbours[i] >= ulCtFacets) && (face._aulNeighbours[i] < ULONG_MAX)) {
+                return true;
             }
         }
+        return false;
     }
+    const MeshFacetArray& rFaces;
+};
+}
 
-    return true;
+bool MeshEvalRangeFacet::Evaluate()
+{
+    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
+    int threads = std::max(1, QThread::idealThreadCount());
+    return !parallel_any(rFaces.size(), IsNeighbourOutOfRange(rFaces), threads);
 }
 
 std::vector<unsigned long> MeshEvalRangeFacet::GetIndices() const
 {
-    std::vector<unsigned long> aInds;
     const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    unsigned long ulCtFacets = rFaces.size();
-
-    unsigned long ind=0;
-    for (MeshFacetArray::_TConstIterator it = rFaces.begin(); it != rFaces.end(); ++it, ind++) {
-        for (int i = 0; i < 3; i++) {
-            if ((it->_aulNeighbours[i] >= ulCtFacets) && (it->_aulNeighbours[i] < ULONG_MAX)) {
-                aInds.push_back(ind);
-                break;
-            }
-        }
-    }
-
-    return aInds;
+    int threads = std::max(1, QThread::idealThreadCount());
+    return parallel_select(rFaces.size(), IsNeighbourOutOfRange(rFaces), threads);
 }
 
 bool MeshFixRangeFacet::Fixup()
@@ -1157,27 +1050,23 @@ bool MeshEvalRangePoint::Evaluate()
     const MeshFacetArray& rFaces = _rclMesh.GetFacets();
     unsigned long ulCtPoints = _rclMesh.CountPoints();
 
-    for (MeshFacetArray::_TConstIterator it = rFaces.begin(); it != rFaces.end(); ++it) {
-        if (std::find_if(it->_aulPoints, it->_aulPoints + 3, [ulCtPoints](unsigned long i) { return i >= ulCtPoints; }) < it->_aulPoints + 3)
-            return false;
-    }
-
-    return true;
+    int threads = std::max(1, QThread::idealThreadCount());
+    return !parallel_any(rFaces.size(), [&rFaces, ulCtPoints](unsigned long index) {
+        const MeshFacet& face = rFaces[index];
+        return std::find_if(face._aulPoints, face._aulPoints + 3, [ulCtPoints](unsigned long i) { return i >= ulCtPoints; }) < face._aulPoints + 3;
+    }, threads);
 }
 
 std::vector<unsigned long> MeshEvalRangePoint::GetIndices() const
 {
-    std::vector<unsigned long> aInds;
     const MeshFacetArray& rFaces = _rclMesh.GetFacets();
     unsigned long ulCtPoints = _rclMesh.CountPoints();
 
-    unsigned long ind=0;
-    for (MeshFacetArray::_TConstIterator it = rFaces.begin(); it != rFaces.end(); ++it, ind++) {
-        if (std::find_if(it->_aulPoints, it->_aulPoints + 3, [ulCtPoints](unsigned long i) { return i >= ulCtPoints; }) < it->_aulPoints + 3)
-            aInds.push_back(ind);
-    }
-
-    return aInds;
+    int threads = std::max(1, QThread::idealThreadCount());
+    return parallel_select(rFaces.size(), [&rFaces, ulCtPoints](unsigned long index) {
+        const MeshFacet& face = rFaces[index];
+        return std::find_if(face._aulPoints, face._aulPoints + 3, [ulCtPoints](unsigned long i) { return i >= ulCtPoints; }) < face._aulPoints + 3;
+    }, threads);
 }
 
 bool MeshFixRangePoint::Fixup()
@@ -1208,35 +1097,34 @@ bool MeshFixRangePoint::Fixup()
 
 // ----------------------------------------------------------------------
 
-bool MeshEvalCorruptedFacets::Evaluate()
+namespace {
+struct IsCorruptedFacet
 {
-  const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-
-  for ( MeshFacetArray::_TConstIterator it = rFaces.begin(); it != rFaces.end(); ++it ) {
+  IsCorruptedFacet(const MeshFacetArray& rFaces) : rFaces(rFaces) {}
+  bool operator()(unsigned long index) const
+  {
     // dupicated point indices
-    if ((it->_aulPoints[0] == it->_aulPoints[1]) || 
-        (it->_aulPoints[1] == it->_aulPoints[2]) || 
-        (it->_aulPoints[2] == it->_aulPoints[0]))
-      return false;
+    const MeshFacet& face = rFaces[index];
+    return ((face._aulPoints[0] == face._aulPoints[1]) ||
+            (face._aulPoints[1] == face._aulPoints[2]) ||
+            (face._aulPoints[2] == face._aulPoints[0]));
   }
+  const MeshFacetArray& rFaces;
+};
+}
 
-  return true;
+bool MeshEvalCorruptedFacets::Evaluate()
+{
+  const MeshFacetArray& rFaces = _rclMesh.GetFacets();
+  int threads = std::max(1, QThread::idealThreadCount());
+  return !parallel_any(rFaces.size(), IsCorruptedFacet(rFaces), threads);
 }
 
 std::vector<unsigned long> MeshEvalCorruptedFacets::GetIndices() const
 {
-  std::vector<unsigned long> aInds;
   const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-  unsigned long ind=0;
-
-  for ( MeshFacetArray::_TConstIterator it = rFaces.begin(); it != rFaces.end(); ++it, ind++ ) {
-    if ((it->_aulPoints[0] == it->_aulPoints[1]) || 
-        (it->_aulPoints[1] == it->_aulPoints[2]) || 
-        (it->_aulPoints[2] == it->_aulPoints[0]))
-      aInds.push_back(ind);
-  }
-
-  return aInds;
+  int threads = std::max(1, QThread::idealThreadCount());
+  return parallel_select(rFaces.size(), IsCorruptedFacet(rFaces), threads);
 }
 
 bool MeshFixCorruptedFacets::Fixup()
@@ -25,9 +25,13 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <atomic>
 # include <vector>
 #endif
 
+#include <QFuture>
+#include <QtConcurrentMap>
+
 #include <Mod/Mesh/App/WildMagic4/Wm4Matrix3.h>
 #include <Mod/Mesh/App/WildMagic4/Wm4Vector3.h>
 
@@ -470,25 +474,22 @@ bool MeshEvalPointManifolds::Evaluate ()
     this->nonManifoldPoints.clear();
     this->facetsOfNonManifoldPoints.clear();
 
-    MeshCore::MeshRefPointToPoints vv_it(_rclMesh);
-    MeshCore::MeshRefPointToFacets vf_it(_rclMesh);
+    MeshCore::MeshCompactPointToFacets vf_it(_rclMesh);
+    MeshCore::MeshCompactPointToPoints vv_it(_rclMesh, vf_it);
 
     unsigned long ctPoints = _rclMesh.CountPoints();
     for (unsigned long index=0; index < ctPoints; index++) {
         // get the local neighbourhood of the point
-        const std::set<unsigned long>& nf = vf_it[index];
-        const std::set<unsigned long>& np = vv_it[index];
-
-        std::set<unsigned long>::size_type sp, sf;
-        sp = np.size();
-        sf = nf.size();
+        unsigned long sp, sf;
+        sp = vv_it.Count(index);
+        sf = vf_it.Count(index);
         // for an inner point the number of adjacent points is equal to the number of shared faces
         // for a boundary point the number of adjacent points is higher by one than the number of shared faces
         // for a non-manifold point the number of adjacent points is higher by more than one than the number of shared faces
         if (sp > sf + 1) {
             nonManifoldPoints.push_back(index);
             std::vector<unsigned long> faces;
-            faces.insert(faces.end(), nf.begin(), nf.end());
+            faces.insert(faces.end(), vf_it.Begin(index), vf_it.End(index));
             this->facetsOfNonManifoldPoints.push_back(faces);
         }
     }
@@ -593,170 +594,220 @@ bool MeshFixSingleFacet::Fixup ()
 
 // ----------------------------------------------------------------
 
-bool MeshEvalSelfIntersection::Evaluate ()
-{
-    // Contains bounding boxes for every facet 
-    std::vector<Base::BoundBox3f> boxes;
+namespace MeshCore {
+namespace {
 
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX, ulGridY, ulGridZ;
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
+typedef std::pair<unsigned long, unsigned long> FacetPair;
 
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
+inline bool ShareVertex(const MeshFacet& rface1, const MeshFacet& rface2)
+{
+    for (int i = 0; i < 3; i++) {
+        if (rface1._aulPoints[i] == rface2._aulPoints[0] ||
+            rface1._aulPoints[i] == rface2._aulPoints[1] ||
+            rface1._aulPoints[i] == rface2._aulPoints[2])
+            return true;
+    }
+    return false;
+}
+
+/*
+ * Finds the pairs of intersecting facets. The broad phase sorts the facets
+ * by the lower bound of their bounding boxes along the longest axis of the
+ * mesh, so that the candidates of a facet are the following facets whose
+ * lower bound does not exceed its upper bound (sweep and prune). The sweep
+ * is split into chunks that are handled concurrently, and the narrow phase
+ * tests the candidate pairs with MeshGeomFacet::IntersectWithFacet.
+ */
+class SelfIntersectionFinder
+{
+public:
+    SelfIntersectionFinder(const MeshKernel& mesh, bool firstOnly)
+      : mesh(mesh), firstOnly(firstOnly), found(false), axis(0)
+    {
+        unsigned long count = mesh.CountFacets();
+        int threads = std::max(1, QThread::idealThreadCount());
+
+        // Contains bounding boxes for every facet
+        boxes.resize(count);
+        parallel_for(0, count, [this](unsigned long first, unsigned long last) {
+            for (unsigned long i = first; i < last; i++)
+                boxes[i] = this->mesh.GetFacet(i).GetBoundBox();
+        }, threads);
+
+        const Base::BoundBox3f& bbox = mesh.GetBoundBox();
+        if (bbox.LengthY() > bbox.LengthX())
+            axis = 1;
+        if (bbox.LengthZ() > std::max(bbox.LengthX(), bbox.LengthY()))
+            axis = 2;
+
+        order.resize(count);
+        for (unsigned long i = 0; i < count; i++)
+            order[i] = i;
+        parallel_sort(order.begin(), order.end(), [this](unsigned long a, unsigned long b) {
+            float fa = Lower(boxes[a]);
+            float fb = Lower(boxes[b]);
+            return fa < fb || (fa == fb && a < b);
+        }, threads);
+
+        lower.resize(count);
+        for (unsigned long i = 0; i < count; i++)
+            lower[i] = Lower(boxes[order[i]]);
     }
 
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX*ulGridY*ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        //Get the facet indices, belonging to the current grid unit
-        std::vector<unsigned long> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
+    /// Collects the intersecting pairs, each one with the lower index first and sorted
+    void Find(std::vector<FacetPair>& pairs, bool canAbort)
+    {
+        // use many more chunks than threads because their costs vary a lot
+        unsigned long count = order.size();
+        unsigned long numChunks = std::max<unsigned long>(1, std::min<unsigned long>(count / 512, 1024));
+        std::vector<FacetPair> chunks;
+        for (unsigned long i = 0; i < numChunks; i++)
+            chunks.emplace_back(count * i / numChunks, count * (i + 1) / numChunks);
+
+        std::size_t offset = pairs.size();
+        QFuture< std::vector<FacetPair> > future = QtConcurrent::mapped(chunks, Sweep(this));
+        Base::SequencerLauncher seq("Checking for self-intersections...", numChunks);
+        try {
+            for (unsigned long i = 0; i < numChunks; i++) {
+                // waits for the chunk to be finished
+                const std::vector<FacetPair>& result = future.resultAt(i);
+                pairs.insert(pairs.end(), result.begin(), result.end());
+                seq.next(canAbort);
+                if (firstOnly && found)
+                    break;
+            }
+        }
+        catch (...) {
+            future.cancel();
+            future.waitForFinished();
+            throw;
+        }
+        future.cancel();
+        future.waitForFinished();
 
-        seq.next();
-        if (aulGridElements.size()==0)
-            continue;
+        if (firstOnly && found)
+            pairs.push_back(firstPair);
+        std::sort(pairs.begin() + offset, pairs.end());
+    }
+
+private:
+    float Lower(const Base::BoundBox3f& box) const
+    {
+        return axis == 0 ? box.MinX : (axis == 1 ? box.MinY : box.MinZ);
+    }
+    float Upper(const Base::BoundBox3f& box) const
+    {
+        return axis == 0 ? box.MaxX : (axis == 1 ? box.MaxY : box.MaxZ);
+    }
 
-        MeshGeomFacet facet1, facet2;
+    /// Tests the facets order[first], ..., order[last-1] against their candidates
+    std::vector<FacetPair> Intersect(unsigned long first, unsigned long last) const
+    {
+        std::vector<FacetPair> pairs;
+        const MeshFacetArray& rFaces = mesh.GetFacets();
+        unsigned long count = order.size();
         Base::Vector3f pt1, pt2;
-        for (std::vector<unsigned long>::iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (std::vector<unsigned long>::iterator jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) // the identical facet
-                    continue;
-                // If the facets share a common vertex we do not check for self-intersections because they 
+        for (unsigned long k = first; k < last; k++) {
+            if (firstOnly && found)
+                break;
+            unsigned long index1 = order[k];
+            const MeshFacet& rface1 = rFaces[index1];
+            const Base::BoundBox3f& box1 = boxes[index1];
+            float upper = Upper(box1);
+            bool hasFacet1 = false;
+            MeshGeomFacet facet1;
+            for (unsigned long m = k + 1; m < count && lower[m] <= upper; m++) {
+                unsigned long index2 = order[m];
+                // If the facets share a common vertex we do not check for self-intersections because they
                 // could but usually do not intersect each other and the algorithm below would detect false-positives,
                 // otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[0] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[0] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[1] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[1] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[1] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[2] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[2] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[2] == rface2._aulPoints[2])
+                const MeshFacet& rface2 = rFaces[index2];
+                if (ShareVertex(rface1, rface2))
                     continue; // ignore facets sharing a common vertex
 
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
+                if (box1 && boxes[index2]) {
+                    if (!hasFacet1) {
+                        facet1 = mesh.GetFacet(rface1);
+                        hasFacet1 = true;
+                    }
+                    MeshGeomFacet facet2 = mesh.GetFacet(rface2);
                     int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
                     if (ret == 2) {
-                        // abort after the first detected self-intersection
-                        return false;
+                        FacetPair pair(std::min(index1, index2), std::max(index1, index2));
+                        if (firstOnly) {
+                            // only the thread that finds the first pair keeps it
+                            bool expected = false;
+                            if (found.compare_exchange_strong(expected, true))
+                                firstPair = pair;
+                            return pairs;
+                        }
+                        pairs.push_back(pair);
                     }
                 }
             }
         }
+
+        return pairs;
     }
 
-    return true;
+    struct Sweep
+    {
+        typedef std::vector<FacetPair> result_type;
+        Sweep(const SelfIntersectionFinder* finder) : finder(finder) {}
+        result_type operator()(const FacetPair& chunk) const
+        {
+            return finder->Intersect(chunk.first, chunk.second);
+        }
+        const SelfIntersectionFinder* finder;
+    };
+
+    const MeshKernel& mesh;
+    bool firstOnly;
+    mutable std::atomic<bool> found;
+    mutable FacetPair firstPair;
+    int axis;
+    std::vector<Base::BoundBox3f> boxes;
+    std::vector<unsigned long> order;
+    std::vector<float> lower;
+};
+
+}
+}
+
+bool MeshEvalSelfIntersection::Evaluate ()
+{
+    // abort after the first detected self-intersection
+    SelfIntersectionFinder finder(_rclMesh, true);
+    std::vector<FacetPair> pairs;
+    finder.Find(pairs, false);
+    return pairs.empty();
 }
 
 void MeshEvalSelfIntersection::GetIntersections(const std::vector<std::pair<unsigned long, unsigned long> >& indices,
                                                 std::vector<std::pair<Base::Vector3f, Base::Vector3f> >& intersection) const
 {
-    intersection.reserve(indices.size());
-    MeshFacetIterator cMF1(_rclMesh);
-    MeshFacetIterator cMF2(_rclMesh);
-
-    Base::Vector3f pt1, pt2;
-    std::vector<std::pair<unsigned long, unsigned long> >::const_iterator it;
-    for (it = indices.begin(); it != indices.end(); ++it) {
-        cMF1.Set(it->first);
-        cMF2.Set(it->second);
-
-        Base::BoundBox3f box1 = cMF1->GetBoundBox();
-        Base::BoundBox3f box2 = cMF2->GetBoundBox();
-        if (box1 && box2) {
-            int ret = cMF1->IntersectWithFacet(*cMF2, pt1, pt2);
-            if (ret == 2) {
-                intersection.emplace_back(pt1, pt2);
-            }
+    // the lines are computed concurrently and collected in the order of the indices
+    std::vector<std::pair<Base::Vector3f, Base::Vector3f> > lines(indices.size());
+    int threads = std::max(1, QThread::idealThreadCount());
+    std::vector<unsigned long> found = parallel_select(indices.size(), [&](unsigned long i) {
+        MeshGeomFacet facet1 = _rclMesh.GetFacet(indices[i].first);
+        MeshGeomFacet facet2 = _rclMesh.GetFacet(indices[i].second);
+        if (facet1.GetBoundBox() && facet2.GetBoundBox()) {
+            int ret = facet1.IntersectWithFacet(facet2, lines[i].first, lines[i].second);
+            return ret == 2;
         }
-    }
+        return false;
+    }, threads);
+
+    intersection.reserve(intersection.size() + found.size());
+    for (std::vector<unsigned long>::iterator it = found.begin(); it != found.end(); ++it)
+        intersection.push_back(lines[*it]);
 }
 
 void MeshEvalSelfIntersection::GetIntersections(std::vector<std::pair<unsigned long, unsigned long> >& intersection) const
 {
-    // Contains bounding boxes for every facet 
-    std::vector<Base::BoundBox3f> boxes;
-    //intersection.clear();
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX, ulGridY, ulGridZ;
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for(cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX*ulGridY*ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        //Get the facet indices, belonging to the current grid unit
-        std::vector<unsigned long> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next(true);
-        if (aulGridElements.size()==0)
-            continue;
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (std::vector<unsigned long>::iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (std::vector<unsigned long>::iterator jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) // the identical facet
-                    continue;
-                // If the facets share a common vertex we do not check for self-intersections because they 
-                // could but usually do not intersect each other and the algorithm below would detect false-positives,
-                // otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[0] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[0] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[1] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[1] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[1] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[2] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[2] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[2] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        intersection.emplace_back (*it,*jt);
-                    }
-                }
-            }
-        }
-    }
+    SelfIntersectionFinder finder(_rclMesh, false);
+    finder.Find(intersection, true);
 }
 
 std::vector<unsigned long> MeshFixSelfIntersection::GetFacets() const
@@ -952,75 +1003,69 @@ bool MeshFixNeighbourhood::Fixup()
 
 void MeshKernel::RebuildNeighbours (unsigned long index)
 {
-    std::vector<Edge_Index> edges;
-    edges.reserve(3 * (this->_aclFacetArray.size() - index));
+    int threads = std::max(1, QThread::idealThreadCount());
+    MeshFacetArray& rFacets = this->_aclFacetArray;
+    unsigned long ctFacets = rFacets.size();
+    if (index >= ctFacets)
+        return;
 
     // build up an array of edges
-    MeshFacetArray::_TConstIterator pI;
-    MeshFacetArray::_TConstIterator pB = this->_aclFacetArray.begin();
-    for (pI = pB + index; pI != this->_aclFacetArray.end(); ++pI) {
-        for (int i = 0; i < 3; i++) {
-            Edge_Index item;
-            item.p0 = std::min<unsigned long>(pI->_aulPoints[i], pI->_aulPoints[(i+1)%3]);
-            item.p1 = std::max<unsigned long>(pI->_aulPoints[i], pI->_aulPoints[(i+1)%3]);
-            item.f  = pI - pB;
-            edges.push_back(item);
+    std::vector<Edge_Index> edges(3 * (ctFacets - index));
+    parallel_for(index, ctFacets, [&](unsigned long first, unsigned long last) {
+        for (unsigned long f = first; f < last; f++) {
+            const MeshFacet& rFace = rFacets[f];
+            Edge_Index* item = &edges[3 * (f - index)];
+            for (int i = 0; i < 3; i++, item++) {
+                item->p0 = std::min<unsigned long>(rFace._aulPoints[i], rFace._aulPoints[(i+1)%3]);
+                item->p1 = std::max<unsigned long>(rFace._aulPoints[i], rFace._aulPoints[(i+1)%3]);
+                item->f  = f;
+            }
         }
-    }
+    }, threads);
 
     // sort the edges
     //std::sort(edges.begin(), edges.end(), Edge_Less());
-    int threads = std::max(1, QThread::idealThreadCount());
     MeshCore::parallel_sort(edges.begin(), edges.end(), Edge_Less(), threads);
 
-    unsigned long p0 = ULONG_MAX, p1 = ULONG_MAX;
-    unsigned long f0 = ULONG_MAX, f1 = ULONG_MAX;
-    int count = 0;
-    std::vector<Edge_Index>::iterator pE;
-    for (pE = edges.begin(); pE != edges.end(); ++pE) {
-        if (p0 == pE->p0 && p1 == pE->p1) {
-            f1 = pE->f;
-            count++;
-        }
-        else {
+    // Equal edges are now adjacent. Every block of the array starts at the
+    // first edge group beginning inside it and handles its groups to the end,
+    // even past the block. As each facet side belongs to exactly one edge the
+    // blocks never write to the same neighbour index.
+    unsigned long ctEdges = edges.size();
+    parallel_for(0, ctEdges, [&](unsigned long first, unsigned long last) {
+        unsigned long pos = first;
+        while (pos > 0 && pos < ctEdges &&
+               edges[pos].p0 == edges[pos-1].p0 && edges[pos].p1 == edges[pos-1].p1)
+            ++pos;
+
+        while (pos < last) {
+            unsigned long p0 = edges[pos].p0;
+            unsigned long p1 = edges[pos].p1;
+            unsigned long f0 = edges[pos].f;
+            unsigned long f1 = ULONG_MAX;
+            int count = 1;
+            for (++pos; pos < ctEdges && edges[pos].p0 == p0 && edges[pos].p1 == p1; ++pos) {
+                f1 = edges[pos].f;
+                count++;
+            }
+
             // we handle only the cases for 1 and 2, for all higher
             // values we have a non-manifold that is ignored here
             if (count == 2) {
-                MeshFacet& rFace0 = this->_aclFacetArray[f0];
-                MeshFacet& rFace1 = this->_aclFacetArray[f1];
+                MeshFacet& rFace0 = rFacets[f0];
+                MeshFacet& rFace1 = rFacets[f1];
                 unsigned short side0 = rFace0.Side(p0,p1);
                 unsigned short side1 = rFace1.Side(p0,p1);
                 rFace0._aulNeighbours[side0] = f1;
                 rFace1._aulNeighbours[side1] = f0;
             }
             else if (count == 1) {
-                MeshFacet& rFace = this->_aclFacetArray[f0];
+                MeshFacet& rFace = rFacets[f0];
                 unsigned short side = rFace.Side(p0,p1);
                 rFace._aulNeighbours[side] = ULONG_MAX;
             }
-
-            p0 = pE->p0;
-            p1 = pE->p1;
-            f0 = pE->f;
-            count = 1;
         }
-    }
-
-    // we handle only the cases for 1 and 2, for all higher
-    // values we have a non-manifold that is ignored here
-    if (count == 2) {
-        MeshFacet& rFace0 = this->_aclFacetArray[f0];
-        MeshFacet& rFace1 = this->_aclFacetArray[f1];
-        unsigned short side0 = rFace0.Side(p0,p1);
-        unsigned short side1 = rFace1.Side(p0,p1);
-        rFace0._aulNeighbours[side0] = f1;
-        rFace1._aulNeighbours[side1] = f0;
-    }
-    else if (count == 1) {
-        MeshFacet& rFace = this->_aclFacetArray[f0];
-        unsigned short side = rFace.Side(p0,p1);
-        rFace._aulNeighbours[side] = ULONG_MAX;
-    }
+    }, threads, 4096);
 }
 
 void MeshKernel::RebuildNeighbours (void)
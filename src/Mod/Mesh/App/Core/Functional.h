@@ -25,6 +25,8 @@
 #define MESH_FUNCTIONAL_H
 
 #include <algorithm>
+#include <atomic>
+#include <vector>
 #include <QtConcurrentRun>
 #include <QFuture>
 #include <QThread>
@@ -58,6 +60,107 @@ namespace MeshCore
         }
     }
 
+    /**
+     * Splits the index range [begin,end) into blocks of at least \a grain
+     * indices, one block per thread at most, and calls func(first, last) for
+     * each block concurrently. The calls must not modify shared data.
+     */
+    template <class Func>
+    static void parallel_for(unsigned long begin, unsigned long end, Func func, int threads,
+                             unsigned long grain = 1024)
+    {
+        unsigned long count = end > begin ? end - begin : 0;
+        unsigned long blocks = std::min<unsigned long>(std::max(threads, 1), count / std::max(grain, 1UL));
+        if (blocks < 2)
+        {
+            func(begin, end);
+            return;
+        }
+
+        std::vector< QFuture<void> > futures;
+        for (unsigned long i = 1; i < blocks; i++)
+        {
+            unsigned long first = begin + count * i / blocks;
+            unsigned long last = begin + count * (i + 1) / blocks;
+            futures.push_back(QtConcurrent::run([&func, first, last]() { func(first, last); }));
+        }
+        func(begin, begin + count / blocks);
+        for (auto& future : futures)
+            future.waitForFinished();
+    }
+
+    /**
+     * Checks concurrently whether \a pred holds for any index in [0,count).
+     * The search stops as soon as one index is found.
+     */
+    template <class Pred>
+    static bool parallel_any(unsigned long count, Pred pred, int threads)
+    {
+        std::atomic<bool> found(false);
+        parallel_for(0, count, [&pred, &found](unsigned long first, unsigned long last) {
+            for (unsigned long i = first; i < last && !found.load(std::memory_order_relaxed); i++)
+            {
+                if (pred(i))
+                    found = true;
+            }
+        }, threads);
+        return found;
+    }
+
+    /**
+     * Returns the indices in [0,count) for which \a pred holds, in ascending
+     * order. The predicate is evaluated concurrently.
+     */
+    template <class Pred>
+    static std::vector<unsigned long> parallel_select(unsigned long count, Pred pred, int threads)
+    {
+        std::vector<char> flags(count, 0);
+        parallel_for(0, count, [&pred, &flags](unsigned long first, unsigned long last) {
+            for (unsigned long i = first; i < last; i++)
+                flags[i] = pred(i) ? 1 : 0;
+        }, threads);
+
+        std::vector<unsigned long> indices;
+        for (unsigned long i = 0; i < count; i++)
+        {
+            if (flags[i])
+                indices.push_back(i);
+        }
+        return indices;
+    }
+
+    /**
+     * Groups the indices [0,count) that are equal with respect to \a less and
+     * returns a dense vector holding for every index the first index of its
+     * group. The indices are sorted concurrently and ties are broken by the
+     * index, so the first index of a group is its lowest one and the result
+     * does not depend on the sort algorithm.
+     */
+    template <class Less>
+    static std::vector<unsigned long> parallel_group(unsigned long count, Less less, int threads)
+    {
+        std::vector<unsigned long> order(count);
+        for (unsigned long i = 0; i < count; i++)
+            order[i] = i;
+        parallel_sort(order.begin(), order.end(), [&less](unsigned long a, unsigned long b) {
+            if (less(a, b))
+                return true;
+            if (less(b, a))
+                return false;
+            return a < b;
+        }, threads);
+
+        std::vector<unsigned long> remap(count);
+        for (unsigned long k = 0; k < count; )
+        {
+            unsigned long first = order[k];
+            remap[first] = first;
+            for (++k; k < count && !less(first, order[k]) && !less(order[k], first); ++k)
+                remap[order[k]] = first;
+        }
+        return remap;
+    }
+
 } // namespace MeshCore
 
 
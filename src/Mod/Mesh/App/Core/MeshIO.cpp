@@ -2058,24 +2058,38 @@ bool MeshOutput::SaveFormat(std::ostream &str, MeshIO::Format fmt) const
 
 /** Saves the mesh object into an ASCII file. */
 bool MeshOutput::SaveAsciiSTL (std::ostream &rstrOut) const
+{
+    if (!rstrOut || rstrOut.bad() == true || _rclMesh.CountFacets() == 0)
+        return false;
+
+    if (this->objectName.empty())
+        rstrOut << "solid Mesh\n";
+    else
+        rstrOut << "solid " << this->objectName << '\n';
+
+    if (!SaveAsciiSTLFacets(rstrOut))
+        return false;
+
+    rstrOut << "endsolid Mesh\n";
+
+    return true;
+}
+
+/** Writes the facets of the mesh object as ASCII STL records. */
+bool MeshOutput::SaveAsciiSTLFacets (std::ostream &rstrOut) const
 {
     MeshFacetIterator clIter(_rclMesh), clEnd(_rclMesh);
     clIter.Transform(this->_transform);
     const MeshGeomFacet *pclFacet;
     unsigned long i;
 
-    if (!rstrOut || rstrOut.bad() == true || _rclMesh.CountFacets() == 0)
+    if (!rstrOut || rstrOut.bad() == true)
         return false;
 
     rstrOut.precision(6);
     rstrOut.setf(std::ios::fixed | std::ios::showpoint);
     Base::SequencerLauncher seq("saving...", _rclMesh.CountFacets() + 1);
 
-    if (this->objectName.empty())
-        rstrOut << "solid Mesh\n";
-    else
-        rstrOut << "solid " << this->objectName << '\n';
-
     clIter.Begin();
     clEnd.End();
     while (clIter < clEnd) {
@@ -2101,33 +2115,44 @@ bool MeshOutput::SaveAsciiSTL (std::ostream &rstrOut) const
         seq.next(true);// allow to cancel
     }
 
-    rstrOut << "endsolid Mesh\n";
-
     return true;
 }
 
 /** Saves the mesh object into a binary file. */
 bool MeshOutput::SaveBinarySTL (std::ostream &rstrOut) const
+{
+    if (!rstrOut || rstrOut.bad() == true /*|| _rclMesh.CountFacets() == 0*/)
+        return false;
+
+    SaveBinarySTLHeader(rstrOut, (uint32_t)_rclMesh.CountFacets());
+    return SaveBinarySTLFacets(rstrOut);
+}
+
+/** Writes the 80 bytes header and the number of facets of a binary STL file. */
+void MeshOutput::SaveBinarySTLHeader (std::ostream &rstrOut, uint32_t countFacets)
+{
+    char szInfo[81];
+
+    // stl_header has a length of 80
+    strcpy(szInfo, stl_header.c_str());
+    rstrOut.write(szInfo, std::strlen(szInfo));
+    rstrOut.write((const char*)&countFacets, sizeof(countFacets));
+}
+
+/** Writes the facets of the mesh object as binary STL records. */
+bool MeshOutput::SaveBinarySTLFacets (std::ostream &rstrOut) const
 {
     MeshFacetIterator clIter(_rclMesh), clEnd(_rclMesh);
     clIter.Transform(this->_transform);
     const MeshGeomFacet *pclFacet;
     uint32_t i;
     uint16_t usAtt;
-    char szInfo[81];
 
-    if (!rstrOut || rstrOut.bad() == true /*|| _rclMesh.CountFacets() == 0*/)
+    if (!rstrOut || rstrOut.bad() == true)
         return false;
 
     Base::SequencerLauncher seq("saving...", _rclMesh.CountFacets() + 1);
 
-    // stl_header has a length of 80
-    strcpy(szInfo, stl_header.c_str());
-    rstrOut.write(szInfo, std::strlen(szInfo));
-
-    uint32_t uCtFts = (uint32_t)_rclMesh.CountFacets();
-    rstrOut.write((const char*)&uCtFts, sizeof(uCtFts));
-
     usAtt = 0;
     clIter.Begin();
     clEnd.End();
@@ -181,6 +181,13 @@ public:
     bool SaveAsciiSTL (std::ostream &rstrOut) const;
     /** Saves the mesh object into a binary STL file. */
     bool SaveBinarySTL (std::ostream &rstrOut) const;
+    /** Writes the facets as ASCII STL records without the solid header,
+     * e.g. to write a mesh that is processed chunk by chunk. */
+    bool SaveAsciiSTLFacets (std::ostream &rstrOut) const;
+    /** Writes the header of a binary STL file with \a countFacets facets. */
+    static void SaveBinarySTLHeader (std::ostream &rstrOut, uint32_t countFacets);
+    /** Writes the facets as binary STL records without the header. */
+    bool SaveBinarySTLFacets (std::ostream &rstrOut) const;
     /** Saves the mesh object into an OBJ file. */
     bool SaveOBJ (std::ostream &rstrOut) const;
     /** Saves the materials of an OBJ file. */
@@ -23,11 +23,17 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <memory>
 #endif
 
+#include <QtConcurrentMap>
+
 #include "Segmentation.h"
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "Functional.h"
 
 using namespace MeshCore;
 
@@ -104,6 +110,11 @@ void MeshDistancePlanarSegment::AddFacet(const MeshFacet& face)
     fitter->AddPoint(triangle.GetGravityPoint());
 }
 
+MeshSurfaceSegment* MeshDistancePlanarSegment::Clone() const
+{
+    return new MeshDistancePlanarSegment(kernel, minFacets, tolerance);
+}
+
 // --------------------------------------------------------
 
 PlaneSurfaceFit::PlaneSurfaceFit()
@@ -173,6 +184,13 @@ float PlaneSurfaceFit::GetDistanceToSurface(const Base::Vector3f& pnt) const
         return fitter->GetDistanceToPlane(pnt);
 }
 
+AbstractSurfaceFit* PlaneSurfaceFit::Clone() const
+{
+    if (fitter)
+        return new PlaneSurfaceFit();
+    return new PlaneSurfaceFit(basepoint, normal);
+}
+
 std::vector<float> PlaneSurfaceFit::Parameters() const
 {
     Base::Vector3f base = basepoint;
@@ -278,6 +296,13 @@ float CylinderSurfaceFit::GetDistanceToSurface(const Base::Vector3f& pnt) const
     return (dist - radius);
 }
 
+AbstractSurfaceFit* CylinderSurfaceFit::Clone() const
+{
+    if (fitter)
+        return new CylinderSurfaceFit();
+    return new CylinderSurfaceFit(basepoint, axis, radius);
+}
+
 std::vector<float> CylinderSurfaceFit::Parameters() const
 {
     Base::Vector3f base = basepoint;
@@ -375,6 +400,13 @@ float SphereSurfaceFit::GetDistanceToSurface(const Base::Vector3f& pnt) const
     return (dist - radius);
 }
 
+AbstractSurfaceFit* SphereSurfaceFit::Clone() const
+{
+    if (fitter)
+        return new SphereSurfaceFit();
+    return new SphereSurfaceFit(center, radius);
+}
+
 std::vector<float> SphereSurfaceFit::Parameters() const
 {
     Base::Vector3f base = center;
@@ -448,6 +480,14 @@ std::vector<float> MeshDistanceGenericSurfaceFitSegment::Parameters() const
     return fitter->Parameters();
 }
 
+MeshSurfaceSegment* MeshDistanceGenericSurfaceFitSegment::Clone() const
+{
+    AbstractSurfaceFit* fit = fitter->Clone();
+    if (!fit)
+        return nullptr;
+    return new MeshDistanceGenericSurfaceFitSegment(fit, kernel, minFacets, tolerance);
+}
+
 // --------------------------------------------------------
 
 bool MeshCurvaturePlanarSegment::TestFacet (const MeshFacet &rclFacet) const
@@ -536,6 +576,335 @@ bool MeshSurfaceVisitor::Visit (const MeshFacet & face, const MeshFacet &,
 
 // --------------------------------------------------------
 
+namespace MeshCore {
+
+/// Union-find with the lowest index as root of each set.
+static unsigned long FindRoot(std::vector<unsigned long>& parent, unsigned long i)
+{
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+static void UniteRoots(std::vector<unsigned long>& parent, unsigned long a, unsigned long b)
+{
+    a = FindRoot(parent, a);
+    b = FindRoot(parent, b);
+    if (a < b)
+        parent[b] = a;
+    else if (b < a)
+        parent[a] = b;
+}
+
+/// A spatially coherent block of facets that is grown by its own segment clone.
+struct SegmentBlock
+{
+    unsigned long index;
+    std::vector<unsigned long> facets;
+    std::vector<MeshSegment> regions;
+};
+
+class SegmentBlockGrower
+{
+public:
+    SegmentBlockGrower(const MeshKernel& kernel, const MeshSurfaceSegment& segm,
+                       const std::vector<unsigned long>& blockOf, std::vector<char>& visited)
+        : kernel(kernel), segm(segm), blockOf(blockOf), visited(visited)
+    {
+    }
+    void operator()(SegmentBlock& block) const
+    {
+        // only the facets of this block are read and written
+        std::unique_ptr<MeshSurfaceSegment> clone(segm.Clone());
+        const MeshFacetArray& rFAry = kernel.GetFacets();
+        unsigned long countFacets = rFAry.size();
+        std::vector<unsigned long> level, next;
+        for (std::vector<unsigned long>::const_iterator it = block.facets.begin(); it != block.facets.end(); ++it) {
+            unsigned long startFacet = *it;
+            if (visited[startFacet])
+                continue;
+
+            visited[startFacet] = 1;
+            MeshSegment indices;
+            clone->Initialize(startFacet);
+            if (clone->TestInitialFacet(startFacet))
+                indices.push_back(startFacet);
+
+            level.assign(1, startFacet);
+            while (!level.empty()) {
+                for (std::vector<unsigned long>::iterator jt = level.begin(); jt != level.end(); ++jt) {
+                    const MeshFacet& face = rFAry[*jt];
+                    for (int i=0; i<3; i++) {
+                        unsigned long index = face._aulNeighbours[i];
+                        if (index >= countFacets || blockOf[index] != block.index || visited[index])
+                            continue;
+                        if (!clone->TestFacet(rFAry[index]))
+                            continue;
+                        visited[index] = 1;
+                        next.push_back(index);
+                        indices.push_back(index);
+                        clone->AddFacet(rFAry[index]);
+                    }
+                }
+                level.swap(next);
+                next.clear();
+            }
+
+            if (indices.size() > 1)
+                block.regions.push_back(indices);
+        }
+    }
+
+private:
+    const MeshKernel& kernel;
+    const MeshSurfaceSegment& segm;
+    const std::vector<unsigned long>& blockOf;
+    std::vector<char>& visited;
+};
+
+} // namespace MeshCore
+
+void MeshSegmentAlgorithm::FindStatelessSegments(MeshSurfaceSegment& segm, std::vector<unsigned long>& resetVisited)
+{
+    // As the facet test doesn't depend on the grown region a segment is the
+    // connected component of accepted facets that contains the start facet.
+    // Or if the start facet is rejected it's the union of the components
+    // adjacent to it. Thus, the components can be built concurrently and
+    // then be collected in the same order as the serial search does it.
+    const MeshFacetArray& rFAry = myKernel.GetFacets();
+    unsigned long countFacets = rFAry.size();
+    int threads = std::max(1, QThread::idealThreadCount());
+
+    std::vector<char> accepted(countFacets), initial(countFacets);
+    std::vector<unsigned long> parent(countFacets);
+    parallel_for(0, countFacets, [&](unsigned long first, unsigned long last) {
+        for (unsigned long i = first; i < last; i++) {
+            parent[i] = i;
+            const MeshFacet& face = rFAry[i];
+            if (face.IsFlag(MeshFacet::VISIT)) {
+                accepted[i] = 0;
+                initial[i] = 0;
+            }
+            else {
+                accepted[i] = segm.TestFacet(face) ? 1 : 0;
+                initial[i] = segm.TestInitialFacet(i) ? 1 : 0;
+            }
+        }
+
+        // join the accepted neighbours inside this block
+        for (unsigned long i = first; i < last; i++) {
+            if (!accepted[i])
+                continue;
+            for (int j=0; j<3; j++) {
+                unsigned long index = rFAry[i]._aulNeighbours[j];
+                if (index >= first && index < i && accepted[index])
+                    UniteRoots(parent, i, index);
+            }
+        }
+    }, threads);
+
+    // merge the components at the block boundaries and list the facets of each component
+    std::vector<unsigned long> offset(countFacets + 1, 0);
+    for (unsigned long i = 0; i < countFacets; i++) {
+        if (!accepted[i])
+            continue;
+        for (int j=0; j<3; j++) {
+            unsigned long index = rFAry[i]._aulNeighbours[j];
+            if (index < i && accepted[index])
+                UniteRoots(parent, i, index);
+        }
+    }
+    for (unsigned long i = 0; i < countFacets; i++) {
+        if (accepted[i]) {
+            parent[i] = FindRoot(parent, i);
+            offset[parent[i] + 1]++;
+        }
+    }
+    for (unsigned long i = 0; i < countFacets; i++)
+        offset[i + 1] += offset[i];
+    std::vector<unsigned long> members(offset[countFacets]);
+    std::vector<unsigned long> fill(offset.begin(), offset.end() - 1);
+    for (unsigned long i = 0; i < countFacets; i++) {
+        if (accepted[i])
+            members[fill[parent[i]]++] = i;
+    }
+
+    for (unsigned long i = 0; i < countFacets; i++) {
+        const MeshFacet& face = rFAry[i];
+        if (face.IsFlag(MeshFacet::VISIT))
+            continue;
+
+        face.SetFlag(MeshFacet::VISIT);
+        std::vector<unsigned long> indices;
+        if (initial[i])
+            indices.push_back(i);
+
+        for (int j=0; j<3; j++) {
+            unsigned long index = accepted[i] ? i : face._aulNeighbours[j];
+            if (index >= countFacets || !accepted[index])
+                continue;
+            unsigned long root = parent[index];
+            if (index != i && rFAry[root].IsFlag(MeshFacet::VISIT))
+                continue; // component already taken
+            for (unsigned long k = offset[root]; k < offset[root + 1]; k++) {
+                if (members[k] != i) {
+                    indices.push_back(members[k]);
+                    rFAry[members[k]].SetFlag(MeshFacet::VISIT);
+                }
+            }
+            if (index == i)
+                break;
+        }
+
+        // add or discard the segment
+        if (indices.size() <= 1) {
+            resetVisited.push_back(i);
+        }
+        else {
+            segm.AddSegment(indices);
+        }
+    }
+}
+
+bool MeshSegmentAlgorithm::FindSegmentsInBlocks(MeshSurfaceSegment& segm)
+{
+    std::unique_ptr<MeshSurfaceSegment> clone(segm.Clone());
+    if (!clone)
+        return false;
+
+    const MeshFacetArray& rFAry = myKernel.GetFacets();
+    unsigned long countFacets = rFAry.size();
+    int threads = std::max(1, QThread::idealThreadCount());
+
+    std::vector<unsigned long> order = parallel_select(countFacets, [&rFAry](unsigned long i) {
+        return !rFAry[i].IsFlag(MeshFacet::VISIT);
+    }, threads);
+    const unsigned long minBlockSize = 4096;
+    unsigned long countBlocks = std::min<unsigned long>(4 * threads, order.size() / minBlockSize);
+    if (countBlocks < 2)
+        return false;
+
+    // sort the facets along a Morton curve of their centers so that each block is compact
+    Base::BoundBox3f box = myKernel.GetBoundBox();
+    float lenX = std::max(box.LengthX(), FLOAT_EPS);
+    float lenY = std::max(box.LengthY(), FLOAT_EPS);
+    float lenZ = std::max(box.LengthZ(), FLOAT_EPS);
+    std::vector<uint32_t> keys(countFacets, 0);
+    parallel_for(0, order.size(), [&](unsigned long first, unsigned long last) {
+        for (unsigned long k = first; k < last; k++) {
+            Base::Vector3f c = myKernel.GetFacet(order[k]).GetGravityPoint();
+            uint32_t x = static_cast<uint32_t>(std::min(1023.0f, 1023.0f * (c.x - box.MinX) / lenX));
+            uint32_t y = static_cast<uint32_t>(std::min(1023.0f, 1023.0f * (c.y - box.MinY) / lenY));
+            uint32_t z = static_cast<uint32_t>(std::min(1023.0f, 1023.0f * (c.z - box.MinZ) / lenZ));
+            uint32_t key = 0;
+            for (int b = 9; b >= 0; b--)
+                key = (key << 3) | (((x >> b) & 1) << 2) | (((y >> b) & 1) << 1) | ((z >> b) & 1);
+            keys[order[k]] = key;
+        }
+    }, threads);
+    parallel_sort(order.begin(), order.end(), [&keys](unsigned long a, unsigned long b) {
+        return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
+    }, threads);
+
+    std::vector<unsigned long> blockOf(countFacets, ULONG_MAX);
+    std::vector<SegmentBlock> blocks(countBlocks);
+    for (unsigned long b = 0; b < countBlocks; b++) {
+        SegmentBlock& block = blocks[b];
+        block.index = b;
+        block.facets.assign(order.begin() + order.size() * b / countBlocks,
+                            order.begin() + order.size() * (b + 1) / countBlocks);
+        std::sort(block.facets.begin(), block.facets.end());
+        for (std::vector<unsigned long>::iterator it = block.facets.begin(); it != block.facets.end(); ++it)
+            blockOf[*it] = b;
+    }
+
+    std::vector<char> visited(countFacets, 0);
+    QtConcurrent::blockingMap(blocks, SegmentBlockGrower(myKernel, segm, blockOf, visited));
+
+    // merge adjacent regions of different blocks if the one region still fits to the other
+    std::vector<MeshSegment> regions;
+    for (std::vector<SegmentBlock>::iterator it = blocks.begin(); it != blocks.end(); ++it) {
+        for (std::vector<MeshSegment>::iterator jt = it->regions.begin(); jt != it->regions.end(); ++jt)
+            regions.push_back(std::move(*jt));
+    }
+    std::vector<unsigned long> regionOf(countFacets, ULONG_MAX);
+    for (unsigned long r = 0; r < regions.size(); r++) {
+        for (MeshSegment::iterator it = regions[r].begin(); it != regions[r].end(); ++it)
+            regionOf[*it] = r;
+    }
+
+    std::vector<std::pair<unsigned long, unsigned long> > boundary;
+    for (unsigned long r = 0; r < regions.size(); r++) {
+        for (MeshSegment::iterator it = regions[r].begin(); it != regions[r].end(); ++it) {
+            const MeshFacet& face = rFAry[*it];
+            for (int j=0; j<3; j++) {
+                unsigned long index = face._aulNeighbours[j];
+                if (index < countFacets && regionOf[index] != ULONG_MAX && regionOf[index] > r
+                        && blockOf[index] != blockOf[*it])
+                    boundary.emplace_back(r, regionOf[index]);
+            }
+        }
+    }
+    std::sort(boundary.begin(), boundary.end());
+    boundary.erase(std::unique(boundary.begin(), boundary.end()), boundary.end());
+
+    std::vector<unsigned long> parent(regions.size());
+    for (unsigned long r = 0; r < regions.size(); r++)
+        parent[r] = r;
+    unsigned long fittedRegion = ULONG_MAX;
+    std::size_t fittedSize = 0;
+    for (std::vector<std::pair<unsigned long, unsigned long> >::iterator it = boundary.begin(); it != boundary.end(); ++it) {
+        unsigned long a = FindRoot(parent, it->first);
+        unsigned long b = FindRoot(parent, it->second);
+        if (a == b)
+            continue;
+
+        // test the facets of the smaller region against the fit of the larger one
+        unsigned long base = regions[a].size() >= regions[b].size() ? a : b;
+        unsigned long test = base == a ? b : a;
+        if (fittedRegion != base || fittedSize != regions[base].size()) {
+            const MeshSegment& facets = regions[base];
+            clone->Initialize(facets.front());
+            for (std::size_t k = 1; k < facets.size(); k++)
+                clone->AddFacet(rFAry[facets[k]]);
+            fittedRegion = base;
+            fittedSize = facets.size();
+        }
+
+        bool fits = true;
+        for (MeshSegment::iterator jt = regions[test].begin(); jt != regions[test].end() && fits; ++jt)
+            fits = clone->TestFacet(rFAry[*jt]);
+        if (fits) {
+            UniteRoots(parent, a, b);
+            unsigned long root = std::min(a, b);
+            unsigned long other = std::max(a, b);
+            regions[root].insert(regions[root].end(), regions[other].begin(), regions[other].end());
+            regions[other].clear();
+            fittedRegion = ULONG_MAX;
+        }
+    }
+
+    std::vector<MeshSegment> merged;
+    for (unsigned long r = 0; r < regions.size(); r++) {
+        if (parent[r] == r) {
+            std::sort(regions[r].begin(), regions[r].end());
+            merged.push_back(std::move(regions[r]));
+        }
+    }
+    std::sort(merged.begin(), merged.end(), [](const MeshSegment& a, const MeshSegment& b) {
+        return a.front() < b.front();
+    });
+    for (std::vector<MeshSegment>::iterator it = merged.begin(); it != merged.end(); ++it) {
+        for (MeshSegment::iterator jt = it->begin(); jt != it->end(); ++jt)
+            rFAry[*jt].SetFlag(MeshFacet::VISIT);
+        segm.AddSegment(*it);
+    }
+
+    return true;
+}
+
 void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm)
 {
     // reset VISIT flags
@@ -556,6 +925,15 @@ void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm
         cAlgo.ResetFacetsFlag(resetVisited, MeshCore::MeshFacet::VISIT);
         resetVisited.clear();
 
+        if (parallel) {
+            if ((*it)->IsStateless()) {
+                FindStatelessSegments(**it, resetVisited);
+                continue;
+            }
+            if (FindSegmentsInBlocks(**it))
+                continue;
+        }
+
         MeshCore::MeshIsNotFlag<MeshCore::MeshFacet> flag;
         iCur = std::find_if(iBeg, iEnd, [flag](const MeshFacet& f) {
             return flag(f, MeshFacet::VISIT);
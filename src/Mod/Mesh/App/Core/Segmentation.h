@@ -48,6 +48,10 @@ public:
     virtual void Initialize(unsigned long);
     virtual bool TestInitialFacet(unsigned long) const;
     virtual void AddFacet(const MeshFacet& rclFacet);
+    /// Returns true if TestFacet() only depends on the tested facet and not on the facets added before.
+    virtual bool IsStateless() const { return false; }
+    /// Returns a new instance with the same settings but without segments, or null if not supported.
+    virtual MeshSurfaceSegment* Clone() const { return nullptr; }
     void AddSegment(const std::vector<unsigned long>&);
     const std::vector<MeshSegment>& GetSegments() const { return segments; }
     MeshSegment FindSegment(unsigned long) const;
@@ -80,6 +84,7 @@ public:
     const char* GetType() const { return "Plane"; }
     void Initialize(unsigned long);
     void AddFacet(const MeshFacet& rclFacet);
+    MeshSurfaceSegment* Clone() const;
 
 protected:
     Base::Vector3f basepoint;
@@ -100,6 +105,10 @@ public:
     virtual float Fit() = 0;
     virtual float GetDistanceToSurface(const Base::Vector3f&) const = 0;
     virtual std::vector<float> Parameters() const = 0;
+    /// Returns true if the surface is predefined and not fitted to the triangles.
+    virtual bool IsStateless() const { return false; }
+    /// Returns a new fit with the same settings, or null if not supported.
+    virtual AbstractSurfaceFit* Clone() const { return nullptr; }
 };
 
 class MeshExport PlaneSurfaceFit : public AbstractSurfaceFit
@@ -116,6 +125,8 @@ public:
     float Fit();
     float GetDistanceToSurface(const Base::Vector3f&) const;
     std::vector<float> Parameters() const;
+    bool IsStateless() const { return fitter == nullptr; }
+    AbstractSurfaceFit* Clone() const;
 
 private:
     Base::Vector3f basepoint;
@@ -137,6 +148,8 @@ public:
     float Fit();
     float GetDistanceToSurface(const Base::Vector3f&) const;
     std::vector<float> Parameters() const;
+    bool IsStateless() const { return fitter == nullptr; }
+    AbstractSurfaceFit* Clone() const;
 
 private:
     Base::Vector3f basepoint;
@@ -159,6 +172,8 @@ public:
     float Fit();
     float GetDistanceToSurface(const Base::Vector3f&) const;
     std::vector<float> Parameters() const;
+    bool IsStateless() const { return fitter == nullptr; }
+    AbstractSurfaceFit* Clone() const;
 
 private:
     Base::Vector3f center;
@@ -178,6 +193,8 @@ public:
     bool TestInitialFacet(unsigned long) const;
     void AddFacet(const MeshFacet& rclFacet);
     std::vector<float> Parameters() const;
+    bool IsStateless() const { return fitter->IsStateless(); }
+    MeshSurfaceSegment* Clone() const;
 
 protected:
     AbstractSurfaceFit* fitter;
@@ -190,6 +207,7 @@ class MeshExport MeshCurvatureSurfaceSegment : public MeshSurfaceSegment
 public:
     MeshCurvatureSurfaceSegment(const std::vector<CurvatureInfo>& ci, unsigned long minFacets)
         : MeshSurfaceSegment(minFacets), info(ci) {}
+    bool IsStateless() const { return true; }
 
 protected:
     const std::vector<CurvatureInfo>& info;
@@ -269,11 +287,26 @@ protected:
 class MeshExport MeshSegmentAlgorithm
 {
 public:
-    MeshSegmentAlgorithm(const MeshKernel& kernel) : myKernel(kernel) {}
+    MeshSegmentAlgorithm(const MeshKernel& kernel) : myKernel(kernel), parallel(false) {}
     void FindSegments(std::vector<MeshSurfaceSegmentPtr>&);
+    /**
+     * If \a on is true the segments are searched concurrently. Segments whose facet
+     * test is stateless give the same facets as the serial search. Segments that fit
+     * a surface while growing are grown in spatial blocks with a clone each and the
+     * regions are merged at the block boundaries if the merged region still fits,
+     * so the result may differ slightly from the serial search. Segments that cannot
+     * be cloned are always searched serially.
+     */
+    void SetParallel(bool on) { parallel = on; }
+    bool IsParallel() const { return parallel; }
+
+private:
+    void FindStatelessSegments(MeshSurfaceSegment&, std::vector<unsigned long>& resetVisited);
+    bool FindSegmentsInBlocks(MeshSurfaceSegment&);
 
 private:
     const MeshKernel& myKernel;
+    bool parallel;
 };
 
 } // MeshCore
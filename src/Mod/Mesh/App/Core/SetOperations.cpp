@@ -25,9 +25,21 @@
 
 
 #ifndef _PreComp_
+# include <algorithm>
+# include <array>
+# include <atomic>
+# include <climits>
+# include <cmath>
+# include <deque>
+# include <functional>
 # include <ios>
+# include <limits>
+# include <sstream>
+# include <tuple>
 #endif
 
+#include <QtConcurrentMap>
+
 #include <fstream>
 #include "SetOperations.h"
 #include "Algorithm.h"
@@ -41,7 +53,10 @@
 #include "Evaluation.h"
 #include "Definitions.h"
 #include "Triangulation.h"
+#include "Functional.h"
 
+#include <Base/Console.h>
+#include <Base/Exception.h>
 #include <Base/Sequencer.h>
 #include <Base/Builder3D.h>
 #include <Base/Tools2D.h>
@@ -55,7 +70,8 @@ SetOperations::SetOperations (const MeshKernel &cutMesh1, const MeshKernel &cutM
   _cutMesh1(cutMesh2),
   _resultMesh(result),
   _operationType(opType),
-  _minDistanceToPoint(minDistanceToPoint)
+  _minDistanceToPoint(minDistanceToPoint),
+  _robust(false)
 {
 }
 
@@ -65,6 +81,12 @@ SetOperations::~SetOperations (void)
 
 void SetOperations::Do ()
 {
+  if (_robust)
+  {
+    DoRobust();
+    return;
+  }
+
  _minDistanceToPoint = 0.000001f;
   float saveMinMeshDistance = MeshDefinitions::_fMinPointDistance;
   MeshDefinitions::SetMinPointDistance(0.000001f);
@@ -618,3 +640,1435 @@ bool SetOperations::CollectFacetVisitor::AllowVisit (const MeshFacet& rclFacet,
 
     return true;
 }
+
+// ----------------------------------------------------------------------------
+
+namespace MeshCore {
+namespace {
+
+/*
+ * Exact arithmetic on expansions, i.e. sums of non-overlapping doubles sorted
+ * by increasing magnitude (J.R. Shewchuk, Adaptive Precision Floating-Point
+ * Arithmetic and Fast Robust Geometric Predicates). An empty expansion is zero.
+ * The predicates below evaluate in double precision first and only fall back to
+ * the exact evaluation if the result is within the rounding error bound.
+ */
+typedef std::vector<double> Expansion;
+
+inline void TwoSum (double a, double b, double& x, double& y)
+{
+  x = a + b;
+  double bv = x - a;
+  double av = x - bv;
+  y = (a - av) + (b - bv);
+}
+
+inline void FastTwoSum (double a, double b, double& x, double& y)
+{
+  x = a + b;
+  y = b - (x - a);
+}
+
+inline void TwoProduct (double a, double b, double& x, double& y)
+{
+  x = a * b;
+  y = std::fma(a, b, -x);
+}
+
+Expansion Difference (double a, double b)
+{
+  Expansion h;
+  double x = a - b;
+  double bv = a - x;
+  double av = x + bv;
+  double y = (a - av) + (bv - b);
+  if (y != 0.0)
+    h.push_back(y);
+  if (x != 0.0)
+    h.push_back(x);
+  return h;
+}
+
+Expansion Grow (const Expansion& e, double b)
+{
+  Expansion h;
+  h.reserve(e.size() + 1);
+  double q = b;
+  for (Expansion::const_iterator it = e.begin(); it != e.end(); ++it) {
+    double sum, err;
+    TwoSum(q, *it, sum, err);
+    if (err != 0.0)
+      h.push_back(err);
+    q = sum;
+  }
+  if (q != 0.0)
+    h.push_back(q);
+  return h;
+}
+
+Expansion Sum (const Expansion& e, const Expansion& f)
+{
+  Expansion h = e;
+  for (Expansion::const_iterator it = f.begin(); it != f.end(); ++it)
+    h = Grow(h, *it);
+  return h;
+}
+
+Expansion Scale (const Expansion& e, double b)
+{
+  Expansion h;
+  if (e.empty() || b == 0.0)
+    return h;
+  h.reserve(2 * e.size());
+  double q, hh;
+  TwoProduct(e[0], b, q, hh);
+  if (hh != 0.0)
+    h.push_back(hh);
+  for (std::size_t i = 1; i < e.size(); i++) {
+    double p1, p0, sum;
+    TwoProduct(e[i], b, p1, p0);
+    TwoSum(q, p0, sum, hh);
+    if (hh != 0.0)
+      h.push_back(hh);
+    FastTwoSum(p1, sum, q, hh);
+    if (hh != 0.0)
+      h.push_back(hh);
+  }
+  if (q != 0.0)
+    h.push_back(q);
+  return h;
+}
+
+Expansion Product (const Expansion& e, const Expansion& f)
+{
+  Expansion h;
+  for (Expansion::const_iterator it = f.begin(); it != f.end(); ++it)
+    h = Sum(h, Scale(e, *it));
+  return h;
+}
+
+Expansion Negate (Expansion e)
+{
+  for (Expansion::iterator it = e.begin(); it != e.end(); ++it)
+    *it = -*it;
+  return e;
+}
+
+inline int Sign (const Expansion& e)
+{
+  return e.empty() ? 0 : (e.back() > 0.0 ? 1 : -1);
+}
+
+/// Exact cross product (a1 - a0) x (b1 - b0) of the difference vectors
+void Cross (const Base::Vector3d& a0, const Base::Vector3d& a1,
+            const Base::Vector3d& b0, const Base::Vector3d& b1, Expansion n[3])
+{
+  Expansion u[3], v[3];
+  for (unsigned short i = 0; i < 3; i++) {
+    u[i] = Difference(a1[i], a0[i]);
+    v[i] = Difference(b1[i], b0[i]);
+  }
+  for (int i = 0; i < 3; i++) {
+    int j = (i + 1) % 3, k = (i + 2) % 3;
+    n[i] = Sum(Product(u[j], v[k]), Negate(Product(u[k], v[j])));
+  }
+}
+
+/**
+ * Returns the sign of ((b - a) x (c - a)) * (d - a), i.e. 1 if d lies on the side
+ * of the plane through a, b, c the normal of the counterclockwise triangle points to.
+ */
+int Orient3d (const Base::Vector3d& a, const Base::Vector3d& b,
+              const Base::Vector3d& c, const Base::Vector3d& d)
+{
+  // Shewchuk's orient3d computes det[a-d, b-d, c-d] which has the opposite sign
+  double adx = a.x - d.x, bdx = b.x - d.x, cdx = c.x - d.x;
+  double ady = a.y - d.y, bdy = b.y - d.y, cdy = c.y - d.y;
+  double adz = a.z - d.z, bdz = b.z - d.z, cdz = c.z - d.z;
+
+  double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+  double cdxady = cdx * ady, adxcdy = adx * cdy;
+  double adxbdy = adx * bdy, bdxady = bdx * ady;
+
+  double det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+  double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * std::fabs(adz)
+                   + (std::fabs(cdxady) + std::fabs(adxcdy)) * std::fabs(bdz)
+                   + (std::fabs(adxbdy) + std::fabs(bdxady)) * std::fabs(cdz);
+  const double eps = std::numeric_limits<double>::epsilon() * 0.5;
+  const double errbound = (7.0 + 56.0 * eps) * eps * permanent;
+  if (det > errbound)
+    return -1;
+  if (-det > errbound)
+    return 1;
+
+  Expansion n[3];
+  Cross(a, b, a, c, n);
+  Expansion w = Product(n[0], Difference(d.x, a.x));
+  w = Sum(w, Product(n[1], Difference(d.y, a.y)));
+  w = Sum(w, Product(n[2], Difference(d.z, a.z)));
+  return Sign(w);
+}
+
+/// Returns the sign of (b - a) x (c - a), i.e. 1 if a, b, c are counterclockwise
+int Orient2d (const Base::Vector2d& a, const Base::Vector2d& b, const Base::Vector2d& c)
+{
+  double detleft = (a.x - c.x) * (b.y - c.y);
+  double detright = (a.y - c.y) * (b.x - c.x);
+  double det = detleft - detright;
+  const double eps = std::numeric_limits<double>::epsilon() * 0.5;
+  const double errbound = (3.0 + 16.0 * eps) * eps * (std::fabs(detleft) + std::fabs(detright));
+  if (det > errbound)
+    return 1;
+  if (-det > errbound)
+    return -1;
+
+  Expansion l = Product(Difference(a.x, c.x), Difference(b.y, c.y));
+  Expansion r = Product(Difference(a.y, c.y), Difference(b.x, c.x));
+  return Sign(Sum(l, Negate(r)));
+}
+
+/// Returns the sign of the first non-zero component of (a1 - a0) x (b1 - b0)
+int CrossSign (const Base::Vector3d& a0, const Base::Vector3d& a1,
+               const Base::Vector3d& b0, const Base::Vector3d& b1)
+{
+  Expansion n[3];
+  Cross(a0, a1, b0, b1, n);
+  for (int i = 0; i < 3; i++) {
+    if (Sign(n[i]) != 0)
+      return Sign(n[i]);
+  }
+  return 0;
+}
+
+/*
+ * Predicates on the two input meshes where the points of the second mesh
+ * (side 1) are translated by the infinitesimal vector d = (e, e^2, e^3). This
+ * symbolic perturbation resolves degenerate configurations like coplanar or
+ * touching facets consistently, so the predicates never return 0 unless a
+ * facet is degenerate itself.
+ */
+
+/// Side of the point p of mesh \a side with respect to the triangle t of the other mesh
+int PlaneSide (const Base::Vector3d* t, const Base::Vector3d& p, int side)
+{
+  // orient(t, p + d) = orient(t, p) + n * d, orient(t + d, p) = orient(t, p) - n * d
+  int s = Orient3d(t[0], t[1], t[2], p);
+  if (s != 0)
+    return s;
+  int n = CrossSign(t[0], t[1], t[0], t[2]);
+  return side == 1 ? n : -n;
+}
+
+/// Sign of orient(p, q, a, b) for the edge (p, q) of mesh \a side and (a, b) of the other mesh
+int EdgeSide (const Base::Vector3d& p, const Base::Vector3d& q, int side,
+              const Base::Vector3d& a, const Base::Vector3d& b)
+{
+  // orient(p, q, a + d, b + d) = orient(p, q, a, b) + d * ((q - p) x (a - b))
+  int s = Orient3d(p, q, a, b);
+  if (s != 0)
+    return s;
+  int m = CrossSign(p, q, b, a);
+  return side == 0 ? m : -m;
+}
+
+/// Checks whether the segment (p, q) of mesh \a side crosses the triangle t of the other mesh
+bool SegmentCrossesTriangle (const Base::Vector3d& p, const Base::Vector3d& q, int side,
+                             const Base::Vector3d* t)
+{
+  int s0 = EdgeSide(p, q, side, t[0], t[1]);
+  if (s0 == 0)
+    return false;
+  return EdgeSide(p, q, side, t[1], t[2]) == s0 && EdgeSide(p, q, side, t[2], t[0]) == s0;
+}
+
+struct Triangle
+{
+  unsigned long v[3];
+};
+
+/// A point on the edge (p0, p1) of a mesh
+struct EdgePoint
+{
+  unsigned long p0, p1, id;
+
+  bool operator < (const EdgePoint& e) const
+  {
+    if (p0 != e.p0) return p0 < e.p0;
+    if (p1 != e.p1) return p1 < e.p1;
+    return id < e.id;
+  }
+  bool operator == (const EdgePoint& e) const
+  {
+    return p0 == e.p0 && p1 == e.p1 && id == e.id;
+  }
+};
+
+/// The point where the edge (p0, p1) of mesh side crosses the facet of the other mesh
+struct CutKey
+{
+  int side;
+  unsigned long p0, p1;
+  unsigned long facet;
+
+  CutKey () : side(0), p0(0), p1(0), facet(0)
+  {
+  }
+  CutKey (int s, unsigned long q0, unsigned long q1, unsigned long f)
+    : side(s), p0(std::min(q0, q1)), p1(std::max(q0, q1)), facet(f)
+  {
+  }
+  bool operator < (const CutKey& k) const
+  {
+    if (side != k.side) return side < k.side;
+    if (p0 != k.p0) return p0 < k.p0;
+    if (p1 != k.p1) return p1 < k.p1;
+    return facet < k.facet;
+  }
+  bool operator == (const CutKey& k) const
+  {
+    return side == k.side && p0 == k.p0 && p1 == k.p1 && facet == k.facet;
+  }
+};
+
+/// Part of the intersection curve where the facets facet[0] and facet[1] of both meshes cross
+struct CutSegment
+{
+  unsigned long facet[2];
+  CutKey key[2];
+};
+
+/*
+ * Splits a facet along the intersection segments into triangles. The facet is
+ * projected onto the coordinate plane most parallel to it, the points on its
+ * edges and in its interior are inserted one by one and the segments are then
+ * recovered by edge flips (Sloan's algorithm). All orientation tests are exact.
+ */
+class FacetSplitter
+{
+public:
+  FacetSplitter (const Base::Vector3d* corners, const unsigned long* ids)
+  {
+    Base::Vector3d n = (corners[1] - corners[0]) % (corners[2] - corners[0]);
+    _axis = 0;
+    if (std::fabs(n.y) > std::fabs(n.x))
+      _axis = 1;
+    if (std::fabs(n.z) > std::max(std::fabs(n.x), std::fabs(n.y)))
+      _axis = 2;
+    // mirror the projection to keep the corners counterclockwise
+    _mirror = n[_axis] < 0.0;
+    for (int i = 0; i < 3; i++) {
+      _corners[i] = corners[i];
+      AddVertex(ids[i], corners[i]);
+    }
+  }
+
+  void AddEdgePoint (int edge, unsigned long id, const Base::Vector3d& pt)
+  {
+    Base::Vector3d dir = _corners[(edge + 1) % 3] - _corners[edge];
+    double len = dir.Sqr();
+    double t = len > 0.0 ? ((pt - _corners[edge]) * dir) / len : 0.0;
+    _edgePoints[edge].push_back(SplitPoint(t, id, pt));
+  }
+
+  void AddInnerPoint (unsigned long id, const Base::Vector3d& pt)
+  {
+    _innerPoints.push_back(std::make_pair(id, pt));
+  }
+
+  void AddConstraint (unsigned long id1, unsigned long id2)
+  {
+    _constraints.push_back(std::make_pair(id1, id2));
+  }
+
+  /// Returns the edge the point lies on in the projection or -1
+  int FindEdge (const Base::Vector3d& pt) const
+  {
+    Base::Vector2d p = Project(pt);
+    for (int j = 0; j < 3; j++) {
+      const Base::Vector2d& a = _uv[j];
+      const Base::Vector2d& b = _uv[(j + 1) % 3];
+      if (Orient2d(a, b, p) == 0 && (p - a) * (b - a) > 0.0 && (p - b) * (a - b) > 0.0)
+        return j;
+    }
+    return -1;
+  }
+
+  /// Returns false if a segment could not be recovered
+  bool Compute ()
+  {
+    if (Orient2d(_uv[0], _uv[1], _uv[2]) <= 0) {
+      // degenerate facet, keep it
+      AddTriangle(0, 1, 2);
+      return _constraints.empty();
+    }
+
+    AddTriangle(0, 1, 2);
+    for (int i = 0; i < 3; i++) {
+      std::sort(_edgePoints[i].begin(), _edgePoints[i].end());
+      int prev = i, next = (i + 1) % 3;
+      for (std::vector<SplitPoint>::iterator it = _edgePoints[i].begin(); it != _edgePoints[i].end(); ++it) {
+        if (_local.find(it->id) != _local.end())
+          continue;
+        int v = AddVertex(it->id, it->pt);
+        std::map<std::pair<int, int>, int>::iterator jt = _edges.find(std::make_pair(prev, next));
+        if (jt == _edges.end())
+          return false;
+        SplitTriangle(jt->second, prev, next, v);
+        prev = v;
+      }
+    }
+
+    for (std::vector<std::pair<unsigned long, Base::Vector3d> >::iterator it = _innerPoints.begin(); it != _innerPoints.end(); ++it) {
+      if (_local.find(it->first) != _local.end())
+        continue;
+      InsertPoint(AddVertex(it->first, it->second));
+    }
+
+    bool ok = true;
+    for (std::vector<std::pair<unsigned long, unsigned long> >::iterator it = _constraints.begin(); it != _constraints.end(); ++it) {
+      if (!Recover(_local[it->first], _local[it->second], 0))
+        ok = false;
+    }
+    return ok;
+  }
+
+  void GetTriangles (std::vector<Triangle>& triangles) const
+  {
+    for (std::vector<std::array<int, 3> >::const_iterator it = _triangles.begin(); it != _triangles.end(); ++it) {
+      Triangle t;
+      for (int i = 0; i < 3; i++)
+        t.v[i] = _ids[(*it)[i]];
+      triangles.push_back(t);
+    }
+  }
+
+private:
+  struct SplitPoint
+  {
+    double t;
+    unsigned long id;
+    Base::Vector3d pt;
+
+    SplitPoint (double t, unsigned long id, const Base::Vector3d& pt) : t(t), id(id), pt(pt)
+    {
+    }
+    bool operator < (const SplitPoint& p) const
+    {
+      return t < p.t || (t == p.t && id < p.id);
+    }
+  };
+
+  Base::Vector2d Project (const Base::Vector3d& pt) const
+  {
+    unsigned short u = (_axis + 1) % 3, v = (_axis + 2) % 3;
+    return Base::Vector2d(pt[u], _mirror ? -pt[v] : pt[v]);
+  }
+
+  int AddVertex (unsigned long id, const Base::Vector3d& pt)
+  {
+    std::map<unsigned long, int>::iterator it = _local.find(id);
+    if (it != _local.end())
+      return it->second;
+    int index = static_cast<int>(_uv.size());
+    _uv.push_back(Project(pt));
+    _ids.push_back(id);
+    _local[id] = index;
+    return index;
+  }
+
+  void AddTriangle (int a, int b, int c)
+  {
+    std::array<int, 3> t = {{ -1, -1, -1 }};
+    _triangles.push_back(t);
+    SetTriangle(static_cast<int>(_triangles.size()) - 1, a, b, c);
+  }
+
+  void SetTriangle (int index, int a, int b, int c)
+  {
+    std::array<int, 3>& t = _triangles[index];
+    for (int i = 0; i < 3; i++) {
+      if (t[i] < 0)
+        break;
+      std::map<std::pair<int, int>, int>::iterator it = _edges.find(std::make_pair(t[i], t[(i + 1) % 3]));
+      if (it != _edges.end() && it->second == index)
+        _edges.erase(it);
+    }
+    t[0] = a; t[1] = b; t[2] = c;
+    for (int i = 0; i < 3; i++)
+      _edges[std::make_pair(t[i], t[(i + 1) % 3])] = index;
+  }
+
+  int Opposite (int index, int a, int b) const
+  {
+    const std::array<int, 3>& t = _triangles[index];
+    for (int i = 0; i < 3; i++) {
+      if (t[i] != a && t[i] != b)
+        return t[i];
+    }
+    return -1;
+  }
+
+  /// Splits the triangle with the directed edge (a, b) at the point v on this edge
+  void SplitTriangle (int index, int a, int b, int v)
+  {
+    int c = Opposite(index, a, b);
+    SetTriangle(index, a, v, c);
+    AddTriangle(v, b, c);
+  }
+
+  void InsertPoint (int v)
+  {
+    const Base::Vector2d& p = _uv[v];
+    int best = -1;
+    double bestDist = -std::numeric_limits<double>::max();
+    for (std::size_t i = 0; i < _triangles.size(); i++) {
+      const std::array<int, 3>& t = _triangles[i];
+      int o[3];
+      for (int j = 0; j < 3; j++)
+        o[j] = Orient2d(_uv[t[j]], _uv[t[(j + 1) % 3]], p);
+      if (o[0] >= 0 && o[1] >= 0 && o[2] >= 0) {
+        int zeros = (o[0] == 0) + (o[1] == 0) + (o[2] == 0);
+        if (zeros == 1) {
+          int j = o[0] == 0 ? 0 : (o[1] == 0 ? 1 : 2);
+          int a = t[j], b = t[(j + 1) % 3];
+          SplitTriangle(static_cast<int>(i), a, b, v);
+          std::map<std::pair<int, int>, int>::iterator it = _edges.find(std::make_pair(b, a));
+          if (it != _edges.end())
+            SplitTriangle(it->second, b, a, v);
+          return;
+        }
+        best = static_cast<int>(i);
+        break;
+      }
+
+      // the point was rounded off the facet, use the nearest triangle
+      double dist = std::numeric_limits<double>::max();
+      for (int j = 0; j < 3; j++) {
+        Base::Vector2d e = _uv[t[(j + 1) % 3]] - _uv[t[j]];
+        Base::Vector2d d = p - _uv[t[j]];
+        double len = e.Length();
+        if (len > 0.0)
+          dist = std::min(dist, (e.x * d.y - e.y * d.x) / len);
+      }
+      if (dist > bestDist) {
+        bestDist = dist;
+        best = static_cast<int>(i);
+      }
+    }
+
+    std::array<int, 3> t = _triangles[best];
+    SetTriangle(best, t[0], t[1], v);
+    AddTriangle(t[1], t[2], v);
+    AddTriangle(t[2], t[0], v);
+  }
+
+  bool Crosses (int u, int v, int x, int y) const
+  {
+    const Base::Vector2d& pu = _uv[u];
+    const Base::Vector2d& pv = _uv[v];
+    const Base::Vector2d& px = _uv[x];
+    const Base::Vector2d& py = _uv[y];
+    return Orient2d(pu, pv, px) * Orient2d(pu, pv, py) < 0 &&
+           Orient2d(px, py, pu) * Orient2d(px, py, pv) < 0;
+  }
+
+  bool HasEdge (int u, int v) const
+  {
+    return _edges.find(std::make_pair(u, v)) != _edges.end() ||
+           _edges.find(std::make_pair(v, u)) != _edges.end();
+  }
+
+  bool Recover (int u, int v, int depth)
+  {
+    if (u == v)
+      return true;
+    if (HasEdge(u, v)) {
+      _fixed.insert(std::make_pair(std::min(u, v), std::max(u, v)));
+      return true;
+    }
+    if (depth > 8)
+      return false;
+
+    // a vertex on the segment splits it into two
+    const Base::Vector2d& pu = _uv[u];
+    const Base::Vector2d& pv = _uv[v];
+    for (int w = 0; w < static_cast<int>(_uv.size()); w++) {
+      if (w == u || w == v || Orient2d(pu, pv, _uv[w]) != 0)
+        continue;
+      const Base::Vector2d& pw = _uv[w];
+      if ((pw - pu) * (pv - pu) > 0.0 && (pw - pv) * (pu - pv) > 0.0)
+        return Recover(u, w, depth + 1) && Recover(w, v, depth + 1);
+    }
+
+    std::deque<std::pair<int, int> > crossing;
+    for (std::map<std::pair<int, int>, int>::iterator it = _edges.begin(); it != _edges.end(); ++it) {
+      int x = it->first.first, y = it->first.second;
+      if (x < y && x != u && x != v && y != u && y != v && Crosses(u, v, x, y)) {
+        if (_edges.find(std::make_pair(y, x)) == _edges.end())
+          return false; // boundary edge
+        crossing.push_back(std::make_pair(x, y));
+      }
+    }
+
+    std::size_t limit = 16 * (crossing.size() + 1) * (crossing.size() + 1) + 64;
+    while (!crossing.empty()) {
+      if (limit-- == 0)
+        return false;
+      std::pair<int, int> e = crossing.front();
+      crossing.pop_front();
+      int x = e.first, y = e.second;
+      if (_fixed.find(std::make_pair(std::min(x, y), std::max(x, y))) != _fixed.end())
+        return false;
+      std::map<std::pair<int, int>, int>::iterator it1 = _edges.find(std::make_pair(x, y));
+      std::map<std::pair<int, int>, int>::iterator it2 = _edges.find(std::make_pair(y, x));
+      if (it1 == _edges.end() || it2 == _edges.end())
+        return false;
+      int t1 = it1->second, t2 = it2->second;
+      int a = Opposite(t1, x, y), b = Opposite(t2, y, x);
+      // the quadrilateral x, b, y, a must be strictly convex
+      if (Orient2d(_uv[a], _uv[b], _uv[x]) * Orient2d(_uv[a], _uv[b], _uv[y]) < 0) {
+        SetTriangle(t1, x, b, a);
+        SetTriangle(t2, b, y, a);
+        if (a != u && a != v && b != u && b != v && Crosses(u, v, a, b))
+          crossing.push_back(std::make_pair(a, b));
+      }
+      else {
+        crossing.push_back(e);
+      }
+    }
+
+    if (!HasEdge(u, v))
+      return false;
+    _fixed.insert(std::make_pair(std::min(u, v), std::max(u, v)));
+    return true;
+  }
+
+  Base::Vector3d _corners[3];
+  unsigned short _axis;
+  bool _mirror;
+  std::vector<SplitPoint> _edgePoints[3];
+  std::vector<std::pair<unsigned long, Base::Vector3d> > _innerPoints;
+  std::vector<std::pair<unsigned long, unsigned long> > _constraints;
+  std::vector<Base::Vector2d> _uv;
+  std::vector<unsigned long> _ids;
+  std::map<unsigned long, int> _local;
+  std::vector<std::array<int, 3> > _triangles;
+  std::map<std::pair<int, int>, int> _edges;
+  std::set<std::pair<int, int> > _fixed;
+};
+
+/*
+ * Facets of a mesh sorted into a regular grid over the yz plane by their
+ * bounding boxes, to find the facets a ray in x direction may hit.
+ */
+class RayGrid
+{
+public:
+  void Build (const std::vector<Base::BoundBox3f>& boxes, const Base::BoundBox3f& bbox)
+  {
+    unsigned long count = boxes.size();
+    _size = static_cast<unsigned long>(std::sqrt(static_cast<double>(count) / 4.0));
+    _size = std::max<unsigned long>(1, std::min<unsigned long>(_size, 1024));
+    _minY = bbox.MinY;
+    _minZ = bbox.MinZ;
+    _lenY = std::max<double>(bbox.LengthY(), std::numeric_limits<float>::min()) / _size;
+    _lenZ = std::max<double>(bbox.LengthZ(), std::numeric_limits<float>::min()) / _size;
+
+    // count the facets per cell first and fill the cells then
+    _offsets.assign(_size * _size + 1, 0);
+    for (int pass = 0; pass < 2; pass++) {
+      std::vector<unsigned long> cursor(_offsets.begin(), _offsets.end() - 1);
+      for (unsigned long i = 0; i < count; i++) {
+        unsigned long y0 = Index(boxes[i].MinY, _minY, _lenY), y1 = Index(boxes[i].MaxY, _minY, _lenY);
+        unsigned long z0 = Index(boxes[i].MinZ, _minZ, _lenZ), z1 = Index(boxes[i].MaxZ, _minZ, _lenZ);
+        for (unsigned long y = y0; y <= y1; y++) {
+          for (unsigned long z = z0; z <= z1; z++) {
+            if (pass == 0)
+              _offsets[y * _size + z + 1]++;
+            else
+              _indices[cursor[y * _size + z]++] = i;
+          }
+        }
+      }
+      if (pass == 0) {
+        for (unsigned long c = 0; c < _size * _size; c++)
+          _offsets[c + 1] += _offsets[c];
+        _indices.resize(_offsets.back());
+      }
+    }
+  }
+
+  /// The facets whose bounding boxes may contain (y, z)
+  void Cell (double y, double z, const unsigned long*& begin, const unsigned long*& end) const
+  {
+    unsigned long c = Index(y, _minY, _lenY) * _size + Index(z, _minZ, _lenZ);
+    begin = _indices.data() + _offsets[c];
+    end = _indices.data() + _offsets[c + 1];
+  }
+
+private:
+  unsigned long Index (double value, double min, double len) const
+  {
+    double index = std::floor((value - min) / len);
+    if (index < 0.0)
+      return 0;
+    return std::min<unsigned long>(static_cast<unsigned long>(std::min(index, 1.0e9)), _size - 1);
+  }
+
+  unsigned long _size;
+  double _minY, _minZ, _lenY, _lenZ;
+  std::vector<unsigned long> _offsets;
+  std::vector<unsigned long> _indices;
+};
+
+/*
+ * Boolean operation of two closed meshes. The facets of both meshes are sorted
+ * into a regular grid over their common bounding box and the facet pairs of
+ * the cells are tested concurrently with exact predicates. Every crossing of an edge of one mesh with a facet of
+ * the other one becomes a point of the intersection curve, identified by the
+ * edge and the facet, so the facets sharing the edge get the very same point.
+ * The cut facets are split along the curve concurrently and the facets of each
+ * mesh are grouped into patches bounded by the curve. Every patch is classified
+ * as inside or outside the other mesh by the parity of a ray.
+ */
+class MeshBoolean
+{
+public:
+  enum Keep { None, Outside, Inside };
+
+  MeshBoolean (const MeshKernel& mesh0, const MeshKernel& mesh1, int threads)
+    : _threads(threads), _degenerate(0), _unresolved(0)
+  {
+    _mesh[0] = &mesh0;
+    _mesh[1] = &mesh1;
+    _offset[0] = 0;
+    for (int s = 0; s < 2; s++) {
+      const MeshPointArray& rPoints = _mesh[s]->GetPoints();
+      const MeshFacetArray& rFacets = _mesh[s]->GetFacets();
+      std::vector<Base::Vector3d>& points = _points[s];
+      std::vector<Base::BoundBox3f>& boxes = _boxes[s];
+      points.resize(rPoints.size());
+      boxes.resize(rFacets.size());
+      parallel_for(0, rPoints.size(), [&](unsigned long first, unsigned long last) {
+        for (unsigned long i = first; i < last; i++)
+          points[i] = Base::Vector3d(rPoints[i].x, rPoints[i].y, rPoints[i].z);
+      }, _threads);
+      parallel_for(0, rFacets.size(), [&](unsigned long first, unsigned long last) {
+        for (unsigned long i = first; i < last; i++) {
+          for (int j = 0; j < 3; j++)
+            boxes[i].Add(rPoints[rFacets[i]._aulPoints[j]]);
+        }
+      }, _threads);
+      for (MeshPointArray::_TConstIterator it = rPoints.begin(); it != rPoints.end(); ++it)
+        _bbox[s].Add(*it);
+      _offset[s + 1] = _offset[s] + rPoints.size();
+    }
+  }
+
+  /// Computes the intersection curve and splits the facets along it
+  void Cut ()
+  {
+    FindSegments();
+    AddCutPoints();
+    for (int s = 0; s < 2; s++)
+      SplitFacets(s);
+  }
+
+  /// Classifies the facets of both meshes as inside or outside the other one
+  void Classify ()
+  {
+    for (int s = 0; s < 2; s++)
+      ClassifyFacets(s);
+  }
+
+  void Assemble (MeshKernel& result, Keep keep0, bool flip0, Keep keep1, bool flip1) const
+  {
+    Keep keep[2] = { keep0, keep1 };
+    bool flip[2] = { flip0, flip1 };
+    std::vector<Triangle> triangles;
+    for (int s = 0; s < 2; s++) {
+      if (keep[s] == None)
+        continue;
+      const std::vector<Triangle>& parts = _parts[s];
+      for (std::size_t i = 0; i < parts.size(); i++) {
+        if ((_inside[s][i] != 0) != (keep[s] == Inside))
+          continue;
+        Triangle t = parts[i];
+        if (t.v[0] == t.v[1] || t.v[1] == t.v[2] || t.v[2] == t.v[0])
+          continue;
+        if (flip[s])
+          std::swap(t.v[1], t.v[2]);
+        // rotate the lowest index to the front to compare the facets
+        while (t.v[0] > t.v[1] || t.v[0] > t.v[2])
+          std::rotate(t.v, t.v + 1, t.v + 3);
+        triangles.push_back(t);
+      }
+    }
+
+    // coincident facets of opposite orientation cancel each other out
+    std::vector<unsigned long> order(triangles.size());
+    for (std::size_t i = 0; i < order.size(); i++)
+      order[i] = i;
+    auto key = [&triangles](unsigned long i) {
+      const unsigned long* v = triangles[i].v;
+      return std::make_tuple(v[0], std::min(v[1], v[2]), std::max(v[1], v[2]));
+    };
+    parallel_sort(order.begin(), order.end(), [&key](unsigned long a, unsigned long b) {
+      return key(a) < key(b) || (key(a) == key(b) && a < b);
+    }, _threads);
+    std::vector<char> removed(triangles.size(), 0);
+    for (std::size_t i = 0; i + 1 < order.size(); i++) {
+      unsigned long a = order[i], b = order[i + 1];
+      if (!removed[a] && key(a) == key(b) && triangles[a].v[1] == triangles[b].v[2]) {
+        removed[a] = 1;
+        removed[b] = 1;
+        i++;
+      }
+    }
+
+    std::vector<unsigned long> remap(_offset[2] + _cutPoints.size(), ULONG_MAX);
+    MeshPointArray points;
+    MeshFacetArray facets;
+    for (std::size_t i = 0; i < triangles.size(); i++) {
+      if (removed[i])
+        continue;
+      unsigned long index[3];
+      for (int j = 0; j < 3; j++) {
+        unsigned long id = triangles[i].v[j];
+        if (remap[id] == ULONG_MAX) {
+          const Base::Vector3d& p = Point(id);
+          remap[id] = points.size();
+          points.push_back(MeshPoint(Base::Vector3f(static_cast<float>(p.x),
+                                                    static_cast<float>(p.y),
+                                                    static_cast<float>(p.z))));
+        }
+        index[j] = remap[id];
+      }
+      facets.push_back(MeshFacet(index[0], index[1], index[2]));
+    }
+    result.Adopt(points, facets, true);
+  }
+
+  /// Number of facet pairs and segments that could not be resolved
+  unsigned long CountUnresolved () const
+  {
+    return _degenerate + _unresolved;
+  }
+
+private:
+  const Base::Vector3d& Point (unsigned long id) const
+  {
+    if (id < _offset[1])
+      return _points[0][id];
+    if (id < _offset[2])
+      return _points[1][id - _offset[1]];
+    return _cutPoints[id - _offset[2]];
+  }
+
+  void GetTriangle (int side, unsigned long facet, Base::Vector3d* t) const
+  {
+    const MeshFacet& f = _mesh[side]->GetFacets()[facet];
+    for (int i = 0; i < 3; i++)
+      t[i] = _points[side][f._aulPoints[i]];
+  }
+
+  unsigned long PointId (const CutKey& key) const
+  {
+    return _offset[2] + (std::lower_bound(_keys.begin(), _keys.end(), key) - _keys.begin());
+  }
+
+  // -------------------------------------------------------------------------
+
+  void FindSegments ()
+  {
+    // only facets inside the common bounding box can intersect
+    Base::BoundBox3f common = _bbox[0].Intersected(_bbox[1]);
+    if (!common.IsValid())
+      return;
+
+    std::vector<unsigned long> candidates[2];
+    for (int s = 0; s < 2; s++) {
+      for (unsigned long i = 0; i < _boxes[s].size(); i++) {
+        if (_boxes[s][i] && common)
+          candidates[s].push_back(i);
+      }
+    }
+    if (candidates[0].empty() || candidates[1].empty())
+      return;
+
+    // regular grid with a few facets per cell
+    double len[3] = { common.LengthX(), common.LengthY(), common.LengthZ() };
+    double maxLen = std::max(len[0], std::max(len[1], len[2]));
+    double target = std::max(1.0, static_cast<double>(candidates[0].size() + candidates[1].size()) / 4.0);
+    double volume = 1.0;
+    for (int i = 0; i < 3; i++)
+      volume *= std::max(len[i], maxLen * 1.0e-3);
+    double size = std::cbrt(volume / target);
+    _gridMin = Base::Vector3d(common.MinX, common.MinY, common.MinZ);
+    for (int i = 0; i < 3; i++) {
+      _gridCount[i] = static_cast<unsigned long>(std::ceil(len[i] / std::max(size, std::numeric_limits<double>::min())));
+      _gridCount[i] = std::max<unsigned long>(1, std::min<unsigned long>(_gridCount[i], 1024));
+      _gridSize[i] = len[i] > 0.0 ? len[i] / _gridCount[i] : 1.0;
+    }
+
+    unsigned long numCells = _gridCount[0] * _gridCount[1] * _gridCount[2];
+    for (int s = 0; s < 2; s++) {
+      // count the facets per cell first and fill the cells then
+      std::vector<unsigned long>& offsets = _cellOffsets[s];
+      std::vector<unsigned long>& indices = _cellFacets[s];
+      offsets.assign(numCells + 1, 0);
+      for (int pass = 0; pass < 2; pass++) {
+        std::vector<unsigned long> cursor(offsets.begin(), offsets.end() - 1);
+        for (std::vector<unsigned long>::iterator it = candidates[s].begin(); it != candidates[s].end(); ++it) {
+          unsigned long lo[3], hi[3];
+          CellRange(_boxes[s][*it], lo, hi);
+          for (unsigned long x = lo[0]; x <= hi[0]; x++) {
+            for (unsigned long y = lo[1]; y <= hi[1]; y++) {
+              for (unsigned long z = lo[2]; z <= hi[2]; z++) {
+                unsigned long cell = (x * _gridCount[1] + y) * _gridCount[2] + z;
+                if (pass == 0)
+                  offsets[cell + 1]++;
+                else
+                  indices[cursor[cell]++] = *it;
+              }
+            }
+          }
+        }
+        if (pass == 0) {
+          for (unsigned long c = 0; c < numCells; c++)
+            offsets[c + 1] += offsets[c];
+          indices.resize(offsets.back());
+        }
+      }
+    }
+
+    // use many more chunks than threads because their costs vary a lot
+    unsigned long numChunks = std::max<unsigned long>(1, std::min<unsigned long>(numCells / 64, 1024));
+    std::vector<std::pair<unsigned long, unsigned long> > chunks;
+    for (unsigned long i = 0; i < numChunks; i++)
+      chunks.push_back(std::make_pair(numCells * i / numChunks, numCells * (i + 1) / numChunks));
+
+    QFuture< std::vector<CutSegment> > future = QtConcurrent::mapped(chunks, CellTest(this));
+    Base::SequencerLauncher seq("Intersecting meshes...", numChunks);
+    try {
+      for (unsigned long i = 0; i < numChunks; i++) {
+        const std::vector<CutSegment>& result = future.resultAt(i);
+        _segments.insert(_segments.end(), result.begin(), result.end());
+        seq.next(true);
+      }
+    }
+    catch (...) {
+      future.cancel();
+      future.waitForFinished();
+      throw;
+    }
+    future.waitForFinished();
+  }
+
+  unsigned long CellIndex (double value, int axis) const
+  {
+    double index = std::floor((value - _gridMin[axis]) / _gridSize[axis]);
+    if (index < 0.0)
+      return 0;
+    return std::min<unsigned long>(static_cast<unsigned long>(std::min(index, 1.0e9)), _gridCount[axis] - 1);
+  }
+
+  void CellRange (const Base::BoundBox3f& box, unsigned long* lo, unsigned long* hi) const
+  {
+    lo[0] = CellIndex(box.MinX, 0); hi[0] = CellIndex(box.MaxX, 0);
+    lo[1] = CellIndex(box.MinY, 1); hi[1] = CellIndex(box.MaxY, 1);
+    lo[2] = CellIndex(box.MinZ, 2); hi[2] = CellIndex(box.MaxZ, 2);
+  }
+
+  /// Tests the facet pairs of the cells [first, last)
+  std::vector<CutSegment> Intersect (unsigned long first, unsigned long last) const
+  {
+    std::vector<CutSegment> segments;
+    for (unsigned long cell = first; cell < last; cell++) {
+      for (unsigned long i = _cellOffsets[0][cell]; i < _cellOffsets[0][cell + 1]; i++) {
+        unsigned long index0 = _cellFacets[0][i];
+        const Base::BoundBox3f& box0 = _boxes[0][index0];
+        for (unsigned long j = _cellOffsets[1][cell]; j < _cellOffsets[1][cell + 1]; j++) {
+          unsigned long index1 = _cellFacets[1][j];
+          const Base::BoundBox3f& box1 = _boxes[1][index1];
+          if (!(box0 && box1))
+            continue;
+          // a pair sharing several cells is only tested in the cell of the lower corner of the common box
+          unsigned long x = CellIndex(std::max(box0.MinX, box1.MinX), 0);
+          unsigned long y = CellIndex(std::max(box0.MinY, box1.MinY), 1);
+          unsigned long z = CellIndex(std::max(box0.MinZ, box1.MinZ), 2);
+          if ((x * _gridCount[1] + y) * _gridCount[2] + z != cell)
+            continue;
+          IntersectFacets(index0, index1, segments);
+        }
+      }
+    }
+    return segments;
+  }
+
+  struct CellTest
+  {
+    typedef std::vector<CutSegment> result_type;
+    CellTest (const MeshBoolean* engine) : engine(engine) {}
+    result_type operator() (const std::pair<unsigned long, unsigned long>& chunk) const
+    {
+      return engine->Intersect(chunk.first, chunk.second);
+    }
+    const MeshBoolean* engine;
+  };
+
+  void IntersectFacets (unsigned long index0, unsigned long index1, std::vector<CutSegment>& segments) const
+  {
+    const MeshFacet& facet0 = _mesh[0]->GetFacets()[index0];
+    const MeshFacet& facet1 = _mesh[1]->GetFacets()[index1];
+    Base::Vector3d t0[3], t1[3];
+    GetTriangle(0, index0, t0);
+    GetTriangle(1, index1, t1);
+
+    int s0[3], s1[3];
+    for (int i = 0; i < 3; i++) {
+      s0[i] = PlaneSide(t1, t0[i], 0);
+      if (s0[i] == 0)
+        return; // degenerate facet
+    }
+    if (s0[0] == s0[1] && s0[1] == s0[2])
+      return;
+    for (int i = 0; i < 3; i++) {
+      s1[i] = PlaneSide(t0, t1[i], 1);
+      if (s1[i] == 0)
+        return;
+    }
+    if (s1[0] == s1[1] && s1[1] == s1[2])
+      return;
+
+    // in general position the two facets intersect in a segment between two edge crossings
+    CutSegment segment;
+    int count = 0;
+    for (int i = 0; i < 3; i++) {
+      int j = (i + 1) % 3;
+      if (s0[i] != s0[j] && SegmentCrossesTriangle(t0[i], t0[j], 0, t1)) {
+        if (count < 2)
+          segment.key[count] = CutKey(0, facet0._aulPoints[i], facet0._aulPoints[j], index1);
+        count++;
+      }
+      if (s1[i] != s1[j] && SegmentCrossesTriangle(t1[i], t1[j], 1, t0)) {
+        if (count < 2)
+          segment.key[count] = CutKey(1, facet1._aulPoints[i], facet1._aulPoints[j], index0);
+        count++;
+      }
+    }
+
+    if (count == 2) {
+      segment.facet[0] = index0;
+      segment.facet[1] = index1;
+      segments.push_back(segment);
+    }
+    else if (count != 0) {
+      _degenerate++;
+    }
+  }
+
+  void AddCutPoints ()
+  {
+    _keys.reserve(2 * _segments.size());
+    for (std::vector<CutSegment>::iterator it = _segments.begin(); it != _segments.end(); ++it) {
+      _keys.push_back(it->key[0]);
+      _keys.push_back(it->key[1]);
+    }
+    parallel_sort(_keys.begin(), _keys.end(), std::less<CutKey>(), _threads);
+    _keys.erase(std::unique(_keys.begin(), _keys.end()), _keys.end());
+
+    // the point only depends on the edge and the facet
+    _cutPoints.resize(_keys.size());
+    parallel_for(0, _keys.size(), [this](unsigned long first, unsigned long last) {
+      for (unsigned long i = first; i < last; i++) {
+        const CutKey& key = _keys[i];
+        const Base::Vector3d& p = _points[key.side][key.p0];
+        const Base::Vector3d& q = _points[key.side][key.p1];
+        Base::Vector3d t[3];
+        GetTriangle(1 - key.side, key.facet, t);
+        Base::Vector3d n = (t[1] - t[0]) % (t[2] - t[0]);
+        double d0 = n * (p - t[0]);
+        double d1 = n * (q - t[0]);
+        double s = d0 != d1 ? d0 / (d0 - d1) : 0.5;
+        s = std::max(0.0, std::min(1.0, s));
+        _cutPoints[i] = p + (q - p) * s;
+      }
+    }, _threads);
+
+    // the points of both meshes and the cut points at the same position are merged
+    _canonical = parallel_group(_offset[2] + _cutPoints.size(), [this](unsigned long a, unsigned long b) {
+      const Base::Vector3d& p = Point(a);
+      const Base::Vector3d& q = Point(b);
+      if (p.x != q.x) return p.x < q.x;
+      if (p.y != q.y) return p.y < q.y;
+      return p.z < q.z;
+    }, _threads);
+
+    // the intersection curve separates the patches of facets
+    _curve.reserve(_segments.size());
+    for (std::vector<CutSegment>::iterator it = _segments.begin(); it != _segments.end(); ++it) {
+      unsigned long id0 = _canonical[PointId(it->key[0])];
+      unsigned long id1 = _canonical[PointId(it->key[1])];
+      if (id0 != id1)
+        _curve.push_back(std::make_pair(std::min(id0, id1), std::max(id0, id1)));
+    }
+    parallel_sort(_curve.begin(), _curve.end(), std::less<std::pair<unsigned long, unsigned long> >(), _threads);
+    _curve.erase(std::unique(_curve.begin(), _curve.end()), _curve.end());
+  }
+
+  void SplitFacets (int side)
+  {
+    const MeshFacetArray& rFacets = _mesh[side]->GetFacets();
+
+    // segments grouped by the facet of this mesh
+    std::vector<std::pair<unsigned long, unsigned long> > owner;
+    owner.reserve(_segments.size());
+    for (std::size_t i = 0; i < _segments.size(); i++)
+      owner.push_back(std::make_pair(_segments[i].facet[side], i));
+    parallel_sort(owner.begin(), owner.end(), std::less<std::pair<unsigned long, unsigned long> >(), _threads);
+
+    std::vector<std::size_t> groups;
+    for (std::size_t i = 0; i < owner.size(); i++) {
+      if (i == 0 || owner[i].first != owner[i - 1].first)
+        groups.push_back(i);
+    }
+    groups.push_back(owner.size());
+
+    // a point inside a facet may lie exactly on one of its edges, then the
+    // neighbour facet must be split at this point, too
+    std::vector< std::vector<EdgePoint> > onEdge(groups.size() - 1);
+    parallel_for(0, onEdge.size(), [&](unsigned long first, unsigned long last) {
+      for (unsigned long g = first; g < last; g++)
+        FindEdgePoints(side, owner, groups[g], groups[g + 1], onEdge[g]);
+    }, _threads, 16);
+    std::vector<EdgePoint>& edgePoints = _edgePoints[side];
+    for (std::size_t g = 0; g < onEdge.size(); g++)
+      edgePoints.insert(edgePoints.end(), onEdge[g].begin(), onEdge[g].end());
+    std::sort(edgePoints.begin(), edgePoints.end());
+    edgePoints.erase(std::unique(edgePoints.begin(), edgePoints.end()), edgePoints.end());
+
+    std::vector<char> cut(rFacets.size(), 0);
+    for (std::size_t g = 0; g + 1 < groups.size(); g++)
+      cut[owner[groups[g]].first] = 1;
+    if (!edgePoints.empty()) {
+      parallel_for(0, rFacets.size(), [&](unsigned long first, unsigned long last) {
+        for (unsigned long i = first; i < last; i++) {
+          for (int j = 0; j < 3 && !cut[i]; j++) {
+            EdgePoint key = MakeEdgePoint(side, rFacets[i], j, 0);
+            std::vector<EdgePoint>::const_iterator it = std::lower_bound(edgePoints.begin(), edgePoints.end(), key);
+            if (it != edgePoints.end() && it->p0 == key.p0 && it->p1 == key.p1)
+              cut[i] = 1;
+          }
+        }
+      }, _threads);
+    }
+
+    std::vector<unsigned long> cutFacets;
+    for (unsigned long i = 0; i < rFacets.size(); i++) {
+      if (cut[i])
+        cutFacets.push_back(i);
+    }
+
+    std::vector< std::vector<Triangle> > pieces(cutFacets.size());
+    parallel_for(0, cutFacets.size(), [&](unsigned long first, unsigned long last) {
+      for (unsigned long i = first; i < last; i++) {
+        std::pair<unsigned long, unsigned long> lower(cutFacets[i], 0), upper(cutFacets[i], ULONG_MAX);
+        std::size_t begin = std::lower_bound(owner.begin(), owner.end(), lower) - owner.begin();
+        std::size_t end = std::upper_bound(owner.begin(), owner.end(), upper) - owner.begin();
+        SplitFacet(side, cutFacets[i], owner, begin, end, pieces[i]);
+      }
+    }, _threads, 16);
+
+    std::vector<Triangle>& parts = _parts[side];
+    for (unsigned long i = 0; i < rFacets.size(); i++) {
+      if (cut[i])
+        continue;
+      Triangle t;
+      for (int j = 0; j < 3; j++)
+        t.v[j] = _canonical[_offset[side] + rFacets[i]._aulPoints[j]];
+      parts.push_back(t);
+    }
+    for (std::size_t g = 0; g < pieces.size(); g++)
+      parts.insert(parts.end(), pieces[g].begin(), pieces[g].end());
+  }
+
+  /// The canonical corner ids of the facet and a point id on its edge j
+  EdgePoint MakeEdgePoint (int side, const MeshFacet& facet, int j, unsigned long id) const
+  {
+    unsigned long p0 = _canonical[_offset[side] + facet._aulPoints[j]];
+    unsigned long p1 = _canonical[_offset[side] + facet._aulPoints[(j + 1) % 3]];
+    EdgePoint e;
+    e.p0 = std::min(p0, p1);
+    e.p1 = std::max(p0, p1);
+    e.id = id;
+    return e;
+  }
+
+  bool GetCorners (int side, unsigned long index, Base::Vector3d* corners, unsigned long* ids) const
+  {
+    const MeshFacet& facet = _mesh[side]->GetFacets()[index];
+    GetTriangle(side, index, corners);
+    for (int i = 0; i < 3; i++)
+      ids[i] = _canonical[_offset[side] + facet._aulPoints[i]];
+    return ids[0] != ids[1] && ids[1] != ids[2] && ids[2] != ids[0];
+  }
+
+  void FindEdgePoints (int side, const std::vector<std::pair<unsigned long, unsigned long> >& owner,
+                       std::size_t first, std::size_t last, std::vector<EdgePoint>& edgePoints) const
+  {
+    unsigned long index = owner[first].first;
+    Base::Vector3d corners[3];
+    unsigned long ids[3];
+    if (!GetCorners(side, index, corners, ids))
+      return;
+
+    const MeshFacet& facet = _mesh[side]->GetFacets()[index];
+    FacetSplitter splitter(corners, ids);
+    for (std::size_t i = first; i < last; i++) {
+      const CutSegment& segment = _segments[owner[i].second];
+      for (int k = 0; k < 2; k++) {
+        if (segment.key[k].side == side)
+          continue;
+        unsigned long id = _canonical[PointId(segment.key[k])];
+        int edge = splitter.FindEdge(Point(id));
+        if (edge >= 0 && id != ids[edge] && id != ids[(edge + 1) % 3])
+          edgePoints.push_back(MakeEdgePoint(side, facet, edge, id));
+      }
+    }
+  }
+
+  void SplitFacet (int side, unsigned long index, const std::vector<std::pair<unsigned long, unsigned long> >& owner,
+                   std::size_t first, std::size_t last, std::vector<Triangle>& triangles) const
+  {
+    const MeshFacet& facet = _mesh[side]->GetFacets()[index];
+    Base::Vector3d corners[3];
+    unsigned long ids[3];
+    if (!GetCorners(side, index, corners, ids)) {
+      // degenerate facet, it is removed from the result
+      Triangle t;
+      for (int j = 0; j < 3; j++)
+        t.v[j] = ids[j];
+      triangles.push_back(t);
+      return;
+    }
+
+    FacetSplitter splitter(corners, ids);
+    for (std::size_t i = first; i < last; i++) {
+      const CutSegment& segment = _segments[owner[i].second];
+      unsigned long id[2];
+      for (int k = 0; k < 2; k++) {
+        const CutKey& key = segment.key[k];
+        id[k] = _canonical[PointId(key)];
+        const Base::Vector3d& pt = Point(id[k]);
+        if (key.side == side) {
+          // the edge of the facet crosses the other mesh
+          for (int j = 0; j < 3; j++) {
+            unsigned long p0 = facet._aulPoints[j], p1 = facet._aulPoints[(j + 1) % 3];
+            if (std::min(p0, p1) == key.p0 && std::max(p0, p1) == key.p1)
+              splitter.AddEdgePoint(j, id[k], pt);
+          }
+        }
+        else {
+          splitter.AddInnerPoint(id[k], pt);
+        }
+      }
+      splitter.AddConstraint(id[0], id[1]);
+    }
+
+    // points of the neighbour facets on the edges
+    const std::vector<EdgePoint>& edgePoints = _edgePoints[side];
+    for (int j = 0; j < 3; j++) {
+      EdgePoint key = MakeEdgePoint(side, facet, j, 0);
+      for (std::vector<EdgePoint>::const_iterator it = std::lower_bound(edgePoints.begin(), edgePoints.end(), key);
+           it != edgePoints.end() && it->p0 == key.p0 && it->p1 == key.p1; ++it)
+        splitter.AddEdgePoint(j, it->id, Point(it->id));
+    }
+
+    if (!splitter.Compute())
+      _unresolved++;
+    splitter.GetTriangles(triangles);
+  }
+
+  // -------------------------------------------------------------------------
+
+  bool IsCurve (unsigned long p0, unsigned long p1) const
+  {
+    return std::binary_search(_curve.begin(), _curve.end(), std::make_pair(p0, p1));
+  }
+
+  void ClassifyFacets (int side)
+  {
+    const std::vector<Triangle>& parts = _parts[side];
+    unsigned long count = parts.size();
+
+    // facets sharing an edge that is not part of the intersection curve belong to the same patch
+    struct EdgeRef
+    {
+      unsigned long p0, p1, facet;
+      bool operator < (const EdgeRef& e) const
+      {
+        if (p0 != e.p0) return p0 < e.p0;
+        if (p1 != e.p1) return p1 < e.p1;
+        return facet < e.facet;
+      }
+    };
+    std::vector<EdgeRef> edges(3 * count);
+    parallel_for(0, count, [&](unsigned long first, unsigned long last) {
+      for (unsigned long i = first; i < last; i++) {
+        for (int j = 0; j < 3; j++) {
+          EdgeRef& e = edges[3 * i + j];
+          e.p0 = std::min(parts[i].v[j], parts[i].v[(j + 1) % 3]);
+          e.p1 = std::max(parts[i].v[j], parts[i].v[(j + 1) % 3]);
+          e.facet = i;
+        }
+      }
+    }, _threads);
+    parallel_sort(edges.begin(), edges.end(), std::less<EdgeRef>(), _threads);
+
+    std::vector<unsigned long> parent(count);
+    for (unsigned long i = 0; i < count; i++)
+      parent[i] = i;
+    auto find = [&parent](unsigned long i) {
+      while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+      }
+      return i;
+    };
+    for (std::size_t i = 0; i < edges.size(); ) {
+      std::size_t j = i + 1;
+      while (j < edges.size() && edges[j].p0 == edges[i].p0 && edges[j].p1 == edges[i].p1)
+        j++;
+      if (j - i > 1 && !IsCurve(edges[i].p0, edges[i].p1)) {
+        unsigned long root = find(edges[i].facet);
+        for (std::size_t k = i + 1; k < j; k++) {
+          unsigned long other = find(edges[k].facet);
+          if (other != root)
+            parent[other] = root;
+        }
+      }
+      i = j;
+    }
+
+    // the largest facet of each patch is tested
+    std::vector<double> area(count);
+    parallel_for(0, count, [&](unsigned long first, unsigned long last) {
+      for (unsigned long i = first; i < last; i++) {
+        const Base::Vector3d& p0 = Point(parts[i].v[0]);
+        area[i] = ((Point(parts[i].v[1]) - p0) % (Point(parts[i].v[2]) - p0)).Sqr();
+      }
+    }, _threads);
+
+    std::vector<unsigned long> patch(count, ULONG_MAX);
+    std::vector<unsigned long> representative;
+    for (unsigned long i = 0; i < count; i++) {
+      unsigned long root = find(i);
+      if (patch[root] == ULONG_MAX) {
+        patch[root] = representative.size();
+        representative.push_back(i);
+      }
+      patch[i] = patch[root];
+      if (area[i] > area[representative[patch[i]]])
+        representative[patch[i]] = i;
+    }
+
+    RayGrid grid;
+    grid.Build(_boxes[1 - side], _bbox[1 - side]);
+    std::vector<char> inside(representative.size());
+    parallel_for(0, representative.size(), [&](unsigned long first, unsigned long last) {
+      for (unsigned long i = first; i < last; i++) {
+        const Triangle& t = parts[representative[i]];
+        Base::Vector3d center = (Point(t.v[0]) + Point(t.v[1]) + Point(t.v[2])) / 3.0;
+        inside[i] = IsInside(center, side, grid) ? 1 : 0;
+      }
+    }, _threads, 1);
+
+    _inside[side].resize(count);
+    for (unsigned long i = 0; i < count; i++)
+      _inside[side][i] = inside[patch[i]];
+  }
+
+  /// Checks by the parity of a ray in x direction whether the point of mesh side lies inside the other mesh
+  bool IsInside (const Base::Vector3d& center, int side, const RayGrid& grid) const
+  {
+    int other = 1 - side;
+    const Base::BoundBox3f& bbox = _bbox[other];
+    if (!bbox.IsValid() || center.x > bbox.MaxX ||
+        center.y < bbox.MinY || center.y > bbox.MaxY ||
+        center.z < bbox.MinZ || center.z > bbox.MaxZ)
+      return false;
+
+    Base::Vector3d end(static_cast<double>(bbox.MaxX) + 1.0 + std::fabs(bbox.MaxX), center.y, center.z);
+    const unsigned long *begin, *last;
+    grid.Cell(center.y, center.z, begin, last);
+    int crossings = 0;
+    for (const unsigned long* it = begin; it != last; ++it) {
+      const Base::BoundBox3f& box = _boxes[other][*it];
+      if (box.MaxX < center.x || box.MinY > center.y || box.MaxY < center.y ||
+          box.MinZ > center.z || box.MaxZ < center.z)
+        continue;
+      Base::Vector3d t[3];
+      GetTriangle(other, *it, t);
+      int s0 = PlaneSide(t, center, side);
+      int s1 = PlaneSide(t, end, side);
+      if (s0 == 0 || s1 == 0 || s0 == s1)
+        continue;
+      if (SegmentCrossesTriangle(center, end, side, t))
+        crossings++;
+    }
+    return (crossings % 2) == 1;
+  }
+
+  const MeshKernel* _mesh[2];
+  int _threads;
+  unsigned long _offset[3];
+  std::vector<Base::Vector3d> _points[2];
+  std::vector<Base::BoundBox3f> _boxes[2];
+  Base::BoundBox3f _bbox[2];
+  Base::Vector3d _gridMin;
+  double _gridSize[3];
+  unsigned long _gridCount[3];
+  std::vector<unsigned long> _cellOffsets[2];
+  std::vector<unsigned long> _cellFacets[2];
+  std::vector<CutSegment> _segments;
+  std::vector<CutKey> _keys;
+  std::vector<Base::Vector3d> _cutPoints;
+  std::vector<unsigned long> _canonical;
+  std::vector<std::pair<unsigned long, unsigned long> > _curve;
+  std::vector<EdgePoint> _edgePoints[2];
+  std::vector<Triangle> _parts[2];
+  std::vector<char> _inside[2];
+  mutable std::atomic<unsigned long> _degenerate;
+  mutable std::atomic<unsigned long> _unresolved;
+};
+
+}
+}
+
+void SetOperations::DoRobust ()
+{
+  MeshBoolean::Keep keep0 = MeshBoolean::None, keep1 = MeshBoolean::None;
+  bool flip1 = false;
+  switch (_operationType)
+  {
+    case Union:      keep0 = MeshBoolean::Outside; keep1 = MeshBoolean::Outside; break;
+    case Intersect:  keep0 = MeshBoolean::Inside;  keep1 = MeshBoolean::Inside;  break;
+    case Difference: keep0 = MeshBoolean::Outside; keep1 = MeshBoolean::Inside;  flip1 = true; break;
+    case Inner:      keep0 = MeshBoolean::Inside;  break;
+    case Outer:      keep0 = MeshBoolean::Outside; break;
+  }
+
+  int threads = std::max(1, QThread::idealThreadCount());
+  MeshBoolean engine(_cutMesh0, _cutMesh1, threads);
+  engine.Cut();
+  engine.Classify();
+  engine.Assemble(_resultMesh, keep0, false, keep1, flip1);
+
+  unsigned long unresolved = engine.CountUnresolved();
+  if (unresolved > 0) {
+    std::stringstream str;
+    str << unresolved << " parts of the intersection curve could not be resolved, the result is not closed";
+    throw Base::RuntimeError(str.str());
+  }
+}
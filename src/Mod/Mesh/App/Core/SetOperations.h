@@ -68,12 +68,23 @@ public:
    */
   void Do ();
 
+  /** Selects the robust algorithm for Do(). It computes the intersection curve with
+   * exact predicates and splits and classifies the facets concurrently. Degenerate
+   * contacts like coplanar facets are resolved as if the second mesh was moved by an
+   * infinitesimal amount. Both meshes must be closed and consistently oriented.
+   * If parts of the intersection curve cannot be resolved Do() throws a
+   * Base::RuntimeError instead of returning an open result.
+   */
+  void SetRobust (bool on) { _robust = on; }
+  bool IsRobust () const { return _robust; }
+
 protected:
   const MeshKernel   &_cutMesh0;             /** Mesh for set operations source 1 */
   const MeshKernel   &_cutMesh1;             /** Mesh for set operations source 2 */
   MeshKernel         &_resultMesh;           /** Result mesh */
   OperationType       _operationType;        /** Set Operation Type */
   float               _minDistanceToPoint;   /** Minimal distance to facet corner points */
+  bool                _robust;               /** Use exact predicates */
 
 private:
   // Helper class cutting edge to his two attached facets
@@ -178,6 +189,8 @@ private:
   void CollectFacets (int side, float mult);
   /** close gap in the mesh */
   void CloseGaps (MeshBuilder& meshBuilder);
+  /** robust set operation */
+  void DoRobust ();
 
   /** visual debugger */
   Base::Builder3D _builder;
@@ -9,7 +9,11 @@
 // * Comment out printf statements
 // * Fix compiler warnings
 // * Remove macros loop,i,j,k
+// * Add Vertex::locked to keep vertices from being moved or removed
+// * Add Vertex::id which is kept by compact_mesh()
+// * Add max_error to reject edge collapses with a higher quadric error
 
+#include <cfloat>
 #include <vector>
 #include <Base/Vector3D.h>
 
@@ -84,11 +88,14 @@ class Simplify
 {
 public:
     struct Triangle { int v[3];double err[4];int deleted,dirty;vec3f n; };
-    struct Vertex { vec3f p;int tstart,tcount;SymmetricMatrix q;int border;};
+    struct Vertex { vec3f p;int tstart,tcount;SymmetricMatrix q;int border;int locked;int id;};
     struct Ref { int tid,tvertex; }; 
     std::vector<Triangle> triangles;
     std::vector<Vertex> vertices;
     std::vector<Ref> refs;
+    double max_error;
+
+    Simplify() : max_error(DBL_MAX) {}
 
     void simplify_mesh(int target_count, double tolerance, double aggressiveness=7);
 
@@ -116,6 +123,9 @@ private:
 // the tolerance the algorithm will stop at this point. The number of the
 // remaining triangles usually will be higher than \a target_count
 //
+// Edges whose collapse causes a quadric error higher than max_error
+// are kept.
+//
 void Simplify::simplify_mesh(int target_count, double tolerance, double aggressiveness)
 {
     // init
@@ -198,9 +208,14 @@ void Simplify::simplify_mesh(int target_count, double tolerance, double aggressi
                     if (v0.border != v1.border)
                         continue;
 
+                    // Locked vertices are neither moved nor removed
+                    if (v0.locked || v1.locked)
+                        continue;
+
                     // Compute vertex to collapse to
                     vec3f p;
-                    calculate_error(i0,i1,p);
+                    if (calculate_error(i0,i1,p) > max_error)
+                        continue;
 
                     deleted0.resize(v0.tcount); // normals temporarily
                     deleted1.resize(v1.tcount); // normals temporarily
@@ -480,6 +495,7 @@ void Simplify::compact_mesh()
         {
             vertices[i].tstart=dst;
             vertices[dst].p=vertices[i].p;
+            vertices[dst].id=vertices[i].id;
             dst++;
         }
     }
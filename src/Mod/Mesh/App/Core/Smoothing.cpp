@@ -23,6 +23,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
 #endif
 
 #include "Smoothing.h"
@@ -31,6 +32,7 @@
 #include "Elements.h"
 #include "Iterator.h"
 #include "Approximation.h"
+#include "Functional.h"
 
 
 using namespace MeshCore;
@@ -179,95 +181,137 @@ LaplaceSmoothing::~LaplaceSmoothing()
 {
 }
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it, double stepsize)
+namespace MeshCore {
+
+/*
+ * The point coordinates of a Jacobi step. The coordinates are stored in
+ * separate arrays and all points are computed from the values of the
+ * previous step so that they can be processed concurrently.
+ */
+struct UmbrellaPoints
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_it,
-    v_beg = points.begin(), v_end = points.end();
-
-    unsigned long pos = 0;
-    for (v_it = points.begin(); v_it != v_end; ++v_it,++pos) {
-        const std::set<unsigned long>& cv = vv_it[pos];
-        if (cv.size() < 3)
-            continue;
-        if (cv.size() != vf_it[pos].size()) {
-            // do nothing for border points
-            continue;
+    UmbrellaPoints(const MeshPointArray& points)
+      : x(points.size()), y(points.size()), z(points.size())
+    {
+        for (std::size_t i = 0; i < points.size(); i++) {
+            x[i] = points[i].x;
+            y[i] = points[i].y;
+            z[i] = points[i].z;
         }
+    }
+    void swap(UmbrellaPoints& p)
+    {
+        x.swap(p.x);
+        y.swap(p.y);
+        z.swap(p.z);
+    }
 
-        size_t n_count = cv.size();
-        double w;
-        w=1.0/double(n_count);
+    std::vector<float> x, y, z;
+};
 
-        double delx=0.0,dely=0.0,delz=0.0;
-        std::set<unsigned long>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-            delx += w*static_cast<double>((v_beg[*cv_it]).x-v_it->x);
-            dely += w*static_cast<double>((v_beg[*cv_it]).y-v_it->y);
-            delz += w*static_cast<double>((v_beg[*cv_it]).z-v_it->z);
-        }
+}
 
-        float x = static_cast<float>(static_cast<double>(v_it->x)+stepsize*delx);
-        float y = static_cast<float>(static_cast<double>(v_it->y)+stepsize*dely);
-        float z = static_cast<float>(static_cast<double>(v_it->z)+stepsize*delz);
-        kernel.SetPoint(pos,x,y,z);
+std::vector<char> LaplaceSmoothing::FixedPoints(const MeshCompactPointToPoints& vv_it,
+                                                const MeshCompactPointToFacets& vf_it) const
+{
+    unsigned long count = kernel.CountPoints();
+    std::vector<char> fixed(count);
+    for (unsigned long pos = 0; pos < count; pos++) {
+        unsigned long n_count = vv_it.Count(pos);
+        // do nothing for border points
+        fixed[pos] = n_count < 3 || n_count != vf_it.Count(pos);
     }
+
+    return fixed;
 }
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it, double stepsize,
-                                const std::vector<unsigned long>& point_indices)
+void LaplaceSmoothing::Umbrella(const MeshCompactPointToPoints& vv_it,
+                                const std::vector<char>& fixed,
+                                const std::vector<double>& stepsizes,
+                                const std::vector<unsigned long>& point_indices,
+                                unsigned int iterations)
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_beg = points.begin();
-
-    for (std::vector<unsigned long>::const_iterator pos = point_indices.begin(); pos != point_indices.end(); ++pos) {
-        const std::set<unsigned long>& cv = vv_it[*pos];
-        if (cv.size() < 3)
-            continue;
-        if (cv.size() != vf_it[*pos].size()) {
-            // do nothing for border points
-            continue;
+    UmbrellaPoints cur(kernel.GetPoints());
+    UmbrellaPoints next(cur);
+
+    auto umbrella = [&](unsigned long pos, double stepsize) {
+        if (fixed[pos]) {
+            next.x[pos] = cur.x[pos];
+            next.y[pos] = cur.y[pos];
+            next.z[pos] = cur.z[pos];
+            return;
         }
 
-        size_t n_count = cv.size();
         double w;
-        w=1.0/double(n_count);
+        w=1.0/double(vv_it.Count(pos));
 
+        float px = cur.x[pos], py = cur.y[pos], pz = cur.z[pos];
         double delx=0.0,dely=0.0,delz=0.0;
-        std::set<unsigned long>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-            delx += w*static_cast<double>((v_beg[*cv_it]).x-(v_beg[*pos]).x);
-            dely += w*static_cast<double>((v_beg[*cv_it]).y-(v_beg[*pos]).y);
-            delz += w*static_cast<double>((v_beg[*cv_it]).z-(v_beg[*pos]).z);
+        for (const unsigned long* cv_it = vv_it.Begin(pos); cv_it != vv_it.End(pos); ++cv_it) {
+            delx += w*static_cast<double>(cur.x[*cv_it]-px);
+            dely += w*static_cast<double>(cur.y[*cv_it]-py);
+            delz += w*static_cast<double>(cur.z[*cv_it]-pz);
         }
 
-        float x = static_cast<float>(static_cast<double>((v_beg[*pos]).x)+stepsize*delx);
-        float y = static_cast<float>(static_cast<double>((v_beg[*pos]).y)+stepsize*dely);
-        float z = static_cast<float>(static_cast<double>((v_beg[*pos]).z)+stepsize*delz);
-        kernel.SetPoint(*pos,x,y,z);
+        next.x[pos] = static_cast<float>(static_cast<double>(px)+stepsize*delx);
+        next.y[pos] = static_cast<float>(static_cast<double>(py)+stepsize*dely);
+        next.z[pos] = static_cast<float>(static_cast<double>(pz)+stepsize*delz);
+    };
+
+    int threads = std::max(1, QThread::idealThreadCount());
+    unsigned long count = point_indices.empty() ? kernel.CountPoints() : point_indices.size();
+    for (unsigned int i=0; i<iterations; i++) {
+        for (std::vector<double>::const_iterator it = stepsizes.begin(); it != stepsizes.end(); ++it) {
+            double stepsize = *it;
+            parallel_for(0, count, [&](unsigned long first, unsigned long last) {
+                if (point_indices.empty()) {
+                    for (unsigned long pos = first; pos < last; pos++)
+                        umbrella(pos, stepsize);
+                }
+                else {
+                    for (unsigned long pos = first; pos < last; pos++)
+                        umbrella(point_indices[pos], stepsize);
+                }
+            }, threads);
+            cur.swap(next);
+        }
     }
+
+    parallel_for(0, count, [&](unsigned long first, unsigned long last) {
+        for (unsigned long pos = first; pos < last; pos++) {
+            unsigned long index = point_indices.empty() ? pos : point_indices[pos];
+            kernel.SetPoint(index, cur.x[index], cur.y[index], cur.z[index]);
+        }
+    }, threads);
 }
 
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel, vf_it);
+    std::vector<char> fixed = FixedPoints(vv_it, vf_it);
 
-    for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
-    }
+    std::vector<double> stepsizes(1, lambda);
+    Umbrella(vv_it, fixed, stepsizes, std::vector<unsigned long>(), iterations);
 }
 
 void LaplaceSmoothing::SmoothPoints(unsigned int iterations, const std::vector<unsigned long>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel, vf_it);
+    std::vector<char> fixed = FixedPoints(vv_it, vf_it);
 
-    for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
-    }
+    std::vector<double> stepsizes(1, lambda);
+    Umbrella(vv_it, fixed, stepsizes, UniquePoints(point_indices), iterations);
+}
+
+std::vector<unsigned long> LaplaceSmoothing::UniquePoints(const std::vector<unsigned long>& point_indices)
+{
+    // every point must be processed once per step
+    std::vector<unsigned long> points(point_indices);
+    std::sort(points.begin(), points.end());
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    return points;
 }
 
 TaubinSmoothing::TaubinSmoothing(MeshKernel& m)
@@ -281,26 +325,28 @@ TaubinSmoothing::~TaubinSmoothing()
 
 void TaubinSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel, vf_it);
+    std::vector<char> fixed = FixedPoints(vv_it, vf_it);
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations+1)/2; // two steps per iteration
-    for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
-        Umbrella(vv_it, vf_it, -(lambda+micro));
-    }
+    std::vector<double> stepsizes;
+    stepsizes.push_back(lambda);
+    stepsizes.push_back(-(lambda+micro));
+    Umbrella(vv_it, fixed, stepsizes, std::vector<unsigned long>(), iterations);
 }
 
 void TaubinSmoothing::SmoothPoints(unsigned int iterations, const std::vector<unsigned long>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel, vf_it);
+    std::vector<char> fixed = FixedPoints(vv_it, vf_it);
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations+1)/2; // two steps per iteration
-    for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
-        Umbrella(vv_it, vf_it, -(lambda+micro), point_indices);
-    }
+    std::vector<double> stepsizes;
+    stepsizes.push_back(lambda);
+    stepsizes.push_back(-(lambda+micro));
+    Umbrella(vv_it, fixed, stepsizes, UniquePoints(point_indices), iterations);
 }
@@ -31,6 +31,8 @@ namespace MeshCore
 class MeshKernel;
 class MeshRefPointToPoints;
 class MeshRefPointToFacets;
+class MeshCompactPointToPoints;
+class MeshCompactPointToFacets;
 
 /** Base class for smoothing algorithms. */
 class MeshExport AbstractSmoothing
@@ -83,11 +85,18 @@ public:
     void SetLambda(double l) { lambda = l;}
 
 protected:
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&, double);
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&, double,
-                  const std::vector<unsigned long>&);
+    /** Returns the points that are kept, i.e. the border points. */
+    std::vector<char> FixedPoints(const MeshCompactPointToPoints&,
+                                  const MeshCompactPointToFacets&) const;
+    /** Moves the given points (or all points if empty) towards the centre of
+     * their neighbours. Every iteration consists of one step per step size. All
+     * points of a step are computed from the previous step (Jacobi iteration),
+     * so they can be processed concurrently.
+     */
+    void Umbrella(const MeshCompactPointToPoints&,
+                  const std::vector<char>&, const std::vector<double>&,
+                  const std::vector<unsigned long>&, unsigned int);
+    static std::vector<unsigned long> UniquePoints(const std::vector<unsigned long>&);
 
 protected:
     double lambda;
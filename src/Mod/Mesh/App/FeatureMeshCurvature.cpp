@@ -65,11 +65,9 @@ App::DocumentObjectExecReturn *Curvature::execute(void)
         return new App::DocumentObjectExecReturn("No mesh object attached.");
     }
  
-    // get all points
-    const MeshCore::MeshKernel& rMesh = pcFeat->Mesh.getValue().getKernel();
-    MeshCore::MeshCurvature meshCurv(rMesh);
-    meshCurv.ComputePerVertex();
-    const std::vector<MeshCore::CurvatureInfo>& curv = meshCurv.GetCurvature();
+    // the curvature is cached by the mesh until its points or facets change
+    std::shared_ptr<const std::vector<MeshCore::CurvatureInfo> > curvature = pcFeat->Mesh.getValue().getCurvaturePerVertex();
+    const std::vector<MeshCore::CurvatureInfo>& curv = *curvature;
 
     std::vector<CurvatureInfo> values;
     values.reserve(curv.size());
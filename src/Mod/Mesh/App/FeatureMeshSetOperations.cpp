@@ -51,6 +51,7 @@ SetOperations::SetOperations(void)
     ADD_PROPERTY(Source1  ,(0));
     ADD_PROPERTY(Source2  ,(0));
     ADD_PROPERTY(OperationType, ("union"));
+    ADD_PROPERTY(Robust, (false));
 }
 
 short SetOperations::mustExecute() const
@@ -62,6 +63,8 @@ short SetOperations::mustExecute() const
             return 1;
         if (OperationType.isTouched())
             return 1;
+        if (Robust.isTouched())
+            return 1;
     }
 
     return 0;
@@ -96,6 +99,7 @@ App::DocumentObjectExecReturn *SetOperations::execute(void)
 
         MeshCore::SetOperations setOp(meshKernel1.getKernel(), meshKernel2.getKernel(), 
             pcKernel->getKernel(), type, 1.0e-5f);
+        setOp.SetRobust(Robust.getValue());
         setOp.Do();
         Mesh.setValuePtr(pcKernel.release());
     }
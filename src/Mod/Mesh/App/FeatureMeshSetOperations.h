@@ -50,6 +50,7 @@ public:
     App::PropertyLink   Source1;
     App::PropertyLink   Source2;
     App::PropertyString OperationType;
+    App::PropertyBool   Robust;
 
     /** @name methods override Feature */
     //@{
@@ -307,6 +307,7 @@ void GTSAlgos::fillMeshFromGTSSurface(Mesh::MeshObject& Mesh, GtsSurface* pSurfa
 
   // put the facets the simple way in the mesh, totp is recalculated!
   Mesh.getKernel() = VAry;
+  Mesh.resetAdjacency();
 
 }
 
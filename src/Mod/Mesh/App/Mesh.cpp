@@ -38,7 +38,9 @@
 #include <Base/Tools.h>
 #include <Base/ViewProj.h>
 
+#include "Core/Algorithm.h"
 #include "Core/Builder.h"
+#include "Core/Curvature.h"
 #include "Core/MeshKernel.h"
 #include "Core/Grid.h"
 #include "Core/Iterator.h"
@@ -186,19 +188,80 @@ void MeshObject::operator = (const MeshObject& mesh)
     if (this != &mesh) {
         // copy the mesh structure
         setTransform(mesh._Mtrx);
+        resetAdjacency();
         this->_kernel = mesh._kernel;
         copySegments(mesh);
     }
 }
 
+void MeshObject::resetAdjacency()
+{
+    std::lock_guard<std::mutex> lock(_adjacencyMutex);
+    _pointToFacets.reset();
+    _pointToPoints.reset();
+    _facetToFacets.reset();
+    _curvature.reset();
+}
+
+void MeshObject::resetCurvature()
+{
+    std::lock_guard<std::mutex> lock(_adjacencyMutex);
+    _curvature.reset();
+}
+
+std::shared_ptr<const MeshCore::MeshCompactPointToFacets> MeshObject::getPointToFacets() const
+{
+    std::lock_guard<std::mutex> lock(_adjacencyMutex);
+    if (!_pointToFacets)
+        _pointToFacets = std::make_shared<MeshCore::MeshCompactPointToFacets>(_kernel);
+    return _pointToFacets;
+}
+
+std::shared_ptr<const MeshCore::MeshCompactPointToPoints> MeshObject::getPointToPoints() const
+{
+    std::lock_guard<std::mutex> lock(_adjacencyMutex);
+    if (!_pointToPoints) {
+        if (!_pointToFacets)
+            _pointToFacets = std::make_shared<MeshCore::MeshCompactPointToFacets>(_kernel);
+        _pointToPoints = std::make_shared<MeshCore::MeshCompactPointToPoints>(_kernel, *_pointToFacets);
+    }
+    return _pointToPoints;
+}
+
+std::shared_ptr<const MeshCore::MeshCompactFacetToFacets> MeshObject::getFacetToFacets() const
+{
+    std::lock_guard<std::mutex> lock(_adjacencyMutex);
+    if (!_facetToFacets) {
+        if (!_pointToFacets)
+            _pointToFacets = std::make_shared<MeshCore::MeshCompactPointToFacets>(_kernel);
+        _facetToFacets = std::make_shared<MeshCore::MeshCompactFacetToFacets>(_kernel, *_pointToFacets);
+    }
+    return _facetToFacets;
+}
+
+std::shared_ptr<const std::vector<MeshCore::CurvatureInfo> > MeshObject::getCurvaturePerVertex() const
+{
+    std::lock_guard<std::mutex> lock(_adjacencyMutex);
+    if (!_curvature) {
+        if (!_pointToFacets)
+            _pointToFacets = std::make_shared<MeshCore::MeshCompactPointToFacets>(_kernel);
+        MeshCore::MeshCurvature meshCurv(_kernel);
+        meshCurv.ComputePerVertex(*_pointToFacets);
+        _curvature = std::make_shared<std::vector<MeshCore::CurvatureInfo> >(meshCurv.GetCurvature());
+    }
+    return _curvature;
+}
+
 void MeshObject::setKernel(const MeshCore::MeshKernel& m)
 {
+    resetAdjacency();
     this->_kernel = m;
     this->_segments.clear();
 }
 
 void MeshObject::swap(MeshCore::MeshKernel& Kernel)
 {
+    resetAdjacency();
     this->_kernel.Swap(Kernel);
     // clear the segments because we don't know how the new
     // topology looks like
@@ -207,6 +270,8 @@ void MeshObject::swap(MeshCore::MeshKernel& Kernel)
 
 void MeshObject::swap(MeshObject& mesh)
 {
+    resetAdjacency();
+    mesh.resetAdjacency();
     this->_kernel.Swap(mesh._kernel);
     swapSegments(mesh);
     Base::Matrix4D tmp=this->_Mtrx;
@@ -463,6 +528,7 @@ bool MeshObject::load(std::istream& str, MeshCore::MeshIO::Format f, MeshCore::M
 void MeshObject::swapKernel(MeshCore::MeshKernel& kernel,
                             const std::vector<std::string>& g)
 {
+    resetAdjacency();
     _kernel.Swap(kernel);
     // Some file formats define several objects per file (e.g. OBJ).
     // Now we mark each object as an own segment so that we can break
@@ -528,6 +594,7 @@ void MeshObject::save(std::ostream& out) const
 
 void MeshObject::load(std::istream& in)
 {
+    resetAdjacency();
     _kernel.Read(in);
     this->_segments.clear();
 
@@ -554,17 +621,20 @@ void MeshObject::load(std::istream& in)
 
 void MeshObject::addFacet(const MeshCore::MeshGeomFacet& facet)
 {
+    resetAdjacency();
     _kernel.AddFacet(facet);
 }
 
 void MeshObject::addFacets(const std::vector<MeshCore::MeshGeomFacet>& facets)
 {
+    resetAdjacency();
     _kernel.AddFacets(facets);
 }
 
 void MeshObject::addFacets(const std::vector<MeshCore::MeshFacet> &facets,
                            bool checkManifolds)
 {
+    resetAdjacency();
     _kernel.AddFacets(facets, checkManifolds);
 }
 
@@ -572,6 +642,7 @@ void MeshObject::addFacets(const std::vector<MeshCore::MeshFacet> &facets,
                            const std::vector<Base::Vector3f>& points,
                            bool checkManifolds)
 {
+    resetAdjacency();
     _kernel.AddFacets(facets, points, checkManifolds);
 }
 
@@ -579,6 +650,7 @@ void MeshObject::addFacets(const std::vector<Data::ComplexGeoData::Facet> &facet
                            const std::vector<Base::Vector3d>& points,
                            bool checkManifolds)
 {
+    resetAdjacency();
     std::vector<MeshCore::MeshFacet> facet_v;
     facet_v.reserve(facets.size());
     for (std::vector<Data::ComplexGeoData::Facet>::const_iterator it = facets.begin(); it != facets.end(); ++it) {
@@ -601,12 +673,14 @@ void MeshObject::addFacets(const std::vector<Data::ComplexGeoData::Facet> &facet
 
 void MeshObject::setFacets(const std::vector<MeshCore::MeshGeomFacet>& facets)
 {
+    resetAdjacency();
     _kernel = facets;
 }
 
 void MeshObject::setFacets(const std::vector<Data::ComplexGeoData::Facet> &facets,
                            const std::vector<Base::Vector3d>& points)
 {
+    resetAdjacency();
     MeshCore::MeshFacetArray facet_v;
     facet_v.reserve(facets.size());
     for (std::vector<Data::ComplexGeoData::Facet>::const_iterator it = facets.begin(); it != facets.end(); ++it) {
@@ -629,11 +703,13 @@ void MeshObject::setFacets(const std::vector<Data::ComplexGeoData::Facet> &facet
 
 void MeshObject::addMesh(const MeshObject& mesh)
 {
+    resetAdjacency();
     _kernel.Merge(mesh._kernel);
 }
 
 void MeshObject::addMesh(const MeshCore::MeshKernel& kernel)
 {
+    resetAdjacency();
     _kernel.Merge(kernel);
 }
 
@@ -641,6 +717,7 @@ void MeshObject::deleteFacets(const std::vector<unsigned long>& removeIndices)
 {
     if (removeIndices.empty())
         return;
+    resetAdjacency();
     _kernel.DeleteFacets(removeIndices);
     deletedFacets(removeIndices);
 }
@@ -649,6 +726,7 @@ void MeshObject::deletePoints(const std::vector<unsigned long>& removeIndices)
 {
     if (removeIndices.empty())
         return;
+    resetAdjacency();
     _kernel.DeletePoints(removeIndices);
     this->_segments.clear();
 }
@@ -815,6 +893,7 @@ unsigned long MeshObject::countComponents() const
 
 void MeshObject::removeComponents(unsigned long count)
 {
+    resetAdjacency();
     std::vector<unsigned long> removeIndices;
     MeshCore::MeshTopoAlgorithm(_kernel).FindComponents(count, removeIndices);
     _kernel.DeleteFacets(removeIndices);
@@ -851,6 +930,7 @@ unsigned long MeshObject::getPointDegree(const std::vector<unsigned long>& indic
 void MeshObject::fillupHoles(unsigned long length, int level,
                              MeshCore::AbstractPolygonTriangulator& cTria)
 {
+    resetAdjacency();
     std::list<std::vector<unsigned long> > aFailed;
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     topalg.FillupHoles(length, level, cTria, aFailed);
@@ -858,6 +938,7 @@ void MeshObject::fillupHoles(unsigned long length, int level,
 
 void MeshObject::offset(float fSize)
 {
+    resetCurvature();
     std::vector<Base::Vector3f> normals = _kernel.CalcVertexNormals();
 
     unsigned int i = 0;
@@ -870,6 +951,7 @@ void MeshObject::offset(float fSize)
 
 void MeshObject::offsetSpecial2(float fSize)
 {
+    resetAdjacency();
     Base::Builder3D builder;  
     std::vector<Base::Vector3f> PointNormals= _kernel.CalcVertexNormals();
     std::vector<Base::Vector3f> FaceNormals;
@@ -924,6 +1006,7 @@ void MeshObject::offsetSpecial2(float fSize)
 
 void MeshObject::offsetSpecial(float fSize, float zmax, float zmin)
 {
+    resetCurvature();
     std::vector<Base::Vector3f> normals = _kernel.CalcVertexNormals();
 
     unsigned int i = 0;
@@ -943,6 +1026,7 @@ void MeshObject::offsetSpecial(float fSize, float zmax, float zmin)
 
 void MeshObject::clear(void)
 {
+    resetAdjacency();
     _kernel.Clear();
     this->_segments.clear();
     setTransform(Base::Matrix4D());
@@ -972,31 +1056,43 @@ void MeshObject::movePoint(unsigned long index, const Base::Vector3d& v)
     vec.x += _Mtrx[0][3];
     vec.y += _Mtrx[1][3];
     vec.z += _Mtrx[2][3];
+    resetCurvature();
     _kernel.MovePoint(index,transformToInside(vec));
 }
 
 void MeshObject::setPoint(unsigned long index, const Base::Vector3d& p)
 {
+    resetCurvature();
     _kernel.SetPoint(index,transformToInside(p));
 }
 
 void MeshObject::smooth(int iterations, float d_max)
 {
+    resetCurvature();
     _kernel.Smooth(iterations, d_max);
 }
 
 void MeshObject::decimate(float fTolerance, float fReduction)
 {
+    resetAdjacency();
     MeshCore::MeshSimplify dm(this->_kernel);
     dm.simplify(fTolerance, fReduction);
 }
 
 void MeshObject::decimate(int targetSize)
 {
+    resetAdjacency();
     MeshCore::MeshSimplify dm(this->_kernel);
     dm.simplify(targetSize);
 }
 
+void MeshObject::decimate(int targetSize, float maxError)
+{
+    resetAdjacency();
+    MeshCore::MeshSimplify dm(this->_kernel);
+    dm.simplify(targetSize, maxError);
+}
+
 Base::Vector3d MeshObject::getPointNormal(unsigned long index) const
 {
     std::vector<Base::Vector3f> temp = _kernel.CalcVertexNormals();
@@ -1049,6 +1145,7 @@ void MeshObject::crossSections(const std::vector<MeshObject::TPlane>& planes, st
 void MeshObject::cut(const Base::Polygon2d& polygon2d,
                      const Base::ViewProjMethod& proj, MeshObject::CutType type)
 {
+    resetAdjacency();
     MeshCore::MeshAlgorithm meshAlg(this->_kernel);
     std::vector<unsigned long> check;
 
@@ -1074,6 +1171,7 @@ void MeshObject::cut(const Base::Polygon2d& polygon2d,
 void MeshObject::trim(const Base::Polygon2d& polygon2d,
                       const Base::ViewProjMethod& proj, MeshObject::CutType type)
 {
+    resetAdjacency();
     MeshCore::MeshTrimming trim(this->_kernel, &proj, polygon2d);
     std::vector<unsigned long> check;
     std::vector<MeshCore::MeshGeomFacet> triangle;
@@ -1098,6 +1196,7 @@ void MeshObject::trim(const Base::Polygon2d& polygon2d,
 
 void MeshObject::trim(const Base::Vector3f& base, const Base::Vector3f& normal)
 {
+    resetAdjacency();
     MeshCore::MeshTrimByPlane trim(this->_kernel);
     std::vector<unsigned long> trimFacets, removeFacets;
     std::vector<MeshCore::MeshGeomFacet> triangle;
@@ -1111,7 +1210,7 @@ void MeshObject::trim(const Base::Vector3f& base, const Base::Vector3f& normal)
         this->_kernel.AddFacets(triangle);
 }
 
-MeshObject* MeshObject::unite(const MeshObject& mesh) const
+MeshObject* MeshObject::unite(const MeshObject& mesh, bool robust) const
 {
     MeshCore::MeshKernel result;
     MeshCore::MeshKernel kernel1(this->_kernel);
@@ -1120,11 +1219,12 @@ MeshObject* MeshObject::unite(const MeshObject& mesh) const
     kernel2.Transform(mesh._Mtrx);
     MeshCore::SetOperations setOp(kernel1, kernel2, result,
                                   MeshCore::SetOperations::Union, Epsilon);
+    setOp.SetRobust(robust);
     setOp.Do();
     return new MeshObject(result);
 }
 
-MeshObject* MeshObject::intersect(const MeshObject& mesh) const
+MeshObject* MeshObject::intersect(const MeshObject& mesh, bool robust) const
 {
     MeshCore::MeshKernel result;
     MeshCore::MeshKernel kernel1(this->_kernel);
@@ -1133,11 +1233,12 @@ MeshObject* MeshObject::intersect(const MeshObject& mesh) const
     kernel2.Transform(mesh._Mtrx);
     MeshCore::SetOperations setOp(kernel1, kernel2, result,
                                   MeshCore::SetOperations::Intersect, Epsilon);
+    setOp.SetRobust(robust);
     setOp.Do();
     return new MeshObject(result);
 }
 
-MeshObject* MeshObject::subtract(const MeshObject& mesh) const
+MeshObject* MeshObject::subtract(const MeshObject& mesh, bool robust) const
 {
     MeshCore::MeshKernel result;
     MeshCore::MeshKernel kernel1(this->_kernel);
@@ -1146,11 +1247,12 @@ MeshObject* MeshObject::subtract(const MeshObject& mesh) const
     kernel2.Transform(mesh._Mtrx);
     MeshCore::SetOperations setOp(kernel1, kernel2, result,
                                   MeshCore::SetOperations::Difference, Epsilon);
+    setOp.SetRobust(robust);
     setOp.Do();
     return new MeshObject(result);
 }
 
-MeshObject* MeshObject::inner(const MeshObject& mesh) const
+MeshObject* MeshObject::inner(const MeshObject& mesh, bool robust) const
 {
     MeshCore::MeshKernel result;
     MeshCore::MeshKernel kernel1(this->_kernel);
@@ -1159,11 +1261,12 @@ MeshObject* MeshObject::inner(const MeshObject& mesh) const
     kernel2.Transform(mesh._Mtrx);
     MeshCore::SetOperations setOp(kernel1, kernel2, result,
                                   MeshCore::SetOperations::Inner, Epsilon);
+    setOp.SetRobust(robust);
     setOp.Do();
     return new MeshObject(result);
 }
 
-MeshObject* MeshObject::outer(const MeshObject& mesh) const
+MeshObject* MeshObject::outer(const MeshObject& mesh, bool robust) const
 {
     MeshCore::MeshKernel result;
     MeshCore::MeshKernel kernel1(this->_kernel);
@@ -1172,12 +1275,14 @@ MeshObject* MeshObject::outer(const MeshObject& mesh) const
     kernel2.Transform(mesh._Mtrx);
     MeshCore::SetOperations setOp(kernel1, kernel2, result,
                                   MeshCore::SetOperations::Outer, Epsilon);
+    setOp.SetRobust(robust);
     setOp.Do();
     return new MeshObject(result);
 }
 
 void MeshObject::refine()
 {
+    resetAdjacency();
     unsigned long cnt = _kernel.CountFacets();
     MeshCore::MeshFacetIterator cF(_kernel);
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
@@ -1196,6 +1301,7 @@ void MeshObject::refine()
 
 void MeshObject::removeNeedles(float length)
 {
+    resetAdjacency();
     unsigned long count = _kernel.CountFacets();
     MeshCore::MeshRemoveNeedles eval(_kernel, length);
     eval.Fixup();
@@ -1205,12 +1311,14 @@ void MeshObject::removeNeedles(float length)
 
 void MeshObject::validateCaps(float fMaxAngle, float fSplitFactor)
 {
+    resetAdjacency();
     MeshCore::MeshFixCaps eval(_kernel, fMaxAngle, fSplitFactor);
     eval.Fixup();
 }
 
 void MeshObject::optimizeTopology(float fMaxAngle)
 {
+    resetAdjacency();
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     if (fMaxAngle > 0.0f)
         topalg.OptimizeTopology(fMaxAngle);
@@ -1224,12 +1332,14 @@ void MeshObject::optimizeTopology(float fMaxAngle)
 
 void MeshObject::optimizeEdges()
 {
+    resetAdjacency();
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     topalg.AdjustEdgesToCurvatureDirection();
 }
 
 void MeshObject::splitEdges()
 {
+    resetAdjacency();
     std::vector<std::pair<unsigned long, unsigned long> > adjacentFacet;
     MeshCore::MeshAlgorithm alg(_kernel);
     alg.ResetFacetFlag(MeshCore::MeshFacet::VISIT);
@@ -1261,24 +1371,28 @@ void MeshObject::splitEdges()
 
 void MeshObject::splitEdge(unsigned long facet, unsigned long neighbour, const Base::Vector3f& v)
 {
+    resetAdjacency();
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     topalg.SplitEdge(facet, neighbour, v);
 }
 
 void MeshObject::splitFacet(unsigned long facet, const Base::Vector3f& v1, const Base::Vector3f& v2)
 {
+    resetAdjacency();
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     topalg.SplitFacet(facet, v1, v2);
 }
 
 void MeshObject::swapEdge(unsigned long facet, unsigned long neighbour)
 {
+    resetAdjacency();
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     topalg.SwapEdge(facet, neighbour);
 }
 
 void MeshObject::collapseEdge(unsigned long facet, unsigned long neighbour)
 {
+    resetAdjacency();
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     topalg.CollapseEdge(facet, neighbour);
 
@@ -1290,6 +1404,7 @@ void MeshObject::collapseEdge(unsigned long facet, unsigned long neighbour)
 
 void MeshObject::collapseFacet(unsigned long facet)
 {
+    resetAdjacency();
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     topalg.CollapseFacet(facet);
 
@@ -1300,6 +1415,7 @@ void MeshObject::collapseFacet(unsigned long facet)
 
 void MeshObject::collapseFacets(const std::vector<unsigned long>& facets)
 {
+    resetAdjacency();
     MeshCore::MeshTopoAlgorithm alg(_kernel);
     for (std::vector<unsigned long>::const_iterator it = facets.begin(); it != facets.end(); ++it) {
         alg.CollapseFacet(*it);
@@ -1310,12 +1426,14 @@ void MeshObject::collapseFacets(const std::vector<unsigned long>& facets)
 
 void MeshObject::insertVertex(unsigned long facet, const Base::Vector3f& v)
 {
+    resetAdjacency();
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     topalg.InsertVertex(facet, v);
 }
 
 void MeshObject::snapVertex(unsigned long facet, const Base::Vector3f& v)
 {
+    resetAdjacency();
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     topalg.SnapVertex(facet, v);
 }
@@ -1329,12 +1447,14 @@ unsigned long MeshObject::countNonUniformOrientedFacets() const
 
 void MeshObject::flipNormals()
 {
+    resetAdjacency();
     MeshCore::MeshTopoAlgorithm alg(_kernel);
     alg.FlipNormals();
 }
 
 void MeshObject::harmonizeNormals()
 {
+    resetAdjacency();
     MeshCore::MeshTopoAlgorithm alg(_kernel);
     alg.HarmonizeNormals();
 }
@@ -1347,6 +1467,7 @@ bool MeshObject::hasNonManifolds() const
 
 void MeshObject::removeNonManifolds()
 {
+    resetAdjacency();
     MeshCore::MeshEvalTopology f_eval(_kernel);
     if (!f_eval.Evaluate()) {
         MeshCore::MeshFixTopology f_fix(_kernel, f_eval.GetFacets());
@@ -1357,6 +1478,7 @@ void MeshObject::removeNonManifolds()
 
 void MeshObject::removeNonManifoldPoints()
 {
+    resetAdjacency();
     MeshCore::MeshEvalPointManifolds p_eval(_kernel);
     if (!p_eval.Evaluate()) {
         std::vector<unsigned long> faces;
@@ -1373,6 +1495,7 @@ bool MeshObject::hasSelfIntersections() const
 
 void MeshObject::removeSelfIntersections()
 {
+    resetAdjacency();
     std::vector<std::pair<unsigned long, unsigned long> > selfIntersections;
     MeshCore::MeshEvalSelfIntersection cMeshEval(_kernel);
     cMeshEval.GetIntersections(selfIntersections);
@@ -1385,6 +1508,7 @@ void MeshObject::removeSelfIntersections()
 
 void MeshObject::removeSelfIntersections(const std::vector<unsigned long>& indices)
 {
+    resetAdjacency();
     // make sure that the number of indices is even and are in range
     if (indices.size() % 2 != 0)
         return;
@@ -1408,6 +1532,7 @@ void MeshObject::removeSelfIntersections(const std::vector<unsigned long>& indic
 
 void MeshObject::removeFoldsOnSurface()
 {
+    resetAdjacency();
     std::vector<unsigned long> indices;
     MeshCore::MeshEvalFoldsOnSurface s_eval(_kernel);
     MeshCore::MeshEvalFoldOversOnSurface f_eval(_kernel);
@@ -1439,6 +1564,7 @@ void MeshObject::removeFoldsOnSurface()
 
 void MeshObject::removeFullBoundaryFacets()
 {
+    resetAdjacency();
     std::vector<unsigned long> facets;
     if (!MeshCore::MeshEvalBorderFacet(_kernel, facets).Evaluate()) {
         deleteFacets(facets);
@@ -1453,12 +1579,14 @@ bool MeshObject::hasInvalidPoints() const
 
 void MeshObject::removeInvalidPoints()
 {
+    resetAdjacency();
     MeshCore::MeshEvalNaNPoints nan(_kernel);
     deletePoints(nan.GetIndices());
 }
 
 void MeshObject::mergeFacets()
 {
+    resetAdjacency();
     unsigned long count = _kernel.CountFacets();
     MeshCore::MeshFixMergeFacets merge(_kernel);
     merge.Fixup();
@@ -1468,6 +1596,7 @@ void MeshObject::mergeFacets()
 
 void MeshObject::validateIndices()
 {
+    resetAdjacency();
     unsigned long count = _kernel.CountFacets();
 
     // for invalid neighbour indices we don't need to check first
@@ -1523,6 +1652,7 @@ bool MeshObject::hasCorruptedFacets() const
 
 void MeshObject::validateDeformations(float fMaxAngle, float fEps)
 {
+    resetAdjacency();
     unsigned long count = _kernel.CountFacets();
     MeshCore::MeshFixDeformedFacets eval(_kernel,
                                          Base::toRadians(15.0f),
@@ -1535,6 +1665,7 @@ void MeshObject::validateDeformations(float fMaxAngle, float fEps)
 
 void MeshObject::validateDegenerations(float fEps)
 {
+    resetAdjacency();
     unsigned long count = _kernel.CountFacets();
     MeshCore::MeshFixDegeneratedFacets eval(_kernel, fEps);
     eval.Fixup();
@@ -1544,6 +1675,7 @@ void MeshObject::validateDegenerations(float fEps)
 
 void MeshObject::removeDuplicatedPoints()
 {
+    resetAdjacency();
     unsigned long count = _kernel.CountFacets();
     MeshCore::MeshFixDuplicatePoints eval(_kernel);
     eval.Fixup();
@@ -1553,6 +1685,7 @@ void MeshObject::removeDuplicatedPoints()
 
 void MeshObject::removeDuplicatedFacets()
 {
+    resetAdjacency();
     unsigned long count = _kernel.CountFacets();
     MeshCore::MeshFixDuplicateFacets eval(_kernel);
     eval.Fixup();
@@ -1829,13 +1962,15 @@ MeshObject* MeshObject::meshFromSegment(const std::vector<unsigned long>& indice
 }
 
 std::vector<Segment> MeshObject::getSegmentsOfType(MeshObject::GeometryType type,
-                                                   float dev, unsigned long minFacets) const
+                                                   float dev, unsigned long minFacets,
+                                                   bool parallel) const
 {
     std::vector<Segment> segm;
     if (this->_kernel.CountFacets() == 0)
         return segm;
 
     MeshCore::MeshSegmentAlgorithm finder(this->_kernel);
+    finder.SetParallel(parallel);
     std::shared_ptr<MeshCore::MeshDistanceSurfaceSegment> surf;
     switch (type) {
     case PLANE:
@@ -29,6 +29,8 @@
 #include <set>
 #include <string>
 #include <map>
+#include <memory>
+#include <mutex>
 
 #include <Base/Matrix.h>
 #include <Base/Vector3D.h>
@@ -56,6 +58,10 @@ namespace Base {
 
 namespace MeshCore {
 class AbstractPolygonTriangulator;
+class MeshCompactPointToFacets;
+class MeshCompactPointToPoints;
+class MeshCompactFacetToFacets;
+struct CurvatureInfo;
 }
 
 namespace Mesh
@@ -137,6 +143,7 @@ public:
     //@}
 
     void setKernel(const MeshCore::MeshKernel& m);
+    /// Call resetAdjacency() after modifying the kernel through the returned reference
     MeshCore::MeshKernel& getKernel(void)
     { return _kernel; }
     const MeshCore::MeshKernel& getKernel(void) const
@@ -144,6 +151,25 @@ public:
 
     virtual Base::BoundBox3d getBoundBox(void)const;
 
+    /** @name Adjacency
+     * The compact adjacency structures are built on first use and shared until
+     * the topology of the mesh changes. They are dropped by every method that
+     * modifies the kernel. Code that modifies the kernel directly must call
+     * resetAdjacency() when done.
+     */
+    //@{
+    /// Drops the cached adjacency and curvature
+    void resetAdjacency();
+    std::shared_ptr<const MeshCore::MeshCompactPointToFacets> getPointToFacets() const;
+    std::shared_ptr<const MeshCore::MeshCompactPointToPoints> getPointToPoints() const;
+    std::shared_ptr<const MeshCore::MeshCompactFacetToFacets> getFacetToFacets() const;
+    /** The principal curvatures per point. They are computed on first use and shared
+     * until the points or the topology of the mesh change. Methods that only move
+     * points drop them but keep the adjacency.
+     */
+    std::shared_ptr<const std::vector<MeshCore::CurvatureInfo> > getCurvaturePerVertex() const;
+    //@}
+
     /** @name I/O */
     //@{
     // Implemented from Persistence
@@ -218,6 +244,7 @@ public:
     void smooth(int iterations, float d_max);
     void decimate(float fTolerance, float fReduction);
     void decimate(int targetSize);
+    void decimate(int targetSize, float maxError);
     Base::Vector3d getPointNormal(unsigned long) const;
     std::vector<Base::Vector3d> getPointNormals() const;
     void crossSections(const std::vector<TPlane>&, std::vector<TPolylines> &sections,
@@ -245,13 +272,16 @@ public:
     void clearPointSelection() const;
     //@}
 
-    /** @name Boolean operations */
+    /** @name Boolean operations
+     * If \a robust is true the intersection curve is computed with exact predicates,
+     * see MeshCore::SetOperations::SetRobust().
+     */
     //@{
-    MeshObject* unite(const MeshObject&) const;
-    MeshObject* intersect(const MeshObject&) const;
-    MeshObject* subtract(const MeshObject&) const;
-    MeshObject* inner(const MeshObject&) const;
-    MeshObject* outer(const MeshObject&) const;
+    MeshObject* unite(const MeshObject&, bool robust=false) const;
+    MeshObject* intersect(const MeshObject&, bool robust=false) const;
+    MeshObject* subtract(const MeshObject&, bool robust=false) const;
+    MeshObject* inner(const MeshObject&, bool robust=false) const;
+    MeshObject* outer(const MeshObject&, bool robust=false) const;
     //@}
 
     /** @name Topological operations */
@@ -306,7 +336,8 @@ public:
     const Segment& getSegment(unsigned long) const;
     Segment& getSegment(unsigned long);
     MeshObject* meshFromSegment(const std::vector<unsigned long>&) const;
-    std::vector<Segment> getSegmentsOfType(GeometryType, float dev, unsigned long minFacets) const;
+    std::vector<Segment> getSegmentsOfType(GeometryType, float dev, unsigned long minFacets,
+                                           bool parallel=false) const;
     //@}
 
     /** @name Primitives */
@@ -393,12 +424,20 @@ private:
     void swapKernel(MeshCore::MeshKernel& m, const std::vector<std::string>& g);
     void copySegments(const MeshObject&);
     void swapSegments(MeshObject&);
+    void resetCurvature();
 
 private:
     Base::Matrix4D _Mtrx;
     MeshCore::MeshKernel _kernel;
     std::vector<Segment> _segments;
     static float Epsilon;
+
+    // cached adjacency, not copied with the mesh
+    mutable std::mutex _adjacencyMutex;
+    mutable std::shared_ptr<const MeshCore::MeshCompactPointToFacets> _pointToFacets;
+    mutable std::shared_ptr<const MeshCore::MeshCompactPointToPoints> _pointToPoints;
+    mutable std::shared_ptr<const MeshCore::MeshCompactFacetToFacets> _facetToFacets;
+    mutable std::shared_ptr<const std::vector<MeshCore::CurvatureInfo> > _curvature;
 };
 
 } // namespace Mesh
@@ -519,6 +519,7 @@ MeshObject* PropertyMeshKernel::startEditing()
 
 void PropertyMeshKernel::finishEditing()
 {
+    _meshObject->resetAdjacency();
     hasSetValue();
 }
 
@@ -535,6 +536,7 @@ void PropertyMeshKernel::setPointIndices(const std::vector<std::pair<unsigned lo
     MeshCore::MeshKernel& kernel = _meshObject->getKernel();
     for (std::vector<std::pair<unsigned long, Base::Vector3f> >::const_iterator it = inds.begin(); it != inds.end(); ++it)
         kernel.SetPoint(it->first, it->second);
+    _meshObject->resetAdjacency();
     hasSetValue();
 }
 
@@ -604,6 +606,7 @@ void PropertyMeshKernel::Restore(Base::XMLReader &reader)
 
         aboutToSetValue();
         _meshObject->getKernel().Adopt(points, facets);
+        _meshObject->resetAdjacency();
         hasSetValue();
     } 
     else {
@@ -322,7 +322,7 @@ PyObject*  MeshPy::writeInventor(PyObject *args)
     if (!PyArg_ParseTuple(args, "|f",&creaseangle))
         return NULL;
 
-    MeshObject* mesh = getMeshObjectPtr();
+    const MeshObject* mesh = getMeshObjectPtr();
     const MeshCore::MeshFacetArray& faces = mesh->getKernel().GetFacets();
     std::vector<int> indices;
     std::vector<Base::Vector3f> coords;
@@ -443,13 +443,15 @@ PyObject*  MeshPy::unite(PyObject *args)
 {
     MeshPy   *pcObject;
     PyObject *pcObj;
-    if (!PyArg_ParseTuple(args, "O!", &(MeshPy::Type), &pcObj))     // convert args: Python->C 
+    PyObject *robust = Py_False;
+    if (!PyArg_ParseTuple(args, "O!|O!", &(MeshPy::Type), &pcObj, &PyBool_Type, &robust))     // convert args: Python->C 
         return NULL;                             // NULL triggers exception 
 
     pcObject = static_cast<MeshPy*>(pcObj);
 
     PY_TRY {
-        MeshObject* mesh = getMeshObjectPtr()->unite(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh = getMeshObjectPtr()->unite(*pcObject->getMeshObjectPtr(),
+            PyObject_IsTrue(robust) ? true : false);
         return new MeshPy(mesh);
     } PY_CATCH;
 
@@ -460,13 +462,15 @@ PyObject*  MeshPy::intersect(PyObject *args)
 {
     MeshPy   *pcObject;
     PyObject *pcObj;
-    if (!PyArg_ParseTuple(args, "O!", &(MeshPy::Type), &pcObj))     // convert args: Python->C 
+    PyObject *robust = Py_False;
+    if (!PyArg_ParseTuple(args, "O!|O!", &(MeshPy::Type), &pcObj, &PyBool_Type, &robust))     // convert args: Python->C 
         return NULL;                             // NULL triggers exception 
 
     pcObject = static_cast<MeshPy*>(pcObj);
 
     PY_TRY {
-        MeshObject* mesh = getMeshObjectPtr()->intersect(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh = getMeshObjectPtr()->intersect(*pcObject->getMeshObjectPtr(),
+            PyObject_IsTrue(robust) ? true : false);
         return new MeshPy(mesh);
     } PY_CATCH;
 
@@ -477,13 +481,15 @@ PyObject*  MeshPy::difference(PyObject *args)
 {
     MeshPy   *pcObject;
     PyObject *pcObj;
-    if (!PyArg_ParseTuple(args, "O!", &(MeshPy::Type), &pcObj))     // convert args: Python->C 
+    PyObject *robust = Py_False;
+    if (!PyArg_ParseTuple(args, "O!|O!", &(MeshPy::Type), &pcObj, &PyBool_Type, &robust))     // convert args: Python->C 
         return NULL;                             // NULL triggers exception 
 
     pcObject = static_cast<MeshPy*>(pcObj);
 
     PY_TRY {
-        MeshObject* mesh = getMeshObjectPtr()->subtract(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh = getMeshObjectPtr()->subtract(*pcObject->getMeshObjectPtr(),
+            PyObject_IsTrue(robust) ? true : false);
         return new MeshPy(mesh);
     } PY_CATCH;
 
@@ -494,13 +500,15 @@ PyObject*  MeshPy::inner(PyObject *args)
 {
     MeshPy   *pcObject;
     PyObject *pcObj;
-    if (!PyArg_ParseTuple(args, "O!", &(MeshPy::Type), &pcObj))     // convert args: Python->C 
+    PyObject *robust = Py_False;
+    if (!PyArg_ParseTuple(args, "O!|O!", &(MeshPy::Type), &pcObj, &PyBool_Type, &robust))     // convert args: Python->C 
         return NULL;                             // NULL triggers exception 
 
     pcObject = static_cast<MeshPy*>(pcObj);
 
     PY_TRY {
-        MeshObject* mesh = getMeshObjectPtr()->inner(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh = getMeshObjectPtr()->inner(*pcObject->getMeshObjectPtr(),
+            PyObject_IsTrue(robust) ? true : false);
         return new MeshPy(mesh);
     } PY_CATCH;
 
@@ -511,13 +519,15 @@ PyObject*  MeshPy::outer(PyObject *args)
 {
     MeshPy   *pcObject;
     PyObject *pcObj;
-    if (!PyArg_ParseTuple(args, "O!", &(MeshPy::Type), &pcObj))     // convert args: Python->C 
+    PyObject *robust = Py_False;
+    if (!PyArg_ParseTuple(args, "O!|O!", &(MeshPy::Type), &pcObj, &PyBool_Type, &robust))     // convert args: Python->C 
         return NULL;                             // NULL triggers exception 
 
     pcObject = static_cast<MeshPy*>(pcObj);
 
     PY_TRY {
-        MeshObject* mesh = getMeshObjectPtr()->outer(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh = getMeshObjectPtr()->outer(*pcObject->getMeshObjectPtr(),
+            PyObject_IsTrue(robust) ? true : false);
         return new MeshPy(mesh);
     } PY_CATCH;
 
@@ -541,7 +551,7 @@ PyObject*  MeshPy::translate(PyObject *args)
     PY_TRY {
         Base::Matrix4D m;
         m.move(x,y,z);
-        getMeshObjectPtr()->getKernel().Transform(m);
+        getMeshObjectPtr()->transformGeometry(m);
     } PY_CATCH;
 
     Py_Return;
@@ -558,7 +568,7 @@ PyObject*  MeshPy::rotate(PyObject *args)
         m.rotX(x);
         m.rotY(y);
         m.rotZ(z);
-        getMeshObjectPtr()->getKernel().Transform(m);
+        getMeshObjectPtr()->transformGeometry(m);
     } PY_CATCH;
 
     Py_Return;
@@ -571,7 +581,7 @@ PyObject*  MeshPy::transform(PyObject *args)
         return NULL;
 
     PY_TRY {
-        getMeshObjectPtr()->getKernel().Transform(static_cast<Base::MatrixPy*>(mat)->value());
+        getMeshObjectPtr()->transformGeometry(static_cast<Base::MatrixPy*>(mat)->value());
     } PY_CATCH;
 
     Py_Return;
@@ -772,7 +782,8 @@ PyObject* MeshPy::getInternalFacets(PyObject *args)
     if (!PyArg_ParseTuple(args, ""))
         return 0;
 
-    const MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
+    const MeshObject* mesh = getMeshObjectPtr();
+    const MeshCore::MeshKernel& kernel = mesh->getKernel();
     MeshCore::MeshEvalInternalFacets eval(kernel);
     eval.Evaluate();
 
@@ -793,6 +804,7 @@ PyObject* MeshPy::rebuildNeighbourHood(PyObject *args)
 
     MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
     kernel.RebuildNeighbours();
+    getMeshObjectPtr()->resetAdjacency();
     Py_Return;
 }
 
@@ -1035,7 +1047,8 @@ PyObject*  MeshPy::getSelfIntersections(PyObject *args)
 
     std::vector<std::pair<unsigned long, unsigned long> > selfIndices;
     std::vector<std::pair<Base::Vector3f, Base::Vector3f> > selfPoints;
-    MeshCore::MeshEvalSelfIntersection eval(getMeshObjectPtr()->getKernel());
+    const MeshObject* mesh = getMeshObjectPtr();
+    MeshCore::MeshEvalSelfIntersection eval(mesh->getKernel());
     eval.GetIntersections(selfIndices);
     eval.GetIntersections(selfIndices, selfPoints);
 
@@ -1138,7 +1151,8 @@ PyObject*  MeshPy::getNonUniformOrientedFacets(PyObject *args)
     if (!PyArg_ParseTuple(args, ""))
         return NULL;
 
-    const MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
+    const MeshObject* mesh = getMeshObjectPtr();
+    const MeshCore::MeshKernel& kernel = mesh->getKernel();
     MeshCore::MeshEvalOrientation cMeshEval(kernel);
     std::vector<unsigned long> inds = cMeshEval.GetIndices();
     Py::Tuple tuple(inds.size());
@@ -1392,7 +1406,8 @@ PyObject*  MeshPy::splitEdge(PyObject *args)
     Base::Vector3d* val = pcObject->getVectorPtr();
     Base::Vector3f v((float)val->x,(float)val->y,(float)val->z);
 
-    const MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
+    const MeshObject* mesh = getMeshObjectPtr();
+    const MeshCore::MeshKernel& kernel = mesh->getKernel();
     PY_TRY {
         if (facet >= kernel.CountFacets()) {
             PyErr_SetString(PyExc_IndexError, "Facet index out of range");
@@ -1433,7 +1448,8 @@ PyObject*  MeshPy::splitFacet(PyObject *args)
     val = pcObject->getVectorPtr();
     Base::Vector3f v2((float)val->x,(float)val->y,(float)val->z);
 
-    const MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
+    const MeshObject* mesh = getMeshObjectPtr();
+    const MeshCore::MeshKernel& kernel = mesh->getKernel();
     PY_TRY {
         if (facet >= kernel.CountFacets()) {
             PyErr_SetString(PyExc_IndexError, "Facet index out of range");
@@ -1452,7 +1468,8 @@ PyObject*  MeshPy::swapEdge(PyObject *args)
     if (!PyArg_ParseTuple(args, "kk", &facet, &neighbour))
         return NULL;
 
-    const MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
+    const MeshObject* mesh = getMeshObjectPtr();
+    const MeshCore::MeshKernel& kernel = mesh->getKernel();
     PY_TRY {
         if (facet >= kernel.CountFacets()) {
             PyErr_SetString(PyExc_IndexError, "Facet index out of range");
@@ -1482,7 +1499,8 @@ PyObject*  MeshPy::collapseEdge(PyObject *args)
     if (!PyArg_ParseTuple(args, "kk", &facet, &neighbour))
         return NULL;
 
-    const MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
+    const MeshObject* mesh = getMeshObjectPtr();
+    const MeshCore::MeshKernel& kernel = mesh->getKernel();
     PY_TRY {
         if (facet >= kernel.CountFacets()) {
             PyErr_SetString(PyExc_IndexError, "Facet index out of range");
@@ -1626,7 +1644,8 @@ PyObject*  MeshPy::foraminate(PyObject *args)
                            (float)Py::Float(dir_t.getItem(2)));
 
         Base::Vector3f res;
-        MeshCore::MeshFacetIterator f_it(getMeshObjectPtr()->getKernel());
+        const MeshObject* mesh = getMeshObjectPtr();
+        MeshCore::MeshFacetIterator f_it(mesh->getKernel());
         int index = 0;
 
         Py::Dict dict;
@@ -1754,12 +1773,13 @@ PyObject*  MeshPy::smooth(PyObject *args, PyObject *kwds)
         else {
             throw Py::ValueError("No such smoothing algorithm");
         }
+        getMeshObjectPtr()->resetAdjacency();
     } PY_CATCH;
 
     Py_Return;
 }
 
-PyObject*  MeshPy::decimate(PyObject *args)
+PyObject*  MeshPy::decimate(PyObject *args, PyObject *kwds)
 {
     float fTol, fRed;
     if (PyArg_ParseTuple(args, "ff", &fTol,&fRed)) {
@@ -1772,15 +1792,20 @@ PyObject*  MeshPy::decimate(PyObject *args)
 
     PyErr_Clear();
     int targetSize;
-    if (PyArg_ParseTuple(args, "i", &targetSize)) {
+    float maxError = -1.0f;
+    static char* keywords_decimate[] = {"targetSize","maxError",NULL};
+    if (PyArg_ParseTupleAndKeywords(args, kwds, "i|f", keywords_decimate, &targetSize, &maxError)) {
         PY_TRY {
-            getMeshObjectPtr()->decimate(targetSize);
+            if (maxError < 0.0f)
+                getMeshObjectPtr()->decimate(targetSize);
+            else
+                getMeshObjectPtr()->decimate(targetSize, maxError);
         } PY_CATCH;
 
         Py_Return;
     }
 
-    PyErr_SetString(PyExc_ValueError, "decimate(tolerance=float, reduction=float) or decimate(targetSize=int)");
+    PyErr_SetString(PyExc_ValueError, "decimate(tolerance=float, reduction=float) or decimate(targetSize=int, [maxError=float])");
     return nullptr;
 }
 
@@ -1804,7 +1829,8 @@ PyObject* MeshPy::nearestFacetOnRay(PyObject *args)
 
         unsigned long index = 0;
         Base::Vector3f res;
-        MeshCore::MeshAlgorithm alg(getMeshObjectPtr()->getKernel());
+        const MeshObject* mesh = getMeshObjectPtr();
+        MeshCore::MeshAlgorithm alg(mesh->getKernel());
 
 #if 0 // for testing only
         MeshCore::MeshFacetGrid grid(getMeshObjectPtr()->getKernel(),10);
@@ -1884,7 +1910,8 @@ PyObject*  MeshPy::getSegmentsOfType(PyObject *args)
     char* type;
     float dev;
     unsigned long minFacets=0;
-    if (!PyArg_ParseTuple(args, "sf|k",&type,&dev,&minFacets))
+    PyObject *parallel = Py_False;
+    if (!PyArg_ParseTuple(args, "sf|kO!",&type,&dev,&minFacets,&PyBool_Type,&parallel))
         return NULL;
 
     Mesh::MeshObject::GeometryType geoType;
@@ -1904,7 +1931,7 @@ PyObject*  MeshPy::getSegmentsOfType(PyObject *args)
 
     Mesh::MeshObject* mesh = getMeshObjectPtr();
     std::vector<Mesh::Segment> segments = mesh->getSegmentsOfType
-        (geoType, dev, minFacets);
+        (geoType, dev, minFacets, PyObject_IsTrue(parallel) ? true : false);
 
     Py::List s;
     for (std::vector<Mesh::Segment>::iterator it = segments.begin(); it != segments.end(); ++it) {
@@ -1929,10 +1956,11 @@ PyObject*  MeshPy::getSegmentsByCurvature(PyObject *args)
     if (!PyArg_ParseTuple(args, "O",&l))
         return NULL;
 
-    const MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
+    const MeshObject* mesh = getMeshObjectPtr();
+    const MeshCore::MeshKernel& kernel = mesh->getKernel();
     MeshCore::MeshSegmentAlgorithm finder(kernel);
-    MeshCore::MeshCurvature meshCurv(kernel);
-    meshCurv.ComputePerVertex();
+    finder.SetParallel(true);
+    std::shared_ptr<const std::vector<MeshCore::CurvatureInfo> > curv = getMeshObjectPtr()->getCurvaturePerVertex();
 
     Py::Sequence func(l);
     std::vector<MeshCore::MeshSurfaceSegmentPtr> segm;
@@ -1947,7 +1975,7 @@ PyObject*  MeshPy::getSegmentsByCurvature(PyObject *args)
 #else
         int num = (int)Py::Int(t[4]);
 #endif
-        segm.emplace_back(std::make_shared<MeshCore::MeshCurvatureFreeformSegment>(meshCurv.GetCurvature(), num, tol1, tol2, c1, c2));
+        segm.emplace_back(std::make_shared<MeshCore::MeshCurvatureFreeformSegment>(*curv, num, tol1, tol2, c1, c2));
     }
 
     finder.FindSegments(segm);
@@ -1976,14 +2004,9 @@ PyObject* MeshPy::getCurvaturePerVertex(PyObject* args)
     if (!PyArg_ParseTuple(args, ""))
         return NULL;
 
-    const MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
-    MeshCore::MeshSegmentAlgorithm finder(kernel);
-    MeshCore::MeshCurvature meshCurv(kernel);
-    meshCurv.ComputePerVertex();
-
-    const std::vector<MeshCore::CurvatureInfo>& curv = meshCurv.GetCurvature();
+    std::shared_ptr<const std::vector<MeshCore::CurvatureInfo> > curv = getMeshObjectPtr()->getCurvaturePerVertex();
     Py::List list;
-    for (const auto& it : curv) {
+    for (const auto& it : *curv) {
         Py::Tuple tuple(4);
         tuple.setItem(0, Py::Float(it.fMaxCurvature));
         tuple.setItem(1, Py::Float(it.fMinCurvature));
@@ -184,6 +184,239 @@ class MeshGeoTestCases(unittest.TestCase):
         res=f1.intersect(f2)
         self.failUnless(len(res) == 0)
 
+class MeshSelfIntersectionTestCases(unittest.TestCase):
+    def setUp(self):
+        self.sphere = Mesh.createSphere(10.0, 50)
+
+    def testNoSelfIntersection(self):
+        self.assertFalse(self.sphere.hasSelfIntersections())
+        self.assertEqual(len(self.sphere.getSelfIntersections()), 0)
+
+    def testOverlappingSpheres(self):
+        other = self.sphere.copy()
+        other.translate(15.0, 0.0, 0.0)
+        self.sphere.addMesh(other)
+        self.assertTrue(self.sphere.hasSelfIntersections())
+
+        # every pair is reported once, in ascending order
+        pairs = [(i[0], i[1]) for i in self.sphere.getSelfIntersections()]
+        self.assertGreater(len(pairs), 0)
+        self.assertEqual(pairs, sorted(set(pairs)))
+        count = self.sphere.CountFacets // 2
+        for i, j in pairs:
+            self.assertLess(i, count)
+            self.assertGreaterEqual(j, count)
+
+        self.sphere.fixSelfIntersections()
+        self.assertFalse(self.sphere.hasSelfIntersections())
+
+class MeshDuplicateTestCases(unittest.TestCase):
+    def setUp(self):
+        self.sphere = Mesh.createSphere(10.0, 50)
+
+    def testDuplicatedPointsAndFacets(self):
+        points = self.sphere.CountPoints
+        facets = self.sphere.CountFacets
+        self.sphere.addMesh(self.sphere.copy())
+        self.assertEqual(self.sphere.CountPoints, 2 * points)
+
+        # the copies are merged into the points with the lower index
+        self.sphere.removeDuplicatedPoints()
+        self.assertEqual(self.sphere.CountPoints, points)
+        self.assertEqual(self.sphere.CountFacets, 2 * facets)
+
+        self.sphere.removeDuplicatedFacets()
+        self.assertEqual(self.sphere.CountFacets, facets)
+        self.assertTrue(self.sphere.isSolid())
+
+    def testMergePointsOnBuild(self):
+        # every triangle brings its own points, the builder merges them
+        triangles = [f.Points for f in self.sphere.Facets]
+        # a degenerated triangle gets dropped
+        triangles.append([triangles[0][0], triangles[0][0], triangles[0][1]])
+        mesh = Mesh.Mesh(triangles)
+        self.assertEqual(mesh.CountPoints, self.sphere.CountPoints)
+        self.assertEqual(mesh.CountFacets, self.sphere.CountFacets)
+        self.assertTrue(mesh.isSolid())
+
+class MeshDecimateTestCases(unittest.TestCase):
+    def setUp(self):
+        self.sphere = Mesh.createSphere(10.0, 200)
+
+    def testConcurrentDecimation(self):
+        count = self.sphere.CountFacets
+        self.sphere.decimate(targetSize=count // 10, maxError=1.0)
+        self.assertLess(self.sphere.CountFacets, count // 5)
+        for p in self.sphere.Points:
+            self.assertAlmostEqual(p.Vector.Length, 10.0, delta=1.0)
+
+    def testConcurrentDecimationMaxError(self):
+        count = self.sphere.CountFacets
+        self.sphere.decimate(targetSize=count // 10, maxError=0.0001)
+        self.assertGreater(self.sphere.CountFacets, count // 2)
+
+class MeshSmoothingTestCases(unittest.TestCase):
+    def setUp(self):
+        self.sphere = Mesh.createSphere(10.0, 50)
+
+    def testLaplace(self):
+        self.sphere.smooth(Method="Laplace", Iteration=10)
+        for p in self.sphere.Points:
+            self.assertLess(p.Vector.Length, 10.0)
+
+    def testTaubin(self):
+        before = self.sphere.copy()
+        self.sphere.smooth(Method="Laplace", Iteration=10)
+        laplace = self.sphere.Volume
+        self.sphere = before
+        self.sphere.smooth(Method="Taubin", Iteration=10)
+        self.assertGreater(self.sphere.Volume, laplace)
+
+class MeshSegmentationTestCases(unittest.TestCase):
+    def setUp(self):
+        # two planes folded along x = 50, large enough to be split into several blocks
+        def point(i, j):
+            return (i, j, 0.0 if i <= 50 else (i - 50) * 0.5)
+        triangles = []
+        for i in range(100):
+            for j in range(60):
+                triangles.append([point(i, j), point(i+1, j), point(i+1, j+1)])
+                triangles.append([point(i, j), point(i+1, j+1), point(i, j+1)])
+        self.mesh = Mesh.Mesh(triangles)
+
+    def testPlanarSegments(self):
+        serial = self.mesh.getSegmentsOfType("Plane", 0.01, 10)
+        parallel = self.mesh.getSegmentsOfType("Plane", 0.01, 10, True)
+        self.assertEqual(len(serial), 2)
+        self.assertEqual(len(parallel), 2)
+        self.assertEqual(sorted(map(sorted, serial)), sorted(map(sorted, parallel)))
+
+class MeshCurvatureTestCases(unittest.TestCase):
+    def setUp(self):
+        self.sphere = Mesh.createSphere(10.0, 50)
+
+    def testSphereCurvature(self):
+        curv = self.sphere.getCurvaturePerVertex()
+        self.assertEqual(len(curv), self.sphere.CountPoints)
+        for c in curv:
+            self.assertAlmostEqual(abs(c[0]), 0.1, delta=0.01)
+            self.assertAlmostEqual(abs(c[1]), 0.1, delta=0.01)
+
+    def testCurvatureUpdate(self):
+        # moving a point drops the cached curvature
+        index = self.sphere.CountPoints // 2
+        pnt = self.sphere.Points[index]
+        orig = FreeCAD.Vector(pnt.x, pnt.y, pnt.z)
+        before = self.sphere.getCurvaturePerVertex()[index]
+        self.sphere.setPoint(index, orig * 1.2)
+        moved = self.sphere.getCurvaturePerVertex()[index]
+        self.assertNotAlmostEqual(before[0], moved[0], places=3)
+        self.sphere.setPoint(index, orig)
+        restored = self.sphere.getCurvaturePerVertex()[index]
+        self.assertAlmostEqual(before[0], restored[0], places=5)
+        self.assertAlmostEqual(before[1], restored[1], places=5)
+
+        mat = FreeCAD.Matrix()
+        mat.scale(2.0, 2.0, 2.0)
+        self.sphere.transform(mat)
+        for c in self.sphere.getCurvaturePerVertex():
+            self.assertAlmostEqual(abs(c[0]), 0.05, delta=0.005)
+
+    def testCurvatureAfterSmoothing(self):
+        # smoothing modifies the kernel directly and must drop the cached curvature
+        before = sum(abs(c[0]) for c in self.sphere.getCurvaturePerVertex())
+        self.sphere.smooth("Laplace", 5)
+        after = sum(abs(c[0]) for c in self.sphere.getCurvaturePerVertex())
+        self.assertNotAlmostEqual(before, after, places=3)
+
+class MeshBooleanTestCases(unittest.TestCase):
+    def setUp(self):
+        self.box1 = Mesh.createBox(1.0, 1.0, 1.0)
+        self.box2 = Mesh.createBox(1.0, 1.0, 1.0)
+        # shares the coplanar faces y=-0.5, y=0.5, z=-0.5 and z=0.5 with the first box
+        self.box2.translate(0.5, 0.0, 0.0)
+
+    def testRobustCoplanar(self):
+        union = self.box1.unite(self.box2, True)
+        inter = self.box1.intersect(self.box2, True)
+        diff = self.box1.difference(self.box2, True)
+        self.assertTrue(union.isSolid())
+        self.assertTrue(inter.isSolid())
+        self.assertTrue(diff.isSolid())
+        self.assertAlmostEqual(union.Volume, 1.5, places=5)
+        self.assertAlmostEqual(inter.Volume, 0.5, places=5)
+        self.assertAlmostEqual(diff.Volume, 0.5, places=5)
+
+    def testRobustSpheres(self):
+        sphere1 = Mesh.createSphere(10.0, 50)
+        sphere2 = Mesh.createSphere(8.0, 50)
+        sphere2.translate(7.0, 2.0, 1.0)
+        union = sphere1.unite(sphere2, True)
+        inter = sphere1.intersect(sphere2, True)
+        diff = sphere1.difference(sphere2, True)
+        self.assertTrue(union.isSolid())
+        self.assertAlmostEqual(union.Volume + inter.Volume, sphere1.Volume + sphere2.Volume, delta=0.01)
+        self.assertAlmostEqual(diff.Volume, sphere1.Volume - inter.Volume, delta=0.01)
+
+class MeshChunkedTestCases(unittest.TestCase):
+    def setUp(self):
+        self.sphere = Mesh.createSphere(10.0, 100)
+        self.path = tempfile.gettempdir() + os.sep
+        self.files = [self.path + name for name in ("chunked.stl", "chunked.fcmc", "chunked2.fcmc", "chunked2.stl")]
+        self.sphere.write(self.files[0])
+
+    def testChunkedRoundTrip(self):
+        Mesh.createChunked(self.files[0], self.files[1], 2000)
+        info = Mesh.evaluateChunked(self.files[1])
+        self.assertGreater(info["CountChunks"], 1)
+        self.assertEqual(info["CountFacets"], self.sphere.CountFacets)
+        self.assertEqual(info["CountPoints"], self.sphere.CountPoints)
+        self.assertEqual(info["BorderEdges"], 0)
+        self.assertAlmostEqual(info["Area"], self.sphere.Area, delta=self.sphere.Area * 1e-3)
+        self.assertAlmostEqual(info["Volume"], self.sphere.Volume, delta=self.sphere.Volume * 1e-3)
+
+        mesh = Mesh.readChunked(self.files[1])
+        self.assertEqual(mesh.CountFacets, self.sphere.CountFacets)
+        self.assertEqual(mesh.CountPoints, self.sphere.CountPoints)
+        self.assertTrue(mesh.isSolid())
+
+    def testChunkedDenseRegion(self):
+        # the sphere falls into a single cell of the bounding box grid
+        mesh = Mesh.createBox(1, 1, 1)
+        mesh.translate(1000, 1000, 1000)
+        mesh.addMesh(self.sphere)
+        mesh.write(self.files[3])
+        Mesh.createChunked(self.files[3], self.files[1], 2000)
+        info = Mesh.evaluateChunked(self.files[1])
+        self.assertGreaterEqual(info["CountChunks"], (mesh.CountFacets + 1999) // 2000)
+        self.assertEqual(info["CountFacets"], mesh.CountFacets)
+        self.assertEqual(info["CountPoints"], mesh.CountPoints)
+        self.assertEqual(info["BorderEdges"], 0)
+
+    def testChunkedProcessing(self):
+        Mesh.createChunked(self.files[0], self.files[1], 2000)
+        mat = FreeCAD.Matrix()
+        mat.scale(2, 2, 2)
+        Mesh.transformChunked(self.files[1], self.files[2], mat)
+        info = Mesh.evaluateChunked(self.files[2])
+        self.assertAlmostEqual(info["Area"], 4 * self.sphere.Area, delta=self.sphere.Area * 4e-3)
+
+        Mesh.decimateChunked(self.files[1], self.files[2], 0.5)
+        info = Mesh.evaluateChunked(self.files[2])
+        self.assertLess(info["CountFacets"], self.sphere.CountFacets * 3 // 4)
+        self.assertEqual(info["BorderEdges"], 0)
+
+        Mesh.smoothChunked(self.files[1], self.files[2], 2)
+        Mesh.exportChunked(self.files[2], self.files[3])
+        mesh = Mesh.Mesh(self.files[3])
+        self.assertEqual(mesh.CountFacets, self.sphere.CountFacets)
+        self.assertTrue(mesh.isSolid())
+
+    def tearDown(self):
+        for name in self.files:
+            if os.path.exists(name):
+                os.remove(name)
+
 class PivyTestCases(unittest.TestCase):
     def setUp(self):
         # set up a planar face with 2 triangles
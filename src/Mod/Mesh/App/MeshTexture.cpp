@@ -42,7 +42,7 @@ MeshTexture::MeshTexture(const Mesh::MeshObject& mesh, const MeshCore::Material
     else if (material.binding == MeshCore::MeshIO::PER_FACE && material.diffuseColor.size() == countFacets) {
         binding = MeshCore::MeshIO::PER_FACE;
         kdTree.reset(new MeshCore::MeshKDTree(mesh.getKernel().GetPoints()));
-        refPnt2Fac.reset(new MeshCore::MeshRefPointToFacets(mesh.getKernel()));
+        refPnt2Fac = mesh.getPointToFacets();
     }
 }
 
@@ -89,7 +89,7 @@ private:
     const MeshCore::Material &materialRefMesh;
     unsigned long countPointsRefMesh;
     std::unique_ptr<MeshCore::MeshKDTree> kdTree;
-    std::unique_ptr<MeshCore::MeshRefPointToFacets> refPnt2Fac;
+    std::shared_ptr<const MeshCore::MeshCompactPointToFacets> refPnt2Fac;
     MeshCore::MeshIO::Binding binding = MeshCore::MeshIO::OVERALL;
 };
 
@@ -74,33 +74,40 @@ void Segmentation::accept()
     // make a copy because we might smooth the mesh before
     MeshCore::MeshKernel kernel = mesh->getKernel();
 
+    // use the cached curvature of the mesh unless it gets smoothed
+    std::shared_ptr<const std::vector<MeshCore::CurvatureInfo> > curvature;
     if (ui->checkBoxSmooth->isChecked()) {
         MeshCore::LaplaceSmoothing smoother(kernel);
         smoother.Smooth(ui->smoothSteps->value());
+        MeshCore::MeshCurvature meshCurv(kernel);
+        meshCurv.ComputePerVertex();
+        curvature = std::make_shared<std::vector<MeshCore::CurvatureInfo> >(meshCurv.GetCurvature());
+    }
+    else {
+        curvature = mesh->getCurvaturePerVertex();
     }
 
     MeshCore::MeshSegmentAlgorithm finder(kernel);
-    MeshCore::MeshCurvature meshCurv(kernel);
-    meshCurv.ComputePerVertex();
+    finder.SetParallel(true);
 
     std::vector<MeshCore::MeshSurfaceSegmentPtr> segm;
     if (ui->groupBoxFree->isChecked()) {
         segm.emplace_back(std::make_shared<MeshCore::MeshCurvatureFreeformSegment>
-            (meshCurv.GetCurvature(), ui->numFree->value(),
+            (*curvature, ui->numFree->value(),
              ui->tol1Free->value(), ui->tol2Free->value(),
              ui->crv1Free->value(), ui->crv2Free->value()));
     }
     if (ui->groupBoxCyl->isChecked()) {
         segm.emplace_back(std::make_shared<MeshCore::MeshCurvatureCylindricalSegment>
-            (meshCurv.GetCurvature(), ui->numCyl->value(), ui->tol1Cyl->value(), ui->tol2Cyl->value(), ui->crvCyl->value()));
+            (*curvature, ui->numCyl->value(), ui->tol1Cyl->value(), ui->tol2Cyl->value(), ui->crvCyl->value()));
     }
     if (ui->groupBoxSph->isChecked()) {
         segm.emplace_back(std::make_shared<MeshCore::MeshCurvatureSphericalSegment>
-            (meshCurv.GetCurvature(), ui->numSph->value(), ui->tolSph->value(), ui->crvSph->value()));
+            (*curvature, ui->numSph->value(), ui->tolSph->value(), ui->crvSph->value()));
     }
     if (ui->groupBoxPln->isChecked()) {
         segm.emplace_back(std::make_shared<MeshCore::MeshCurvaturePlanarSegment>
-            (meshCurv.GetCurvature(), ui->numPln->value(), ui->tolPln->value()));
+            (*curvature, ui->numPln->value(), ui->tolPln->value()));
     }
     finder.FindSegments(segm);
 
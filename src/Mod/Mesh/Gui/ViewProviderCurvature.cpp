@@ -338,18 +338,24 @@ void ViewProviderMeshCurvature::setVertexCurvatureMode(int mode)
     if ( !pCurvInfo )
         return; // cannot display this feature type due to missing curvature property
 
-    // curvature values
+    // curvature values, set at once to avoid a notification per vertex
     std::vector<float> fValues = pCurvInfo->getCurvature( mode ); 
+    pcColorMat->diffuseColor.setNum((int)fValues.size());
+    pcColorMat->transparency.setNum((int)fValues.size());
+    SbColor* diffcol = pcColorMat->diffuseColor.startEditing();
+    float* transp = pcColorMat->transparency.startEditing();
     unsigned long j=0;
     for ( std::vector<float>::const_iterator jt = fValues.begin(); jt != fValues.end(); ++jt, j++ ) {
         App::Color col = pcColorBar->getColor( *jt );
-        pcColorMat->diffuseColor.set1Value(j, SbColor(col.r, col.g, col.b));
+        diffcol[j].setValue(col.r, col.g, col.b);
         if ( pcColorBar->isVisible( *jt ) ) {
-            pcColorMat->transparency.set1Value(j, 0.0f);
+            transp[j] = 0.0f;
         } else {
-            pcColorMat->transparency.set1Value(j, 0.8f);
+            transp[j] = 0.8f;
         }
     }
+    pcColorMat->diffuseColor.finishEditing();
+    pcColorMat->transparency.finishEditing();
 }
 
 QIcon ViewProviderMeshCurvature::getIcon() const
@@ -0,0 +1,161 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <cstdlib>
+# include <Standard_Version.hxx>
+# include <BRepAlgoAPI_BooleanOperation.hxx>
+# include <BRepBuilderAPI_Copy.hxx>
+# if OCC_VERSION_HEX >= 0x060900
+#  include <BRepAlgoAPI_BuilderAlgo.hxx>
+# endif
+# include <TopTools_ListOfShape.hxx>
+#endif
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/Parameter.h>
+
+#include "BooleanOptions.h"
+#include "TopoShape.h"
+
+using namespace Part;
+
+BooleanOptions::BooleanOptions()
+  : runParallel(true)
+  , useOBB(false)
+  , glue(GlueOff)
+  , fuzzyValue(0.0)
+  , nonDestructive(false)
+{
+}
+
+BooleanOptions BooleanOptions::fromParameters()
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+        .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Part/Boolean");
+
+    BooleanOptions options;
+    options.runParallel = hGrp->GetBool("RunParallel", options.runParallel);
+    options.useOBB = hGrp->GetBool("UseOBB", options.useOBB);
+    options.fuzzyValue = hGrp->GetFloat("FuzzyValue", options.fuzzyValue);
+    options.nonDestructive = hGrp->GetBool("NonDestructive", options.nonDestructive);
+    return options;
+}
+
+BooleanOptions BooleanOptions::fromDocument(const App::Document* doc)
+{
+    BooleanOptions options = fromParameters();
+    if (!doc)
+        return options;
+
+    const std::map<std::string, std::string>& meta = doc->Meta.getValues();
+    auto getValue = [&meta](const char* name, std::string& value) {
+        auto it = meta.find(std::string("Part/Boolean/") + name);
+        if (it == meta.end() || it->second.empty())
+            return false;
+        value = it->second;
+        return true;
+    };
+    auto toBool = [](const std::string& value) {
+        return value == "1" || value == "true" || value == "True";
+    };
+
+    std::string value;
+    if (getValue("RunParallel", value))
+        options.runParallel = toBool(value);
+    if (getValue("UseOBB", value))
+        options.useOBB = toBool(value);
+    if (getValue("FuzzyValue", value))
+        options.fuzzyValue = std::atof(value.c_str());
+    if (getValue("NonDestructive", value))
+        options.nonDestructive = toBool(value);
+    return options;
+}
+
+void BooleanOptions::apply(BRepAlgoAPI_BuilderAlgo& mkAlgo) const
+{
+#if OCC_VERSION_HEX < 0x060900
+    (void)mkAlgo;
+#else
+    mkAlgo.SetRunParallel(runParallel ? Standard_True : Standard_False);
+    if (fuzzyValue > 0.0)
+        mkAlgo.SetFuzzyValue(fuzzyValue);
+#endif
+#if OCC_VERSION_HEX >= 0x070000
+    if (nonDestructive)
+        mkAlgo.SetNonDestructive(Standard_True);
+#endif
+#if OCC_VERSION_HEX >= 0x070100
+    switch (glue) {
+    case GlueShift:
+        mkAlgo.SetGlue(BOPAlgo_GlueShift);
+        break;
+    case GlueFull:
+        mkAlgo.SetGlue(BOPAlgo_GlueFull);
+        break;
+    default:
+        break;
+    }
+#endif
+#if OCC_VERSION_HEX >= 0x070300
+    mkAlgo.SetUseOBB(useOBB ? Standard_True : Standard_False);
+#endif
+}
+
+void BooleanOptions::build(BRepAlgoAPI_BooleanOperation& mkBool, const TopoDS_Shape& argument,
+                           const std::vector<TopoDS_Shape>& tools) const
+{
+    if (argument.IsNull())
+        throw NullShapeException("Base shape is null");
+#if OCC_VERSION_HEX < 0x060900
+    (void)mkBool;
+    (void)tools;
+    throw Base::RuntimeError("Boolean options are available only in OCC 6.9.0 and up.");
+#else
+    TopTools_ListOfShape shapeArguments, shapeTools;
+    shapeArguments.Append(argument);
+    for (std::vector<TopoDS_Shape>::const_iterator it = tools.begin(); it != tools.end(); ++it) {
+        if (it->IsNull())
+            throw NullShapeException("Tool shape is null");
+        if (fuzzyValue > 0.0)
+            // workaround for http://dev.opencascade.org/index.php?q=node/1056#comment-520
+            shapeTools.Append(BRepBuilderAPI_Copy(*it).Shape());
+        else
+            shapeTools.Append(*it);
+    }
+
+    mkBool.SetArguments(shapeArguments);
+    mkBool.SetTools(shapeTools);
+    apply(mkBool);
+#if OCC_VERSION_HEX >= 0x070000
+    // a fuzzy operation must not change the tolerances of the argument, it
+    // usually is the shape of another feature
+    if (fuzzyValue > 0.0)
+        mkBool.SetNonDestructive(Standard_True);
+#endif
+    mkBool.Build();
+#endif
+}
@@ -0,0 +1,90 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef PART_BOOLEANOPTIONS_H
+#define PART_BOOLEANOPTIONS_H
+
+#include <vector>
+#include <TopoDS_Shape.hxx>
+
+class BRepAlgoAPI_BuilderAlgo;
+class BRepAlgoAPI_BooleanOperation;
+
+namespace App {
+class Document;
+}
+
+namespace Part
+{
+
+/**
+ * @brief The BooleanOptions class holds the settings of the OCC boolean
+ * algorithms used by the Part and PartDesign features.
+ *
+ * The defaults are read from the user parameters in
+ * BaseApp/Preferences/Mod/Part/Boolean. A document can override each of them
+ * with an entry of its Meta property, e.g. "Part/Boolean/UseOBB" = "1".
+ * The glue mode is not read from there: gluing arguments that overlap gives
+ * wrong results, so only a feature that knows its arguments only touch may
+ * set it for its own operation.
+ */
+class PartExport BooleanOptions
+{
+public:
+    enum GlueMode {
+        GlueOff = 0,
+        GlueShift = 1, ///< arguments touch with shared or partially coinciding faces
+        GlueFull = 2   ///< arguments only share sub-shapes
+    };
+
+    BooleanOptions();
+
+    /// The options of the user parameters
+    static BooleanOptions fromParameters();
+    /// The options of the user parameters overridden by the ones of \a doc
+    static BooleanOptions fromDocument(const App::Document* doc);
+
+    /// Sets the options to \a mkAlgo, it doesn't change its arguments
+    void apply(BRepAlgoAPI_BuilderAlgo& mkAlgo) const;
+    /**
+     * Runs \a mkBool with the options on \a argument and \a tools. Whether the
+     * operation succeeded must be checked with IsDone() afterwards.
+     * With a fuzzy value the tools are copied and \a argument is kept unchanged,
+     * so the shapes of other features don't get modified tolerances.
+     * Throws Base::RuntimeError if OCC is too old to set the arguments of a
+     * boolean operation.
+     */
+    void build(BRepAlgoAPI_BooleanOperation& mkBool, const TopoDS_Shape& argument,
+               const std::vector<TopoDS_Shape>& tools) const;
+
+    bool runParallel;
+    bool useOBB;
+    GlueMode glue;
+    double fuzzyValue;
+    bool nonDestructive;
+};
+
+} //namespace Part
+
+#endif // PART_BOOLEANOPTIONS_H
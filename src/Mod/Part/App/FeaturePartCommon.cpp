@@ -24,7 +24,9 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <memory>
 # include <BRepAlgoAPI_Common.hxx>
+# include <Standard_Version.hxx>
 # include <BRepCheck_Analyzer.hxx>
 # include <Standard_Failure.hxx>
 # include <TopoDS_Iterator.hxx>
@@ -34,6 +36,7 @@
 
 
 #include "FeaturePartCommon.h"
+#include "BooleanOptions.h"
 #include "modelRefine.h"
 #include <App/Application.h>
 #include <Base/Parameter.h>
@@ -51,7 +54,13 @@ Common::Common(void)
 BRepAlgoAPI_BooleanOperation* Common::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
 {
     // Let's call algorithm computing a section operation:
+#if OCC_VERSION_HEX < 0x060900
     return new BRepAlgoAPI_Common(base, tool);
+#else
+    std::unique_ptr<BRepAlgoAPI_Common> mkCommon(new BRepAlgoAPI_Common());
+    BooleanOptions::fromDocument(getDocument()).build(*mkCommon, base, std::vector<TopoDS_Shape>(1, tool));
+    return mkCommon.release();
+#endif
 }
 
 // ----------------------------------------------------
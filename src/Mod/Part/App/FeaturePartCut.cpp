@@ -23,11 +23,14 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <memory>
 # include <BRepAlgoAPI_Cut.hxx>
+# include <Standard_Version.hxx>
 #endif
 
 
 #include "FeaturePartCut.h"
+#include "BooleanOptions.h"
 
 #include <Base/Exception.h>
 
@@ -43,5 +46,11 @@ Cut::Cut(void)
 BRepAlgoAPI_BooleanOperation* Cut::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
 {
     // Let's call algorithm computing a cut operation:
+#if OCC_VERSION_HEX < 0x060900
     return new BRepAlgoAPI_Cut(base, tool);
+#else
+    std::unique_ptr<BRepAlgoAPI_Cut> mkCut(new BRepAlgoAPI_Cut());
+    BooleanOptions::fromDocument(getDocument()).build(*mkCut, base, std::vector<TopoDS_Shape>(1, tool));
+    return mkCut.release();
+#endif
 }
@@ -23,7 +23,9 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <memory>
 # include <BRepAlgoAPI_Fuse.hxx>
+# include <Standard_Version.hxx>
 # include <BRepCheck_Analyzer.hxx>
 # include <Standard_Failure.hxx>
 # include <TopoDS_Iterator.hxx>
@@ -33,6 +35,7 @@
 
 
 #include "FeaturePartFuse.h"
+#include "BooleanOptions.h"
 #include "modelRefine.h"
 #include <App/Application.h>
 #include <Base/Parameter.h>
@@ -50,7 +53,13 @@ Fuse::Fuse(void)
 BRepAlgoAPI_BooleanOperation* Fuse::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
 {
     // Let's call algorithm computing a fuse operation:
+#if OCC_VERSION_HEX < 0x060900
     return new BRepAlgoAPI_Fuse(base, tool);
+#else
+    std::unique_ptr<BRepAlgoAPI_Fuse> mkFuse(new BRepAlgoAPI_Fuse());
+    BooleanOptions::fromDocument(getDocument()).build(*mkFuse, base, std::vector<TopoDS_Shape>(1, tool));
+    return mkFuse.release();
+#endif
 }
 
 // ----------------------------------------------------
@@ -141,21 +150,18 @@ App::DocumentObjectExecReturn *MultiFuse::execute(void)
             }
 #else
             BRepAlgoAPI_Fuse mkFuse;
-            TopTools_ListOfShape shapeArguments,shapeTools;
             const TopoDS_Shape& shape = s.front();
             if (shape.IsNull())
                 throw Base::RuntimeError("Input shape is null");
-            shapeArguments.Append(shape);
 
+            std::vector<TopoDS_Shape> tools;
             for (std::vector<TopoDS_Shape>::iterator it = s.begin()+1; it != s.end(); ++it) {
                 if (it->IsNull())
                     throw Base::RuntimeError("Input shape is null");
-                shapeTools.Append(*it);
+                tools.push_back(*it);
             }
 
-            mkFuse.SetArguments(shapeArguments);
-            mkFuse.SetTools(shapeTools);
-            mkFuse.Build();
+            BooleanOptions::fromDocument(getDocument()).build(mkFuse, shape, tools);
             if (!mkFuse.IsDone())
                 throw Base::RuntimeError("MultiFusion failed");
 
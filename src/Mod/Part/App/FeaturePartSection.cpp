@@ -28,6 +28,7 @@
 #endif
 
 #include "FeaturePartSection.h"
+#include "BooleanOptions.h"
 
 #include <Base/Exception.h>
 
@@ -56,10 +57,8 @@ BRepAlgoAPI_BooleanOperation* Section::makeOperation(const TopoDS_Shape& base, c
 #else
     bool approx = Approximation.getValue();
     std::unique_ptr<BRepAlgoAPI_Section> mkSection(new BRepAlgoAPI_Section());
-    mkSection->Init1(base);
-    mkSection->Init2(tool);
     mkSection->Approximation(approx);
-    mkSection->Build();
+    BooleanOptions::fromDocument(getDocument()).build(*mkSection, base, std::vector<TopoDS_Shape>(1, tool));
     if (!mkSection->IsDone())
         throw Base::RuntimeError("Section failed");
     return mkSection.release();
@@ -75,6 +75,7 @@
 
 // QT
 #include <QtGlobal>
+#include <QtConcurrentMap>
 
 // Boost
 #include <boost_signals2.hpp>
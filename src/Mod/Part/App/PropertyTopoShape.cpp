@@ -189,6 +189,19 @@ unsigned int PropertyPartShape::getMemSize (void) const
     return _Shape.getMemSize();
 }
 
+const std::string& PropertyPartShape::getContentHash() const
+{
+    if (_ContentHash.empty())
+        _ContentHash = _Shape.getContentHash();
+    return _ContentHash;
+}
+
+void PropertyPartShape::aboutToSetValue(void)
+{
+    _ContentHash.clear();
+    PropertyComplexGeoData::aboutToSetValue();
+}
+
 void PropertyPartShape::getPaths(std::vector<App::ObjectIdentifier> &paths) const
 {
     paths.push_back(App::ObjectIdentifier(getContainer()) << App::ObjectIdentifier::Component::SimpleComponent(getName())
@@ -55,6 +55,8 @@ public:
     const TopoDS_Shape& getValue(void) const;
     const TopoShape& getShape() const;
     const Data::ComplexGeoData* getComplexData() const;
+    /// get the content hash of the shape, computed once per value
+    const std::string& getContentHash() const;
     //@}
 
     /** @name Modification */
@@ -91,8 +93,12 @@ public:
     /// Get valid paths for this property; used by auto completer
     virtual void getPaths(std::vector<App::ObjectIdentifier> & paths) const;
 
+protected:
+    virtual void aboutToSetValue(void);
+
 private:
     TopoShape _Shape;
+    mutable std::string _ContentHash;
 };
 
 struct PartExport ShapeHistory {
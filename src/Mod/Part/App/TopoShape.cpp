@@ -27,7 +27,9 @@
 # include <algorithm>
 # include <array>
 # include <cmath>
+# include <cstdint>
 # include <cstdlib>
+# include <iomanip>
 # include <sstream>
 # include <QString>
 
@@ -214,6 +216,7 @@
 #include "encodeFilename.h"
 #include "FaceMakerBullseye.h"
 #include "BRepOffsetAPI_MakeOffsetFix.h"
+#include "BooleanOptions.h"
 
 FC_LOG_LEVEL_INIT("TopoShape",true,true)
 
@@ -1809,6 +1812,59 @@ bool TopoShape::isClosed() const
     return closed;
 }
 
+namespace {
+// Stream buffer computing a 64 bit FNV-1a hash of everything written to it.
+// std::hash is not guaranteed to be stable between builds.
+class HashStreamBuf : public std::streambuf
+{
+public:
+    HashStreamBuf() : hash(14695981039346656037ULL) {}
+    uint64_t getHash() const { return hash; }
+
+protected:
+    int_type overflow(int_type c) override
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+            add(traits_type::to_char_type(c));
+        return traits_type::not_eof(c);
+    }
+    std::streamsize xsputn(const char* s, std::streamsize n) override
+    {
+        for (std::streamsize i = 0; i < n; ++i)
+            add(s[i]);
+        return n;
+    }
+
+private:
+    void add(char c)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    uint64_t hash;
+};
+}
+
+std::string TopoShape::getContentHash() const
+{
+    if (this->_Shape.IsNull())
+        return std::string();
+
+    // Same data as BRepTools::Write() but without the triangulations, and
+    // streamed into the hash instead of a string
+    HashStreamBuf buf;
+    std::ostream out(&buf);
+    BRepTools_ShapeSet shapeSet(Standard_False);
+    shapeSet.Add(this->_Shape);
+    shapeSet.Write(out);
+    shapeSet.Write(this->_Shape, out);
+    out.flush();
+
+    std::stringstream str;
+    str << std::hex << std::setw(16) << std::setfill('0') << buf.getHash();
+    return str.str();
+}
+
 TopoDS_Shape TopoShape::cut(TopoDS_Shape shape) const
 {
     if (this->_Shape.IsNull())
@@ -1820,33 +1876,24 @@ TopoDS_Shape TopoShape::cut(TopoDS_Shape shape) const
 }
 
 TopoDS_Shape TopoShape::cut(const std::vector<TopoDS_Shape>& shapes, Standard_Real tolerance) const
+{
+    BooleanOptions options;
+    if (tolerance > 0.0)
+        options.fuzzyValue = tolerance;
+    return cut(shapes, options);
+}
+
+TopoDS_Shape TopoShape::cut(const std::vector<TopoDS_Shape>& shapes, const BooleanOptions& options) const
 {
     if (this->_Shape.IsNull())
         Standard_Failure::Raise("Base shape is null");
 #if OCC_VERSION_HEX < 0x060900
     (void)shapes;
-    (void)tolerance;
+    (void)options;
     throw Base::RuntimeError("Multi cut is available only in OCC 6.9.0 and up.");
 #else
     BRepAlgoAPI_Cut mkCut;
-    mkCut.SetRunParallel(true);
-    TopTools_ListOfShape shapeArguments,shapeTools;
-    shapeArguments.Append(this->_Shape);
-    for (std::vector<TopoDS_Shape>::const_iterator it = shapes.begin(); it != shapes.end(); ++it) {
-        if (it->IsNull())
-            throw Base::ValueError("Tool shape is null");
-        if (tolerance > 0.0)
-            // workaround for http://dev.opencascade.org/index.php?q=node/1056#comment-520
-            shapeTools.Append(BRepBuilderAPI_Copy(*it).Shape());
-        else
-            shapeTools.Append(*it);
-    }
-
-    mkCut.SetArguments(shapeArguments);
-    mkCut.SetTools(shapeTools);
-    if (tolerance > 0.0)
-        mkCut.SetFuzzyValue(tolerance);
-    mkCut.Build();
+    options.build(mkCut, this->_Shape, shapes);
     if (!mkCut.IsDone())
         throw Base::RuntimeError("Multi cut failed");
 
@@ -1866,33 +1913,24 @@ TopoDS_Shape TopoShape::common(TopoDS_Shape shape) const
 }
 
 TopoDS_Shape TopoShape::common(const std::vector<TopoDS_Shape>& shapes, Standard_Real tolerance) const
+{
+    BooleanOptions options;
+    if (tolerance > 0.0)
+        options.fuzzyValue = tolerance;
+    return common(shapes, options);
+}
+
+TopoDS_Shape TopoShape::common(const std::vector<TopoDS_Shape>& shapes, const BooleanOptions& options) const
 {
     if (this->_Shape.IsNull())
         Standard_Failure::Raise("Base shape is null");
 #if OCC_VERSION_HEX < 0x060900
     (void)shapes;
-    (void)tolerance;
+    (void)options;
     throw Base::RuntimeError("Multi common is available only in OCC 6.9.0 and up.");
 #else
     BRepAlgoAPI_Common mkCommon;
-    mkCommon.SetRunParallel(true);
-    TopTools_ListOfShape shapeArguments,shapeTools;
-    shapeArguments.Append(this->_Shape);
-    for (std::vector<TopoDS_Shape>::const_iterator it = shapes.begin(); it != shapes.end(); ++it) {
-        if (it->IsNull())
-            throw Base::ValueError("Tool shape is null");
-        if (tolerance > 0.0)
-            // workaround for http://dev.opencascade.org/index.php?q=node/1056#comment-520
-            shapeTools.Append(BRepBuilderAPI_Copy(*it).Shape());
-        else
-            shapeTools.Append(*it);
-    }
-
-    mkCommon.SetArguments(shapeArguments);
-    mkCommon.SetTools(shapeTools);
-    if (tolerance > 0.0)
-        mkCommon.SetFuzzyValue(tolerance);
-    mkCommon.Build();
+    options.build(mkCommon, this->_Shape, shapes);
     if (!mkCommon.IsDone())
         throw Base::RuntimeError("Multi common failed");
 
@@ -1913,14 +1951,12 @@ TopoDS_Shape TopoShape::fuse(TopoDS_Shape shape) const
 
 TopoDS_Shape TopoShape::fuse(const std::vector<TopoDS_Shape>& shapes, Standard_Real tolerance) const
 {
+#if OCC_VERSION_HEX < 0x060900
     if (this->_Shape.IsNull())
         Standard_Failure::Raise("Base shape is null");
-#if OCC_VERSION_HEX <= 0x060800
     if (tolerance > 0.0)
         Standard_Failure::Raise("Fuzzy Booleans are not supported in this version of OCCT");
     TopoDS_Shape resShape = this->_Shape;
-    if (resShape.IsNull())
-        throw Base::ValueError("Object shape is null");
     for (std::vector<TopoDS_Shape>::const_iterator it = shapes.begin(); it != shapes.end(); ++it) {
         if (it->IsNull())
             throw NullShapeException("Input shape is null");
@@ -1931,33 +1967,32 @@ TopoDS_Shape TopoShape::fuse(const std::vector<TopoDS_Shape>& shapes, Standard_R
             throw Base::RuntimeError("Fusion failed");
         resShape = mkFuse.Shape();
     }
+    return makeShell(resShape);
 #else
-    BRepAlgoAPI_Fuse mkFuse;
-# if OCC_VERSION_HEX >= 0x060900
-    mkFuse.SetRunParallel(true);
-# endif
-    TopTools_ListOfShape shapeArguments,shapeTools;
-    shapeArguments.Append(this->_Shape);
-    for (std::vector<TopoDS_Shape>::const_iterator it = shapes.begin(); it != shapes.end(); ++it) {
-        if (it->IsNull())
-            throw NullShapeException("Tool shape is null");
-        if (tolerance > 0.0)
-            // workaround for http://dev.opencascade.org/index.php?q=node/1056#comment-520
-            shapeTools.Append(BRepBuilderAPI_Copy(*it).Shape());
-        else
-            shapeTools.Append(*it);
-    }
-    mkFuse.SetArguments(shapeArguments);
-    mkFuse.SetTools(shapeTools);
+    BooleanOptions options;
     if (tolerance > 0.0)
-        mkFuse.SetFuzzyValue(tolerance);
-    mkFuse.Build();
+        options.fuzzyValue = tolerance;
+    return fuse(shapes, options);
+#endif
+}
+
+TopoDS_Shape TopoShape::fuse(const std::vector<TopoDS_Shape>& shapes, const BooleanOptions& options) const
+{
+    if (this->_Shape.IsNull())
+        Standard_Failure::Raise("Base shape is null");
+#if OCC_VERSION_HEX < 0x060900
+    (void)shapes;
+    (void)options;
+    throw Base::RuntimeError("Multi fuse with options is available only in OCC 6.9.0 and up.");
+#else
+    BRepAlgoAPI_Fuse mkFuse;
+    options.build(mkFuse, this->_Shape, shapes);
     if (!mkFuse.IsDone())
         throw Base::RuntimeError("Multi fuse failed");
 
     TopoDS_Shape resShape = mkFuse.Shape();
-#endif
     return makeShell(resShape);
+#endif
 }
 
 TopoDS_Shape TopoShape::oldFuse(TopoDS_Shape shape) const
@@ -1998,35 +2033,28 @@ TopoDS_Shape TopoShape::section(TopoDS_Shape shape, Standard_Boolean approximate
 TopoDS_Shape TopoShape::section(const std::vector<TopoDS_Shape>& shapes,
                                 Standard_Real tolerance,
                                 Standard_Boolean approximate) const
+{
+    BooleanOptions options;
+    if (tolerance > 0.0)
+        options.fuzzyValue = tolerance;
+    return section(shapes, options, approximate);
+}
+
+TopoDS_Shape TopoShape::section(const std::vector<TopoDS_Shape>& shapes,
+                                const BooleanOptions& options,
+                                Standard_Boolean approximate) const
 {
     if (this->_Shape.IsNull())
         Standard_Failure::Raise("Base shape is null");
 #if OCC_VERSION_HEX < 0x060900
     (void)shapes;
-    (void)tolerance;
+    (void)options;
     (void)approximate;
     throw Base::RuntimeError("Multi section is available only in OCC 6.9.0 and up.");
 #else
     BRepAlgoAPI_Section mkSection;
-    mkSection.SetRunParallel(true);
     mkSection.Approximation(approximate);
-    TopTools_ListOfShape shapeArguments,shapeTools;
-    shapeArguments.Append(this->_Shape);
-    for (std::vector<TopoDS_Shape>::const_iterator it = shapes.begin(); it != shapes.end(); ++it) {
-        if (it->IsNull())
-            throw Base::ValueError("Tool shape is null");
-        if (tolerance > 0.0)
-            // workaround for http://dev.opencascade.org/index.php?q=node/1056#comment-520
-            shapeTools.Append(BRepBuilderAPI_Copy(*it).Shape());
-        else
-            shapeTools.Append(*it);
-    }
-
-    mkSection.SetArguments(shapeArguments);
-    mkSection.SetTools(shapeTools);
-    if (tolerance > 0.0)
-        mkSection.SetFuzzyValue(tolerance);
-    mkSection.Build();
+    options.build(mkSection, this->_Shape, shapes);
     if (!mkSection.IsDone())
         throw Base::RuntimeError("Multi section failed");
 
@@ -2067,34 +2095,39 @@ TopoDS_Compound TopoShape::slices(const Base::Vector3d& dir, const std::vector<d
 
 TopoDS_Shape TopoShape::generalFuse(const std::vector<TopoDS_Shape> &sOthers, Standard_Real tolerance,
                                     std::vector<TopTools_ListOfShape>* mapInOut) const
+{
+    BooleanOptions options;
+    if (tolerance > 0.0)
+        options.fuzzyValue = tolerance;
+    options.nonDestructive = true;
+    return generalFuse(sOthers, options, mapInOut);
+}
+
+TopoDS_Shape TopoShape::generalFuse(const std::vector<TopoDS_Shape> &sOthers, const BooleanOptions& options,
+                                    std::vector<TopTools_ListOfShape>* mapInOut) const
 {
     if (this->_Shape.IsNull())
         Standard_Failure::Raise("Base shape is null");
 #if OCC_VERSION_HEX < 0x060900
     (void)sOthers;
-    (void)tolerance;
+    (void)options;
     (void)mapInOut;
     throw Base::AttributeError("GFA is available only in OCC 6.9.0 and up.");
 #else
     BRepAlgoAPI_BuilderAlgo mkGFA;
-    mkGFA.SetRunParallel(true);
     TopTools_ListOfShape GFAArguments;
     GFAArguments.Append(this->_Shape);
     for (const TopoDS_Shape &it: sOthers) {
         if (it.IsNull())
             throw NullShapeException("Tool shape is null");
-        if (tolerance > 0.0)
+        if (options.fuzzyValue > 0.0)
             // workaround for http://dev.opencascade.org/index.php?q=node/1056#comment-520
             GFAArguments.Append(BRepBuilderAPI_Copy(it).Shape());
         else
             GFAArguments.Append(it);
     }
     mkGFA.SetArguments(GFAArguments);
-    if (tolerance > 0.0)
-        mkGFA.SetFuzzyValue(tolerance);
-#if OCC_VERSION_HEX >= 0x070000
-    mkGFA.SetNonDestructive(Standard_True);
-#endif
+    options.apply(mkGFA);
     mkGFA.Build();
     if (!mkGFA.IsDone())
         throw BooleanException("MultiFusion failed");
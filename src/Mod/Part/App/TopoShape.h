@@ -43,6 +43,8 @@ class Color;
 namespace Part
 {
 
+class BooleanOptions;
+
 /* A special sub-class to indicate null shapes
  */
 class PartExport NullShapeException : public Base::ValueError
@@ -200,19 +202,33 @@ public:
     bool findPlane(gp_Pln &pln, double tol=-1) const;
     /// Returns true if the expansion of the shape is infinite, false otherwise
     bool isInfinite() const;
+    /** Returns a hash of the geometry and topology of the shape, including its
+     * location. It is computed from the BRep data without triangulations, so it
+     * is stable between sessions and doesn't change when the shape gets
+     * tessellated. An empty string is returned for a null shape.
+     */
+    std::string getContentHash() const;
     //@}
 
     /** @name Boolean operation*/
     //@{
+    /* The multi-shape operations use the default BooleanOptions, a tolerance
+     * greater than zero sets its fuzzy value. The overloads taking
+     * BooleanOptions use the passed options as they are.
+     */
     TopoDS_Shape cut(TopoDS_Shape) const;
     TopoDS_Shape cut(const std::vector<TopoDS_Shape>&, Standard_Real tolerance = 0.0) const;
+    TopoDS_Shape cut(const std::vector<TopoDS_Shape>&, const BooleanOptions&) const;
     TopoDS_Shape common(TopoDS_Shape) const;
     TopoDS_Shape common(const std::vector<TopoDS_Shape>&, Standard_Real tolerance = 0.0) const;
+    TopoDS_Shape common(const std::vector<TopoDS_Shape>&, const BooleanOptions&) const;
     TopoDS_Shape fuse(TopoDS_Shape) const;
     TopoDS_Shape fuse(const std::vector<TopoDS_Shape>&, Standard_Real tolerance = 0.0) const;
+    TopoDS_Shape fuse(const std::vector<TopoDS_Shape>&, const BooleanOptions&) const;
     TopoDS_Shape oldFuse(TopoDS_Shape) const;
     TopoDS_Shape section(TopoDS_Shape, Standard_Boolean approximate=Standard_False) const;
     TopoDS_Shape section(const std::vector<TopoDS_Shape>&, Standard_Real tolerance = 0.0, Standard_Boolean approximate=Standard_False) const;
+    TopoDS_Shape section(const std::vector<TopoDS_Shape>&, const BooleanOptions&, Standard_Boolean approximate=Standard_False) const;
     std::list<TopoDS_Wire> slice(const Base::Vector3d&, double) const;
     TopoDS_Compound slices(const Base::Vector3d&, const std::vector<double>&) const;
     /**
@@ -237,6 +253,8 @@ public:
      * three solids: two cuts and common.
      */
     TopoDS_Shape generalFuse(const std::vector<TopoDS_Shape> &sOthers, Standard_Real tolerance, std::vector<TopTools_ListOfShape>* mapInOut = nullptr) const;
+    /// Same as above but the fuzzy value and the other settings are taken from \a options
+    TopoDS_Shape generalFuse(const std::vector<TopoDS_Shape> &sOthers, const BooleanOptions& options, std::vector<TopTools_ListOfShape>* mapInOut = nullptr) const;
     //@}
 
     /** Sweeping */
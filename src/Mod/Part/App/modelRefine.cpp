@@ -66,6 +66,7 @@
 # include <BRepGProp.hxx>
 # include <GProp_GProps.hxx>
 # include <Standard_Version.hxx>
+# include <QtConcurrentMap>
 #endif // _PreComp_
 
 #include <Base/Tools.h>
@@ -144,6 +145,34 @@ namespace ModelRefine
     };
 }
 
+namespace {
+    struct FaceSortKey
+    {
+        const TopoDS_Face *face;
+        double key;
+        double tolerance;
+        bool valid;
+    };
+
+    class FaceSortKeyMaker
+    {
+    public:
+        FaceSortKeyMaker(const FaceTypedBase *objectIn) : object(objectIn) {}
+        void operator() (FaceSortKey &sortKey) const
+        {
+            try {
+                sortKey.valid = object->getSortKey(*sortKey.face, sortKey.key, sortKey.tolerance);
+            }
+            catch (Standard_Failure&) {
+                sortKey.valid = false;
+            }
+        }
+
+    private:
+        const FaceTypedBase *object;
+    };
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 
 void FaceTypeSplitter::addShell(const TopoDS_Shell &shellIn)
@@ -210,11 +239,8 @@ void FaceAdjacencySplitter::split(const FaceVectorType &facesIn)
     FaceVectorType::const_iterator it;
     for (it = facesIn.begin(); it != facesIn.end(); ++it)
         facesInMap.Add(*it);
-    //the reserve call guarantees the vector will never get "pushed back" in the
-    //recursiveFind calls, thus invalidating the iterators. We can be sure of this as any one
-    //matched set can't be bigger than the set passed in. if we have seg faults, we will
-    //want to turn this tempFaces vector back into a std::list ensuring valid iterators
-    //at the expense of std::find speed.
+    //any one matched set can't be bigger than the set passed in, so reserving once
+    //avoids reallocations in the collectAdjacent calls.
     FaceVectorType tempFaces;
     tempFaces.reserve(facesIn.size() + 1);
 
@@ -226,7 +252,7 @@ void FaceAdjacencySplitter::split(const FaceVectorType &facesIn)
 
         tempFaces.clear();
         processedMap.Add(*it);
-        recursiveFind(*it, tempFaces);
+        collectAdjacent(*it, tempFaces);
         if (tempFaces.size() > 1)
         {
             adjacencyArray.push_back(tempFaces);
@@ -234,24 +260,33 @@ void FaceAdjacencySplitter::split(const FaceVectorType &facesIn)
     }
 }
 
-void FaceAdjacencySplitter::recursiveFind(const TopoDS_Face &face, FaceVectorType &outVector)
+void FaceAdjacencySplitter::collectAdjacent(const TopoDS_Face &face, FaceVectorType &outVector)
 {
-    outVector.push_back(face);
-
-    const TopTools_ListOfShape &edges = faceToEdgeMap.FindFromKey(face);
-    TopTools_ListIteratorOfListOfShape edgeIt;
-    for (edgeIt.Initialize(edges); edgeIt.More(); edgeIt.Next())
+    //depth first search with an explicit stack, big groups of faces (e.g. a plate with
+    //thousands of split faces) would otherwise recurse very deep.
+    FaceVectorType stack;
+    stack.push_back(face);
+    while (!stack.empty())
     {
-        const TopTools_ListOfShape &faces = edgeToFaceMap.FindFromKey(edgeIt.Value());
-        TopTools_ListIteratorOfListOfShape faceIt;
-        for (faceIt.Initialize(faces); faceIt.More(); faceIt.Next())
+        TopoDS_Face current = stack.back();
+        stack.pop_back();
+        outVector.push_back(current);
+
+        const TopTools_ListOfShape &edges = faceToEdgeMap.FindFromKey(current);
+        TopTools_ListIteratorOfListOfShape edgeIt;
+        for (edgeIt.Initialize(edges); edgeIt.More(); edgeIt.Next())
         {
-            if (!facesInMap.Contains(faceIt.Value()))
-                continue;
-            if (processedMap.Contains(faceIt.Value()))
-                continue;
-            processedMap.Add(faceIt.Value());
-            recursiveFind(TopoDS::Face(faceIt.Value()), outVector);
+            const TopTools_ListOfShape &faces = edgeToFaceMap.FindFromKey(edgeIt.Value());
+            TopTools_ListIteratorOfListOfShape faceIt;
+            for (faceIt.Initialize(faces); faceIt.More(); faceIt.Next())
+            {
+                if (!facesInMap.Contains(faceIt.Value()))
+                    continue;
+                if (processedMap.Contains(faceIt.Value()))
+                    continue;
+                processedMap.Add(faceIt.Value());
+                stack.push_back(TopoDS::Face(faceIt.Value()));
+            }
         }
     }
 }
@@ -260,28 +295,71 @@ void FaceAdjacencySplitter::recursiveFind(const TopoDS_Face &face, FaceVectorTyp
 
 void FaceEqualitySplitter::split(const FaceVectorType &faces, FaceTypedBase *object)
 {
+    //the sort keys only depend on the surface of each face. Computing them is
+    //worth spreading over several threads for big shells.
+    std::vector<FaceSortKey> sortKeys(faces.size());
+    for (std::size_t index = 0; index < faces.size(); ++index)
+    {
+        sortKeys[index].face = &faces[index];
+        sortKeys[index].valid = false;
+    }
+    if (sortKeys.size() > 1000)
+        QtConcurrent::blockingMap(sortKeys, FaceSortKeyMaker(object));
+    else
+        std::for_each(sortKeys.begin(), sortKeys.end(), FaceSortKeyMaker(object));
+
+    double window(0.0);
+    for (std::vector<FaceSortKey>::const_iterator keyIt = sortKeys.begin(); keyIt != sortKeys.end(); ++keyIt)
+    {
+        if (keyIt->valid)
+            window = std::max(window, keyIt->tolerance);
+    }
+
+    //a face is compared with the first face of every group whose key is within the
+    //window, and with every group without a key. Testing the candidates in the order
+    //the groups were created gives the same groups as comparing with all of them.
     std::vector<FaceVectorType> tempVector;
-    tempVector.reserve(faces.size());
-    FaceVectorType::const_iterator faceIt;
-    for (faceIt = faces.begin(); faceIt != faces.end(); ++faceIt)
+    std::multimap<double, std::size_t> keyedGroups;
+    std::vector<std::size_t> unkeyedGroups;
+    std::vector<std::size_t> candidates;
+    for (std::size_t index = 0; index < faces.size(); ++index)
     {
+        const TopoDS_Face &face = faces[index];
+        const FaceSortKey &sortKey = sortKeys[index];
+        candidates = unkeyedGroups;
+        std::multimap<double, std::size_t>::const_iterator groupIt, groupEnd;
+        if (sortKey.valid)
+        {
+            groupIt = keyedGroups.lower_bound(sortKey.key - window);
+            groupEnd = keyedGroups.upper_bound(sortKey.key + window);
+        }
+        else
+        {
+            groupIt = keyedGroups.begin();
+            groupEnd = keyedGroups.end();
+        }
+        for (; groupIt != groupEnd; ++groupIt)
+            candidates.push_back(groupIt->second);
+        std::sort(candidates.begin(), candidates.end());
+
         bool foundMatch(false);
-        std::vector<FaceVectorType>::iterator tempIt;
-        for (tempIt = tempVector.begin(); tempIt != tempVector.end(); ++tempIt)
+        std::vector<std::size_t>::const_iterator candidateIt;
+        for (candidateIt = candidates.begin(); candidateIt != candidates.end(); ++candidateIt)
         {
-            if (object->isEqual((*tempIt).front(), *faceIt))
+            if (object->isEqual(tempVector[*candidateIt].front(), face))
             {
-                (*tempIt).push_back(*faceIt);
+                tempVector[*candidateIt].push_back(face);
                 foundMatch = true;
                 break;
             }
         }
         if (!foundMatch)
         {
-            FaceVectorType another;
-            another.reserve(faces.size());
-            another.push_back(*faceIt);
-            tempVector.push_back(another);
+            if (sortKey.valid)
+                keyedGroups.insert(std::make_pair(sortKey.key, tempVector.size()));
+            else
+                unkeyedGroups.push_back(tempVector.size());
+            tempVector.push_back(FaceVectorType(1, face));
         }
     }
     std::vector<FaceVectorType>::iterator it;
@@ -295,6 +373,11 @@ void FaceEqualitySplitter::split(const FaceVectorType &faces, FaceTypedBase *obj
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+bool FaceTypedBase::getSortKey(const TopoDS_Face &, double &, double &) const
+{
+    return false;
+}
+
 GeomAbs_SurfaceType FaceTypedBase::getFaceType(const TopoDS_Face &faceIn)
 {
     Handle(Geom_Surface) surface = BRep_Tool::Surface(faceIn);
@@ -386,6 +469,21 @@ bool FaceTypedPlane::isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &face
             planeOne.Distance(planeTwo.Position().Location()) < Precision::Confusion());
 }
 
+bool FaceTypedPlane::getSortKey(const TopoDS_Face &face, double &key, double &tolerance) const
+{
+    Handle(Geom_Plane) planeSurface = getGeomPlane(face);
+    if (planeSurface.IsNull())
+        return false;
+
+    //distance of the plane to the origin. The normals of equal planes may differ by
+    //the angular tolerance of isEqual(), which is scaled by the distance of the location.
+    gp_Pln plane(planeSurface->Pln());
+    gp_XYZ location(plane.Position().Location().XYZ());
+    key = fabs(plane.Position().Direction().XYZ().Dot(location));
+    tolerance = 2.0 * Precision::Confusion() * (1.0 + location.Modulus());
+    return true;
+}
+
 GeomAbs_SurfaceType FaceTypedPlane::getType() const
 {
     return GeomAbs_Plane;
@@ -482,6 +580,16 @@ bool FaceTypedCylinder::isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &f
     return true;
 }
 
+bool FaceTypedCylinder::getSortKey(const TopoDS_Face &face, double &key, double &tolerance) const
+{
+    Handle(Geom_CylindricalSurface) surface = getGeomCylinder(face);
+    if (surface.IsNull())
+        return false;
+    key = surface->Radius();
+    tolerance = 2.0 * Precision::Confusion();
+    return true;
+}
+
 GeomAbs_SurfaceType FaceTypedCylinder::getType() const
 {
     return GeomAbs_Cylinder;
@@ -952,6 +1060,17 @@ bool FaceTypedBSpline::isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &fa
   return false;
 }
 
+bool FaceTypedBSpline::getSortKey(const TopoDS_Face &face, double &key, double &tolerance) const
+{
+    Handle(Geom_BSplineSurface) surface = Handle(Geom_BSplineSurface)::DownCast(BRep_Tool::Surface(face));
+    if (surface.IsNull())
+        return false;
+    //isEqual() compares all poles with the confusion tolerance
+    key = surface->Pole(1, 1).X();
+    tolerance = 2.0 * Precision::Confusion();
+    return true;
+}
+
 GeomAbs_SurfaceType FaceTypedBSpline::getType() const
 {
     return GeomAbs_BSplineSurface;
@@ -1018,11 +1137,29 @@ FaceTypedBSpline& ModelRefine::getBSplineObject()
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-FaceUniter::FaceUniter(const TopoDS_Shell &shellIn) : modifiedSignal(false)
+FaceUniter::FaceUniter(const TopoDS_Shell &shellIn) : affectedFaces(nullptr), modifiedSignal(false)
 {
     workShell = shellIn;
 }
 
+FaceUniter::FaceUniter(const TopoDS_Shell &shellIn, const TopTools_MapOfShape *affectedFacesIn)
+  : affectedFaces(affectedFacesIn), modifiedSignal(false)
+{
+    workShell = shellIn;
+}
+
+bool FaceUniter::isAffected(const FaceVectorType &faces) const
+{
+    if (!affectedFaces)
+        return true;
+    for (FaceVectorType::const_iterator it = faces.begin(); it != faces.end(); ++it)
+    {
+        if (affectedFaces->Contains(*it))
+            return true;
+    }
+    return false;
+}
+
 bool FaceUniter::process()
 {
     if (workShell.IsNull())
@@ -1053,10 +1190,14 @@ bool FaceUniter::process()
         equalitySplitter.split(typedFaces, *typeIt);
         for (std::size_t indexEquality(0); indexEquality < equalitySplitter.getGroupCount(); ++indexEquality)
         {
+            if (!isAffected(equalitySplitter.getGroup(indexEquality)))
+                continue;
             adjacencySplitter.split(equalitySplitter.getGroup(indexEquality));
 //            std::cout << "      adjacency group count: " << adjacencySplitter.getGroupCount() << std::endl;
             for (std::size_t adjacentIndex(0); adjacentIndex < adjacencySplitter.getGroupCount(); ++adjacentIndex)
             {
+                if (!isAffected(adjacencySplitter.getGroup(adjacentIndex)))
+                    continue;
 //                    std::cout << "         face count is: " << adjacencySplitter.getGroup(adjacentIndex).size() << std::endl;
                 TopoDS_Face newFace = (*typeIt)->buildFace(adjacencySplitter.getGroup(adjacentIndex));
                 if (!newFace.IsNull())
@@ -1190,6 +1331,15 @@ bool FaceUniter::process()
 //BRepBuilderAPI_RefineModel implement a way to log all modifications on the faces
 
 Part::BRepBuilderAPI_RefineModel::BRepBuilderAPI_RefineModel(const TopoDS_Shape& shape)
+  : myRestrictToAffected(false)
+{
+    myShape = shape;
+    Build();
+}
+
+Part::BRepBuilderAPI_RefineModel::BRepBuilderAPI_RefineModel(const TopoDS_Shape& shape,
+                                                             const TopTools_MapOfShape& affectedFaces)
+  : myAffectedFaces(affectedFaces), myRestrictToAffected(true)
 {
     myShape = shape;
     Build();
@@ -1199,6 +1349,7 @@ void Part::BRepBuilderAPI_RefineModel::Build()
 {
     if (myShape.IsNull())
         Standard_Failure::Raise("Cannot remove splitter from empty shape");
+    const TopTools_MapOfShape *affectedFaces = myRestrictToAffected ? &myAffectedFaces : nullptr;
 
     if (myShape.ShapeType() == TopAbs_SOLID) {
         const TopoDS_Solid &solid = TopoDS::Solid(myShape);
@@ -1206,7 +1357,7 @@ void Part::BRepBuilderAPI_RefineModel::Build()
         TopExp_Explorer it;
         for (it.Init(solid, TopAbs_SHELL); it.More(); it.Next()) {
             const TopoDS_Shell &currentShell = TopoDS::Shell(it.Current());
-            ModelRefine::FaceUniter uniter(currentShell);
+            ModelRefine::FaceUniter uniter(currentShell, affectedFaces);
             if (uniter.process()) {
                 if (uniter.isModified()) {
                     const TopoDS_Shell &newShell = uniter.getShell();
@@ -1235,7 +1386,7 @@ void Part::BRepBuilderAPI_RefineModel::Build()
     }
     else if (myShape.ShapeType() == TopAbs_SHELL) {
         const TopoDS_Shell& shell = TopoDS::Shell(myShape);
-        ModelRefine::FaceUniter uniter(shell);
+        ModelRefine::FaceUniter uniter(shell, affectedFaces);
         if (uniter.process()) {
             // TODO: Why not check for uniter.isModified()?
             myShape = uniter.getShell();
@@ -1258,7 +1409,7 @@ void Part::BRepBuilderAPI_RefineModel::Build()
             TopExp_Explorer it;
             for (it.Init(solid, TopAbs_SHELL); it.More(); it.Next()) {
                 const TopoDS_Shell &currentShell = TopoDS::Shell(it.Current());
-                ModelRefine::FaceUniter uniter(currentShell);
+                ModelRefine::FaceUniter uniter(currentShell, affectedFaces);
                 if (uniter.process()) {
                     if (uniter.isModified()) {
                         const TopoDS_Shell &newShell = uniter.getShell();
@@ -1272,7 +1423,7 @@ void Part::BRepBuilderAPI_RefineModel::Build()
         // free shells
         for (xp.Init(myShape, TopAbs_SHELL, TopAbs_SOLID); xp.More(); xp.Next()) {
             const TopoDS_Shell& shell = TopoDS::Shell(xp.Current());
-            ModelRefine::FaceUniter uniter(shell);
+            ModelRefine::FaceUniter uniter(shell, affectedFaces);
             if (uniter.process()) {
                 builder.Add(comp, uniter.getShell());
                 LogModifications(uniter);
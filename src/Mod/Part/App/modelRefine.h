@@ -61,6 +61,11 @@ namespace ModelRefine
         virtual bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const = 0;
         virtual GeomAbs_SurfaceType getType() const = 0;
         virtual TopoDS_Face buildFace(const FaceVectorType &faces) const = 0;
+        /*! A scalar that differs by at most \a tolerance for faces that are equal
+         *  according to isEqual(). It is used to prefilter the equality test.
+         *  Returns false if there is no such value for \a face.
+         */
+        virtual bool getSortKey(const TopoDS_Face &face, double &key, double &tolerance) const;
 
         static GeomAbs_SurfaceType getFaceType(const TopoDS_Face &faceIn);
 
@@ -77,6 +82,7 @@ namespace ModelRefine
         virtual bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const;
         virtual GeomAbs_SurfaceType getType() const;
         virtual TopoDS_Face buildFace(const FaceVectorType &faces) const;
+        virtual bool getSortKey(const TopoDS_Face &face, double &key, double &tolerance) const;
         friend FaceTypedPlane& getPlaneObject();
     };
     FaceTypedPlane& getPlaneObject();
@@ -89,6 +95,7 @@ namespace ModelRefine
         virtual bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const;
         virtual GeomAbs_SurfaceType getType() const;
         virtual TopoDS_Face buildFace(const FaceVectorType &faces) const;
+        virtual bool getSortKey(const TopoDS_Face &face, double &key, double &tolerance) const;
         friend FaceTypedCylinder& getCylinderObject();
 
     protected:
@@ -104,6 +111,7 @@ namespace ModelRefine
         virtual bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const;
         virtual GeomAbs_SurfaceType getType() const;
         virtual TopoDS_Face buildFace(const FaceVectorType &faces) const;
+        virtual bool getSortKey(const TopoDS_Face &face, double &key, double &tolerance) const;
         friend FaceTypedBSpline& getBSplineObject();
     };
     FaceTypedBSpline& getBSplineObject();
@@ -133,7 +141,7 @@ namespace ModelRefine
 
     private:
         FaceAdjacencySplitter(){}
-        void recursiveFind(const TopoDS_Face &face, FaceVectorType &outVector);
+        void collectAdjacent(const TopoDS_Face &face, FaceVectorType &outVector);
         std::vector<FaceVectorType> adjacencyArray;
         TopTools_MapOfShape processedMap;
         TopTools_MapOfShape facesInMap;
@@ -160,6 +168,10 @@ namespace ModelRefine
         FaceUniter(){}
     public:
         FaceUniter(const TopoDS_Shell &shellIn);
+        /*! Only unite groups of faces that contain at least one of \a affectedFacesIn,
+         *  e.g. the faces created or modified by the last boolean operation.
+         */
+        FaceUniter(const TopoDS_Shell &shellIn, const TopTools_MapOfShape *affectedFacesIn);
         bool process();
         const TopoDS_Shell& getShell() const {return workShell;}
         bool isModified(){return modifiedSignal;}
@@ -169,7 +181,10 @@ namespace ModelRefine
         {return deletedShapes;}
 
     private:
+        bool isAffected(const FaceVectorType &faces) const;
+
         TopoDS_Shell workShell;
+        const TopTools_MapOfShape *affectedFaces;
         std::vector<FaceTypedBase *> typeObjects;
         std::vector<ShapePairType> modifiedShapes;
         ShapeVectorType deletedShapes;
@@ -197,6 +212,8 @@ class PartExport BRepBuilderAPI_RefineModel : public BRepBuilderAPI_MakeShape
 {
 public:
     BRepBuilderAPI_RefineModel(const TopoDS_Shape&);
+    /// Only refine faces that are united with at least one of \a affectedFaces
+    BRepBuilderAPI_RefineModel(const TopoDS_Shape&, const TopTools_MapOfShape& affectedFaces);
     void Build();
     const TopTools_ListOfShape& Modified(const TopoDS_Shape& S);
     Standard_Boolean IsDeleted(const TopoDS_Shape& S);
@@ -208,6 +225,8 @@ private:
     TopTools_DataMapOfShapeListOfShape myModified;
     TopTools_ListOfShape myEmptyList;
     TopTools_ListOfShape myDeleted;
+    TopTools_MapOfShape myAffectedFaces;
+    bool myRestrictToAffected;
 };
 }
 
@@ -364,14 +364,18 @@ void ViewProviderPartExt::onChanged(const App::Property* prop)
     if (prop == &Deviation) {
         if(isUpdateForced()||Visibility.getValue()) 
             updateVisual();
-        else
+        else {
             VisualTouched = true;
+            VisualShapeHash.clear();
+        }
     }
     if (prop == &AngularDeflection) {
         if(isUpdateForced()||Visibility.getValue()) 
             updateVisual();
-        else
+        else {
             VisualTouched = true;
+            VisualShapeHash.clear();
+        }
     }
     if (prop == &LineWidth) {
         pcLineStyle->lineWidth = LineWidth.getValue();
@@ -940,10 +944,20 @@ void ViewProviderPartExt::updateData(const App::Property* prop)
     const char *propName = prop->getName();
     if (propName && (strcmp(propName, "Shape") == 0 || strstr(propName, "Touched") != nullptr)) {
         // calculate the visual only if visible
-        if (isUpdateForced() || Visibility.getValue())
-            updateVisual();
-        else 
+        if (isUpdateForced() || Visibility.getValue()) {
+            // a recompute often reproduces the very same shape, in which case the
+            // existing tessellation can be kept
+            std::string hash;
+            if (prop->isDerivedFrom(Part::PropertyPartShape::getClassTypeId()))
+                hash = static_cast<const Part::PropertyPartShape*>(prop)->getContentHash();
+            if (VisualTouched || hash.empty() || hash != VisualShapeHash)
+                updateVisual();
+            VisualShapeHash = hash;
+        }
+        else {
             VisualTouched = true;
+            VisualShapeHash.clear();
+        }
 
         if (!VisualTouched) {
             if (this->faceset->partIndex.getNum() > 
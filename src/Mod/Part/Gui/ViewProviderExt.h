@@ -180,6 +180,8 @@ protected:
 
     bool VisualTouched;
     bool NormalsFromUV;
+    /// content hash of the shape of the current visual, empty if unknown or outdated
+    std::string VisualShapeHash;
 
 private:
     // settings stuff
@@ -54,6 +54,41 @@ class PartTestCases(unittest.TestCase):
         #self.Doc.addObject("Part::Feature","Face").Shape = result
         #self.assertTrue(isinstance(result.Surface, Part.BSplineSurface))
 
+    def testBooleanOptions(self):
+        box1 = self.Doc.addObject("Part::Box","Box1")
+        box2 = self.Doc.addObject("Part::Box","Box2")
+        box2.Placement.Base = App.Vector(5,5,5)
+        cut = self.Doc.addObject("Part::Cut","Cut")
+        cut.Base = box1
+        cut.Tool = box2
+        fuse = self.Doc.addObject("Part::MultiFuse","Fuse")
+        fuse.Shapes = [box1, box2]
+
+        # the glue entry must be ignored because the boxes overlap
+        meta = self.Doc.Meta
+        meta["Part/Boolean/RunParallel"] = "0"
+        meta["Part/Boolean/UseOBB"] = "1"
+        meta["Part/Boolean/FuzzyValue"] = "1e-5"
+        meta["Part/Boolean/NonDestructive"] = "0"
+        meta["Part/Boolean/Glue"] = "2"
+        self.Doc.Meta = meta
+        self.Doc.recompute()
+
+        self.assertAlmostEqual(cut.Shape.Volume, 875.0, places=3)
+        self.assertAlmostEqual(fuse.Shape.Volume, 1875.0, places=3)
+        # a fuzzy operation must not change the shapes of the boxes
+        for box in (box1, box2):
+            self.assertAlmostEqual(box.Shape.Volume, 1000.0, places=6)
+            self.assertLess(box.Shape.getTolerance(1), 1e-6)
+
+    def testFuzzyBooleanKeepsArguments(self):
+        box1 = Part.makeBox(10, 10, 10)
+        box2 = Part.makeBox(10, 10, 10, App.Vector(5, 5, 5))
+        cut = box1.cut([box2], 1e-5)
+        self.assertAlmostEqual(cut.Volume, 875.0, places=3)
+        self.assertLess(box1.getTolerance(1), 1e-6)
+        self.assertLess(box2.getTolerance(1), 1e-6)
+
     def tearDown(self):
         #closing doc
         FreeCAD.closeDocument("PartTest")
@@ -24,6 +24,10 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 # include <Standard_Failure.hxx>
+# include <TopExp.hxx>
+# include <TopExp_Explorer.hxx>
+# include <TopTools_IndexedMapOfShape.hxx>
+# include <TopTools_MapOfShape.hxx>
 #endif
 
 
@@ -84,6 +88,36 @@ TopoDS_Shape FeatureAddSub::refineShapeIfActive(const TopoDS_Shape& oldShape) co
     return oldShape;
 }
 
+TopoDS_Shape FeatureAddSub::refineShapeIfActive(const TopoDS_Shape& oldShape, const TopoDS_Shape& baseShape) const
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+        .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/PartDesign");
+    if (!this->Refine.getValue() || baseShape.IsNull() || !hGrp->GetBool("RefineAffectedFacesOnly", false))
+        return refineShapeIfActive(oldShape);
+
+    // The boolean operation keeps the faces of the base it didn't touch, and these
+    // were already refined by the previous feature.
+    TopTools_IndexedMapOfShape baseFaces;
+    TopExp::MapShapes(baseShape, TopAbs_FACE, baseFaces);
+    TopTools_MapOfShape affectedFaces;
+    for (TopExp_Explorer xp(oldShape, TopAbs_FACE); xp.More(); xp.Next()) {
+        if (!baseFaces.Contains(xp.Current()))
+            affectedFaces.Add(xp.Current());
+    }
+
+    try {
+        Part::BRepBuilderAPI_RefineModel mkRefine(oldShape, affectedFaces);
+        TopoDS_Shape resShape = mkRefine.Shape();
+        if (!TopoShape(resShape).isClosed()) {
+            return oldShape;
+        }
+        return resShape;
+    }
+    catch (Standard_Failure&) {
+        return oldShape;
+    }
+}
+
 void FeatureAddSub::getAddSubShape(Part::TopoShape &addShape, Part::TopoShape &subShape)
 {
     if (addSubType == Additive)
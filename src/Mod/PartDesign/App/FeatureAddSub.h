@@ -58,6 +58,8 @@ protected:
     Type addSubType;
 
     TopoDS_Shape refineShapeIfActive(const TopoDS_Shape&) const;
+    /// Like above but may only refine faces of the shape that are not shared with \a baseShape
+    TopoDS_Shape refineShapeIfActive(const TopoDS_Shape&, const TopoDS_Shape& baseShape) const;
 };
 
 typedef App::FeaturePythonT<FeatureAddSub> FeatureAddSubPython;
@@ -66,6 +66,7 @@
 #include <App/Application.h>
 #include <Base/Reader.h>
 #include <Mod/Part/App/TopoShape.h>
+#include <Mod/Part/App/BooleanOptions.h>
 #include <Mod/Part/App/FaceMakerCheese.h>
 
 #include "json.hpp"
@@ -1961,6 +1962,9 @@ App::DocumentObjectExecReturn *Hole::execute(void)
             protoHole = mkFuse.Shape();
         }
 
+        // All holes are located instances of the same proto hole, i.e. they share
+        // its TShape and the cost of the placement loop does not depend on the
+        // complexity of the (threaded) hole.
         BRep_Builder builder;
         TopoDS_Compound holes;
         builder.MakeCompound(holes);
@@ -1992,21 +1996,26 @@ App::DocumentObjectExecReturn *Hole::execute(void)
 
         this->AddSubShape.setValue(holes);
 
-        // For some reason it is faster to do the cut through a BooleanOperation.
-        std::unique_ptr<BRepAlgoAPI_BooleanOperation> mkBool(new BRepAlgoAPI_Cut(base, holes));
-        if (!mkBool->IsDone()) {
+        // Cut all holes in a single boolean operation. With many holes (e.g. perforated
+        // plates) most of the time is spent in the intersection of the faces, which the
+        // boolean algorithm can run in parallel and prefilter with oriented bounding boxes.
+        Part::BooleanOptions options = Part::BooleanOptions::fromDocument(getDocument());
+        options.useOBB = true;
+        BRepAlgoAPI_Cut mkCut;
+        options.build(mkCut, base, std::vector<TopoDS_Shape>(1, holes));
+        if (!mkCut.IsDone()) {
             std::stringstream error;
             error << "Boolean operation failed";
             return new App::DocumentObjectExecReturn(error.str());
         }
-        TopoDS_Shape result = mkBool->Shape();
+        TopoDS_Shape result = mkCut.Shape();
 
 
         // We have to get the solids (fuse sometimes creates compounds)
-        base = getSolid(result);
-        if (base.IsNull())
+        TopoDS_Shape solRes = getSolid(result);
+        if (solRes.IsNull())
             return new App::DocumentObjectExecReturn("Hole: Resulting shape is not a solid");
-        base = refineShapeIfActive(base);
+        base = refineShapeIfActive(solRes, base);
 
 
 
@@ -38,6 +38,7 @@
 # include <GeomLib_IsPlanarSurface.hxx>
 # include <gp_Pln.hxx>
 # include <Precision.hxx>
+# include <Standard_Version.hxx>
 # include <TopoDS.hxx>
 # include <TopoDS_Compound.hxx>
 # include <TopoDS_Face.hxx>
@@ -51,6 +52,7 @@
 #include <Base/Exception.h>
 #include <Base/Placement.h>
 #include <Base/Reader.h>
+#include <Mod/Part/App/BooleanOptions.h>
 
 #include "FeaturePad.h"
 
@@ -343,7 +345,12 @@ App::DocumentObjectExecReturn *Pad::execute(void)
 //             auto obj = getDocument()->addObject("Part::Feature", "prism");
 //             static_cast<Part::Feature*>(obj)->Shape.setValue(getSolid(prism));
             // Let's call algorithm computing a fuse operation:
+#if OCC_VERSION_HEX < 0x060900
             BRepAlgoAPI_Fuse mkFuse(base, prism);
+#else
+            BRepAlgoAPI_Fuse mkFuse;
+            Part::BooleanOptions::fromDocument(getDocument()).build(mkFuse, base, std::vector<TopoDS_Shape>(1, prism));
+#endif
             // Let's check if the fusion has been successful
             if (!mkFuse.IsDone())
                 return new App::DocumentObjectExecReturn("Pad: Fusion with base feature failed");
@@ -359,7 +366,7 @@ App::DocumentObjectExecReturn *Pad::execute(void)
                 return new App::DocumentObjectExecReturn("Pad: Result has multiple solids. This is not supported at this time.");
             }
 
-            solRes = refineShapeIfActive(solRes);
+            solRes = refineShapeIfActive(solRes, base);
             this->Shape.setValue(getSolid(solRes));
         } else {
             int solidCount = countSolids(prism);
@@ -234,7 +234,7 @@ App::DocumentObjectExecReturn *Pocket::execute(void)
                 return new App::DocumentObjectExecReturn("Pocket: Result has multiple solids. This is not supported at this time.");
 
             }
-            solRes = refineShapeIfActive(solRes);
+            solRes = refineShapeIfActive(solRes, base);
             remapSupportShape(solRes);
             this->Shape.setValue(getSolid(solRes));
         }
@@ -23,6 +23,8 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
+# include <Standard_Version.hxx>
 # include <BRepBuilderAPI_Transform.hxx>
 # include <BRepAlgoAPI_Fuse.hxx>
 # include <BRepAlgoAPI_Cut.hxx>
@@ -34,6 +36,11 @@
 # include <BRepBuilderAPI_Copy.hxx>
 # include <BRepBndLib.hxx>
 # include <Bnd_Box.hxx>
+# if OCC_VERSION_HEX >= 0x070200
+#  include <Bnd_OBB.hxx>
+# endif
+# include <Standard_Failure.hxx>
+# include <QtConcurrentMap>
 #endif
 
 #ifndef FC_DEBUG
@@ -55,9 +62,79 @@
 #include <Base/Reader.h>
 #include <App/Application.h>
 #include <Mod/Part/App/modelRefine.h>
+#include <Mod/Part/App/BooleanOptions.h>
 
 using namespace PartDesign;
 
+namespace {
+
+/// A transformed copy of an original together with its bounding box
+struct TransformedInstance
+{
+    gp_Trsf trsf;
+    TopoDS_Shape shape;
+#if OCC_VERSION_HEX >= 0x070200
+    Bnd_OBB box;
+#else
+    Bnd_Box box;
+#endif
+    std::string error;
+};
+
+void addBoundingBox(const TopoDS_Shape& shape, TransformedInstance& instance)
+{
+#if OCC_VERSION_HEX >= 0x070200
+    BRepBndLib::AddOBB(shape, instance.box);
+#else
+    BRepBndLib::Add(shape, instance.box);
+#endif
+    // touching instances must not be separated by the prefilter
+    instance.box.Enlarge(Precision::Confusion());
+}
+
+/**
+ * Creates the transformed copy of an original in a worker thread. The
+ * original shape is only read, each instance gets its own copy. A failed
+ * transformation is stored in the instance so that execute() can report it
+ * once all copies are made.
+ */
+class InstanceMaker
+{
+public:
+    InstanceMaker(const TopoDS_Shape& shape, bool withBoundingBox)
+      : shape(shape)
+      , withBoundingBox(withBoundingBox)
+    {
+    }
+    void operator()(TransformedInstance& instance) const
+    {
+        try {
+            // Make an explicit copy of the shape because the "true" parameter to BRepBuilderAPI_Transform
+            // seems to be pretty broken
+            BRepBuilderAPI_Copy copy(shape);
+
+            BRepBuilderAPI_Transform mkTrf(copy.Shape(), instance.trsf, false); // No need to copy, now
+            if (!mkTrf.IsDone()) {
+                instance.error = "Transformation failed";
+                return;
+            }
+            instance.shape = mkTrf.Shape();
+
+            if (withBoundingBox)
+                addBoundingBox(instance.shape, instance);
+        }
+        catch (const Standard_Failure& e) {
+            instance.error = e.GetMessageString();
+        }
+    }
+
+private:
+    const TopoDS_Shape& shape;
+    bool withBoundingBox;
+};
+
+}
+
 namespace PartDesign {
 
 const char* Transformed::OverlapEnums[] = { "Detect", "Overlap mode", "Non-overlap mode", NULL};
@@ -267,7 +344,6 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
     for (std::vector<App::DocumentObject*>::const_iterator o = originals.begin(); o != originals.end(); ++o)
     {
         // Extract the original shape and determine whether to cut or to fuse
-        TopoDS_Shape shape;
         Part::TopoShape fuseShape;
         Part::TopoShape cutShape;
 
@@ -295,32 +371,32 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
         std::vector<TopoDS_Shape> shapes;
         bool overlapping = false;
 
-        std::vector<gp_Trsf>::const_iterator t = transformations.begin();
-        bool first = true;
-        for (; t != transformations.end(); ++t) {
-            // Make an explicit copy of the shape because the "true" parameter to BRepBuilderAPI_Transform
-            // seems to be pretty broken
-            BRepBuilderAPI_Copy copy(origShape);
-
-            shape = copy.Shape();
-
-            BRepBuilderAPI_Transform mkTrf(shape, *t, false); // No need to copy, now
-            if (!mkTrf.IsDone())
-                return new App::DocumentObjectExecReturn("Transformation failed", (*o));
-            shape = mkTrf.Shape();
-
-            shapes.emplace_back(shape);
-            builder.Add(compShape, shape);
+        // The instances are independent of each other, so create them concurrently
+        std::vector<TransformedInstance> instances(transformations.size());
+        for (std::size_t i = 0; i < transformations.size(); i++)
+            instances[i].trsf = transformations[i];
+        QtConcurrent::blockingMap(instances, InstanceMaker(origShape, overlapDetectionMode));
+
+        for (std::vector<TransformedInstance>::const_iterator it = instances.begin(); it != instances.end(); ++it) {
+            if (!it->error.empty())
+                return new App::DocumentObjectExecReturn(it->error.c_str(), (*o));
+            shapes.emplace_back(it->shape);
+            builder.Add(compShape, it->shape);
+        }
 
-            if (overlapDetectionMode && !first)
-                overlapping =  overlapping || (countSolids(TopoShape(origShape).fuse(shape))==1);
+        if (overlapDetectionMode) {
+            // Only an instance whose bounding box intersects the one of the original
+            // needs the expensive boolean test
+            TransformedInstance original;
+            addBoundingBox(origShape, original);
 
-            if (first)
-                first = false;
+            for (std::size_t i = 1; i < instances.size() && !overlapping; i++) {
+                if (instances[i].box.IsOut(original.box))
+                    continue;
+                overlapping = countSolids(TopoShape(origShape).fuse(instances[i].shape)) == 1;
+            }
         }
 
-        TopoDS_Shape toolShape;
-
 #ifndef FC_DEBUG
         if (overlapping || overlapMode == "Overlap mode")
             Base::Console().Message("Transformed: Overlapping feature mode (fusing tool shapes)\n");
@@ -328,27 +404,28 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
             Base::Console().Message("Transformed: Non-Overlapping feature mode (compound of tool shapes)\n");
 #endif
 
-        if (overlapping || overlapMode == "Overlap mode")
-            toolShape = TopoShape(origShape).fuse(shapes, Precision::Confusion());
-        else
-            toolShape = compShape;
-
-        if (!fuseShape.isNull()) {
-            std::unique_ptr<BRepAlgoAPI_BooleanOperation> mkBool(new BRepAlgoAPI_Fuse(current, toolShape));
-            if (!mkBool->IsDone()) {
-                std::stringstream error;
-                error << "Boolean operation failed";
-                return new App::DocumentObjectExecReturn(error.str());
-            }
-            current = mkBool->Shape();
-        } else {
-            std::unique_ptr<BRepAlgoAPI_BooleanOperation> mkBool(new BRepAlgoAPI_Cut(current, toolShape));
-            if (!mkBool->IsDone()) {
-                std::stringstream error;
-                error << "Boolean operation failed";
-                return new App::DocumentObjectExecReturn(error.str());
-            }
-            current = mkBool->Shape();
+        // Overlapping instances are fused to one tool with a small fuzzy value first,
+        // otherwise the compound of all instances is the tool. The boolean operation
+        // with the support only uses the options of the document.
+        std::vector<TopoDS_Shape> tools;
+        Part::BooleanOptions options = Part::BooleanOptions::fromDocument(getDocument());
+
+        try {
+            if (overlapping || overlapMode == "Overlap mode")
+                tools.push_back(TopoShape(origShape).fuse(shapes, Precision::Confusion()));
+            else
+                tools.push_back(compShape);
+
+            if (!fuseShape.isNull())
+                current = TopoShape(current).fuse(tools, options);
+            else
+                current = TopoShape(current).cut(tools, options);
+        }
+        catch (Standard_Failure&) {
+            return new App::DocumentObjectExecReturn("Boolean operation failed");
+        }
+        catch (Base::Exception&) {
+            return new App::DocumentObjectExecReturn("Boolean operation failed");
         }
 
         support = current; // Use result of this operation for fuse/cut of next original
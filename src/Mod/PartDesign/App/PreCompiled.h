@@ -64,6 +64,7 @@
 // QT
 #include <QObject>
 #include <QCoreApplication>
+#include <QtConcurrentMap>
 
 // OpenCasCade =====================================================================================
 #include <Mod/Part/App/OpenCascadeAll.h>
@@ -96,6 +97,12 @@
 # include <BRepPrimAPI_MakeCone.hxx>
 # include <BRepPrimAPI_MakeTorus.hxx>
 # include <BRepPrimAPI_MakePrism.hxx>
+# include <BRepBuilderAPI_Copy.hxx>
+# include <BRepBndLib.hxx>
+# include <Bnd_Box.hxx>
+#if OCC_VERSION_HEX >= 0x070200
+# include <Bnd_OBB.hxx>
+#endif
 
 # include <ShapeAnalysis_FreeBounds.hxx>
 # include <ShapeFix_Shape.hxx>
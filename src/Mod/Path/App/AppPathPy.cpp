@@ -31,6 +31,7 @@
 
 #include <Base/Console.h>
 #include <Base/VectorPy.h>
+#include <Base/GeometryPyCXX.h>
 #include <Base/FileInfo.h>
 #include <Base/Interpreter.h>
 #include <App/Document.h>
@@ -109,6 +110,9 @@ public:
         add_varargs_method("read",&Module::read,
             "read(filename,[document]): Imports a GCode file into the given document"
         );
+        add_varargs_method("boundBox",&Module::boundBox,
+            "boundBox(filename): Returns the bounding box of the moves in a GCode file, without importing it"
+        );
         add_varargs_method("show",&Module::show,
             "show(path,[string]): Add the path to the active document or create one if no document exists"
         );
@@ -156,9 +160,8 @@ private:
             App::DocumentObject* obj = static_cast<App::DocumentObjectPy*>(pObj)->getDocumentObjectPtr();
             if (obj->getTypeId().isDerivedFrom(Base::Type::fromName("Path::Feature"))) {
                 const Toolpath& path = static_cast<Path::Feature*>(obj)->Path.getValue();
-                std::string gcode = path.toGCode();
                 std::ofstream ofile(EncodedName.c_str());
-                ofile << gcode;
+                path.toGCode(ofile);
                 ofile.close();
             }
             else {
@@ -192,13 +195,10 @@ private:
             pcDoc = App::GetApplication().newDocument(DocName);
 
         try {
-            // read the gcode file
+            // read the gcode file, a chunk at a time
             std::ifstream filestr(file.filePath().c_str());
-            std::stringstream buffer;
-            buffer << filestr.rdbuf();
-            std::string gcode = buffer.str();
             Toolpath path;
-            path.setFromGCode(gcode);
+            path.setFromGCode(filestr);
             Path::Feature *object = static_cast<Path::Feature *>(pcDoc->addObject("Path::Feature",file.fileNamePure().c_str()));
             object->Path.setValue(path);
             pcDoc->recompute();
@@ -211,6 +211,29 @@ private:
     }
 
 
+    Py::Object boundBox(const Py::Tuple& args)
+    {
+        char* Name;
+        if (!PyArg_ParseTuple(args.ptr(), "et","utf-8",&Name))
+            throw Py::Exception();
+        std::string EncodedName = std::string(Name);
+        PyMem_Free(Name);
+
+        Base::FileInfo file(EncodedName.c_str());
+        if (!file.exists())
+            throw Py::RuntimeError("File doesn't exist");
+
+        try {
+            // walk the file a chunk at a time, the commands are never stored
+            std::ifstream filestr(file.filePath().c_str());
+            return Py::BoundingBox(Toolpath::getBoundBox(filestr));
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+    }
+
+
     Py::Object show(const Py::Tuple& args)
     {
         PyObject *pcObj;
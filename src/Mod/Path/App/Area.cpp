@@ -89,6 +89,10 @@
 # include <TopTools_HSequenceOfShape.hxx>
 #endif
 
+#include <QFuture>
+#include <QThread>
+#include <QtConcurrentRun>
+
 #include <Base/Exception.h>
 #include <Base/Tools.h>
 
@@ -180,7 +184,7 @@ CAreaConfig::~CAreaConfig() {
 
 TYPESYSTEM_SOURCE(Path::Area, Base::BaseClass)
 
-bool Area::s_aborting;
+std::atomic<bool> Area::s_aborting(false);
 
 Area::Area(const AreaParams *params)
 :myParams(s_params)
@@ -1460,7 +1464,11 @@ std::vector<shared_ptr<Area> > Area::makeSections(
     bool can_retry = fabs(tolerance)>Precision::Confusion();
     TopLoc_Location locInverse(loc.Inverted());
 
-    for(size_t i=0;i<heights.size();++i) {
+    // Make the section at heights[i]. Returns an empty pointer if the section
+    // is discarded. Sections do not depend on each other, so this may be called
+    // concurrently, as long as each thread passes its own copy of the shapes.
+    auto makeSection = [&](size_t i, const std::list<Shape> &shapes) -> shared_ptr<Area> {
+        FC_TIME_INIT(t1);
         double z = heights[i];
         bool retried = !can_retry;
         while(true) {
@@ -1481,11 +1489,10 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                     TopLoc_Location wloc(t);
                     area->add(s.shape.Moved(wloc).Moved(locInverse),s.op);
                 }
-                sections.push_back(area);
-                break;
+                return area;
             }
 
-            for(auto it=myShapes.begin();it!=myShapes.end();++it) {
+            for(auto it=shapes.begin();it!=shapes.end();++it) {
                 const auto &s = *it;
                 BRep_Builder builder;
                 TopoDS_Compound comp;
@@ -1541,7 +1548,7 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                     area->add(shape,s.op);
                 }else if(area->myShapes.empty()){
                     auto itNext = it;
-                    if(++itNext != myShapes.end() &&
+                    if(++itNext != shapes.end() &&
                         (itNext->op==OperationIntersection ||
                         itNext->op==OperationDifference))
                     {
@@ -1550,20 +1557,81 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                 }
             }
             if(area->myShapes.size()){
-                sections.push_back(area);
                 FC_TIME_LOG(t1,"makeSection " << z);
-                showShape(area->getShape(),0,"section_%u_final",i);
-                break;
+                // only build the section here for debugging. Building involves
+                // libarea, which is not thread safe
+                if(FC_LOG_INSTANCE.level()>FC_LOGLEVEL_TRACE)
+                    showShape(area->getShape(),0,"section_%u_final",i);
+                return area;
             }
             if(retried) {
                 AREA_WARN("Discard empty section");
-                break;
+                return shared_ptr<Area>();
             }else{
                 AREA_TRACE("retry section " <<z<<"->"<<z+tolerance);
                 z += tolerance;
                 retried = true;
             }
         }
+    };
+
+    int threads = myParams.SectionThreads;
+    if(threads <= 0)
+        threads = QThread::idealThreadCount();
+    if(threads > (int)heights.size())
+        threads = (int)heights.size();
+    // showShape() adds objects to the document, which must not be done
+    // outside of the main thread
+    if(FC_LOG_INSTANCE.level()>FC_LOGLEVEL_TRACE)
+        threads = 1;
+
+    std::vector<shared_ptr<Area> > results(heights.size());
+    if(threads <= 1) {
+        for(size_t i=0;i<heights.size();++i) {
+            if(s_aborting)
+                throw Base::AbortException("Area section aborted");
+            results[i] = makeSection(i,myShapes);
+        }
+    }else{
+        // Each additional worker slices its own copy of the input, so that no
+        // OCC algorithm ever touches a shape used by another thread. The first
+        // worker keeps the original shapes. libarea is not involved here, the
+        // sections are built later on demand.
+        std::vector<std::exception_ptr> errors(threads);
+        auto worker = [&](int id) {
+            try {
+                std::list<Shape> copies;
+                if(id && !project) {
+                    for(const Shape &s : myShapes)
+                        copies.emplace_back(s.op,BRepBuilderAPI_Copy(s.shape).Shape());
+                }
+                const std::list<Shape> &shapes = id?copies:myShapes;
+                for(size_t i=id;i<heights.size();i+=threads) {
+                    if(s_aborting)
+                        return;
+                    results[i] = makeSection(i,shapes);
+                }
+            } catch (...) {
+                errors[id] = std::current_exception();
+            }
+        };
+        std::vector<QFuture<void> > futures;
+        for(int id=1;id<threads;++id)
+            futures.push_back(QtConcurrent::run(worker,id));
+        worker(0);
+        for(auto &future : futures)
+            future.waitForFinished();
+        if(s_aborting)
+            throw Base::AbortException("Area section aborted");
+        for(auto &error : errors) {
+            if(error)
+                std::rethrow_exception(error);
+        }
+    }
+
+    for(auto &area : results) {
+        if(area)
+            sections.push_back(area);
     }
     FC_TIME_LOG(t,"makeSection count: " << sections.size()<<", total");
     return sections;
@@ -160,6 +160,9 @@
         "When the section hits or over the shape boundary, a section with the height of that boundary\n"\
         "will be created. A small offset is usually required to avoid the tangential cut.",\
         App::PropertyPrecision))\
+    ((long,threads,SectionThreads,1,"Number of threads used to slice the sections. Sections at\n"\
+        "different heights are independent and can be sliced concurrently. 0 means using all\n"\
+        "available cores, 1 means slicing one section after another."))\
      AREA_PARAMS_SECTION_EXTRA
 
 #ifdef AREA_OFFSET_ALGO
@@ -24,7 +24,10 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <bitset>
+# include <cctype>
 # include <cinttypes>
+# include <cmath>
 # include <iomanip>
 # include <boost/algorithm/string.hpp>
 # include <boost/lexical_cast.hpp>
@@ -40,6 +43,109 @@
 using namespace Base;
 using namespace Path;
 
+// CommandParams
+
+CommandParams::CommandParams()
+    : mask(0)
+{
+}
+
+CommandParams::CommandParams(const std::map<std::string,double>& parameters)
+    : mask(0)
+{
+    for (auto &p : parameters)
+        (*this)[p.first] = p.second;
+}
+
+CommandParams::CommandParams(const CommandParams& other)
+    : mask(other.mask)
+    , values(other.values)
+{
+    if (other.others)
+        others.reset(new std::map<std::string,double>(*other.others));
+}
+
+CommandParams& CommandParams::operator=(const CommandParams& other)
+{
+    if (this != &other) {
+        mask = other.mask;
+        values = other.values;
+        if (other.others)
+            others.reset(new std::map<std::string,double>(*other.others));
+        else
+            others.reset();
+    }
+    return *this;
+}
+
+std::size_t CommandParams::index(int s) const
+{
+    return std::bitset<32>(mask & ((1u<<s)-1)).count();
+}
+
+const std::string& CommandParams::letterName(int s)
+{
+    static const std::string names[26] = {
+        "A","B","C","D","E","F","G","H","I","J","K","L","M",
+        "N","O","P","Q","R","S","T","U","V","W","X","Y","Z"};
+    return names[s];
+}
+
+double& CommandParams::operator[](char letter)
+{
+    int s = slot(letter);
+    if (s<0)
+        return (*this)[std::string(1,letter)];
+    std::size_t idx = index(s);
+    if (!(mask & (1u<<s))) {
+        mask |= (1u<<s);
+        values.insert(values.begin()+idx, 0.0);
+    }
+    return values[idx];
+}
+
+double& CommandParams::operator[](const std::string& name)
+{
+    if (name.size() == 1 && slot(name[0]) >= 0)
+        return (*this)[name[0]];
+    if (!others)
+        others.reset(new std::map<std::string,double>);
+    return (*others)[name];
+}
+
+std::size_t CommandParams::count(const std::string& name) const
+{
+    if (name.size() == 1 && slot(name[0]) >= 0)
+        return has(name[0]) ? 1 : 0;
+    return others ? others->count(name) : 0;
+}
+
+double CommandParams::get(const std::string& name, double fallback) const
+{
+    if (name.size() == 1 && slot(name[0]) >= 0)
+        return get(name[0], fallback);
+    if (!others)
+        return fallback;
+    auto it = others->find(name);
+    return it==others->end() ? fallback : it->second;
+}
+
+void CommandParams::clear()
+{
+    mask = 0;
+    values.clear();
+    others.reset();
+}
+
+std::map<std::string,double> CommandParams::toMap() const
+{
+    std::map<std::string,double> result;
+    forEach([&result](const std::string& name, double value) {
+        result[name] = value;
+    });
+    return result;
+}
+
 TYPESYSTEM_SOURCE(Path::Command , Base::Persistence)
 
 // Constructors & destructors
@@ -62,30 +168,23 @@ Command::~Command()
 
 Placement Command::getPlacement (const Base::Vector3d pos) const
 {
-    static const std::string x = "X";
-    static const std::string y = "Y";
-    static const std::string z = "Z";
-    static const std::string a = "A";
-    static const std::string b = "B";
-    static const std::string c = "C";
-    Vector3d vec(getParam(x, pos.x),getParam(y, pos.y),getParam(z, pos.z));
+    Vector3d vec(getParam('X', pos.x),getParam('Y', pos.y),getParam('Z', pos.z));
     Rotation rot;
-    rot.setYawPitchRoll(getParam(a),getParam(b),getParam(c));
+    rot.setYawPitchRoll(getParam('A'),getParam('B'),getParam('C'));
     Placement plac(vec,rot);
     return plac;
 }
 
 Vector3d Command::getCenter (void) const
 {
-    static const std::string i = "I";
-    static const std::string j = "J";
-    static const std::string k = "K";
-    Vector3d vec(getParam(i),getParam(j),getParam(k));
+    Vector3d vec(getParam('I'),getParam('J'),getParam('K'));
     return vec;
 }
 
 double Command::getValue(const std::string& attr) const
 {
+    if (attr.size() == 1)
+        return getParam(static_cast<char>(toupper(attr[0])));
     std::string a(attr);
     boost::to_upper(a);
     return getParam(a);
@@ -93,6 +192,8 @@ double Command::getValue(const std::string& attr) const
 
 bool Command::has(const std::string& attr) const
 {
+    if (attr.size() == 1)
+        return Parameters.has(static_cast<char>(toupper(attr[0])));
     std::string a(attr);
     boost::to_upper(a);
     return Parameters.count(a) > 0;
@@ -100,102 +201,127 @@ bool Command::has(const std::string& attr) const
 
 std::string Command::toGCode (int precision, bool padzero) const
 {
-    std::stringstream str;
-    str.fill('0');
-    str << Name;
+    std::string result;
+    appendGCode(result, precision, padzero);
+    return result;
+}
+
+// writes the digits of a non negative number, left padded with '0' to width
+static void appendDigits(std::string &out, std::int64_t v, int width = 0)
+{
+    char buf[32];
+    int len = 0;
+    do {
+        buf[len++] = static_cast<char>('0' + v%10);
+        v /= 10;
+    } while (v && len < 31);
+    for (int i=len; i<width; ++i)
+        out += '0';
+    while (len)
+        out += buf[--len];
+}
+
+void Command::appendGCode (std::string &out, int precision, bool padzero) const
+{
+    out += Name;
     if(precision<0)
         precision = 0;
     double scale = std::pow(10.0,precision+1);
     std::int64_t iscale = static_cast<std::int64_t>(scale)/10;
-    for(std::map<std::string,double>::const_iterator i = Parameters.begin(); i != Parameters.end(); ++i) {
-        if(i->first == "N") continue;
+    Parameters.forEach([&](const std::string &name, double value) {
+        if(name == "N") return;
 
-        str << " " << i->first;
+        out += ' ';
+        out += name;
 
-        std::int64_t v = static_cast<std::int64_t>(i->second*scale);
+        std::int64_t v = static_cast<std::int64_t>(value*scale);
         if(v<0) {
             v = -v;
-            str << '-'; //shall we allow -0 ?
+            out += '-'; //shall we allow -0 ?
         }
         v+=5;
         v /= 10;
-        str << (v/iscale);
-        if(!precision) continue;
+        appendDigits(out, v/iscale);
+        if(!precision) return;
 
         int width = precision;
         std::int64_t digits = v%iscale;
         if(!padzero) {
-            if(!digits) continue;
+            if(!digits) return;
             while(digits%10 == 0) {
                 digits/=10;
                 --width;
             }
         }
-        str << '.' << std::setw(width) << std::right << digits;
-    }
-    return str.str();
+        out += '.';
+        appendDigits(out, digits, width);
+    });
 }
 
 void Command::setFromGCode (const std::string& str)
 {
+    setFromGCode(str.c_str(), str.c_str()+str.size());
+}
+
+void Command::setFromGCode (const char *begin, const char *end)
+{
+    // A single pass over the characters. The key of a word is always a
+    // single character, and the value buffer is reused between words.
+    enum { ModeNone, ModeCommand, ModeArgument, ModeComment } mode = ModeNone;
     Parameters.clear();
-    std::string mode = "none";
-    std::string key;
+    char key = 0;
     std::string value;
-    for (unsigned int i=0; i < str.size(); i++) {
-        if ( (isdigit(str[i])) || (str[i] == '-') || (str[i] == '.') ) {
-            value += str[i];
-        } else if (isalpha(str[i])) {
-            if (mode == "command") {
-                if (!key.empty() && !value.empty()) {
-                    std::string cmd = key + value;
-                    boost::to_upper(cmd);
-                    Name = cmd;
-                    key = "";
-                    value = "";
-                    mode = "argument";
+    for (const char *c = begin; c != end; ++c) {
+        if ( (isdigit(*c)) || (*c == '-') || (*c == '.') ) {
+            value += *c;
+        } else if (isalpha(*c)) {
+            if (mode == ModeCommand) {
+                if (key && !value.empty()) {
+                    Name.assign(1, key);
+                    Name += value;
+                    boost::to_upper(Name);
+                    key = 0;
+                    value.clear();
                 } else {
                     throw Base::BadFormatError("Badly formatted GCode command");
                 }
-                mode = "argument";
-            } else if (mode == "none") {
-                mode = "command";
-            } else if (mode == "argument") {
-                if (!key.empty() && !value.empty()) {
+                mode = ModeArgument;
+            } else if (mode == ModeNone) {
+                mode = ModeCommand;
+            } else if (mode == ModeArgument) {
+                if (key && !value.empty()) {
                     double val = std::atof(value.c_str());
-                    boost::to_upper(key);
-                    Parameters[key] = val;
-                    key = "";
-                    value = "";
+                    Parameters[static_cast<char>(toupper(key))] = val;
+                    key = 0;
+                    value.clear();
                 } else {
                     throw Base::BadFormatError("Badly formatted GCode argument");
                 }
-            } else if (mode == "comment") {
-                value += str[i];
+            } else if (mode == ModeComment) {
+                value += *c;
             }
-            key = str[i];
-        } else if (str[i] == '(') {
-            mode = "comment";
-        } else if (str[i] == ')') {
-            key = "(";
+            key = *c;
+        } else if (*c == '(') {
+            mode = ModeComment;
+        } else if (*c == ')') {
+            key = '(';
             value += ")";
         } else {
             // add non-ascii characters only if this is a comment
-            if (mode == "comment") {
-                value += str[i];
+            if (mode == ModeComment) {
+                value += *c;
             }
         }
     }
-    if (!key.empty() && !value.empty()) {
-        if ( (mode == "command") || (mode == "comment") ) {
-            std::string cmd = key + value;
-            if (mode == "command")
-                boost::to_upper(cmd);
-            Name = cmd;
+    if (key && !value.empty()) {
+        if ( (mode == ModeCommand) || (mode == ModeComment) ) {
+            Name.assign(1, key);
+            Name += value;
+            if (mode == ModeCommand)
+                boost::to_upper(Name);
         } else {
             double val = std::atof(value.c_str());
-            boost::to_upper(key);
-            Parameters[key] = val;
+            Parameters[static_cast<char>(toupper(key))] = val;
         }
     } else {
         throw Base::BadFormatError("Badly formatted GCode argument");
@@ -206,29 +332,23 @@ void Command::setFromPlacement (const Base::Placement &plac)
 {
     Name = "G1";
     Parameters.clear();
-    static const std::string x = "X";
-    static const std::string y = "Y";
-    static const std::string z = "Z";
-    static const std::string a = "A";
-    static const std::string b = "B";
-    static const std::string c = "C";
     double xval, yval, zval, aval, bval, cval;
     xval = plac.getPosition().x;
     yval = plac.getPosition().y;
     zval = plac.getPosition().z;
     plac.getRotation().getYawPitchRoll(aval,bval,cval);
     if (xval != 0.0)
-        Parameters[x] = xval;
+        Parameters['X'] = xval;
     if (yval != 0.0)
-        Parameters[y] = yval;
+        Parameters['Y'] = yval;
     if (zval != 0.0)
-        Parameters[z] = zval;
+        Parameters['Z'] = zval;
     if (aval != 0.0)
-        Parameters[a] = aval;
+        Parameters['A'] = aval;
     if (bval != 0.0)
-        Parameters[b] = bval;
+        Parameters['B'] = bval;
     if (cval != 0.0)
-        Parameters[c] = cval;
+        Parameters['C'] = cval;
 }
 
 void Command::setCenter(const Base::Vector3d &pos, bool clockwise)
@@ -238,16 +358,13 @@ void Command::setCenter(const Base::Vector3d &pos, bool clockwise)
     } else {
         Name = "G3";
     }
-    static const std::string i = "I";
-    static const std::string j = "J";
-    static const std::string k = "K";
     double ival, jval, kval;
     ival = pos.x;
     jval = pos.y;
     kval = pos.z;
-    Parameters[i] = ival;
-    Parameters[j] = jval;
-    Parameters[k] = kval;
+    Parameters['I'] = ival;
+    Parameters['J'] = jval;
+    Parameters['K'] = kval;
 }
 
 Command Command::transform(const Base::Placement& other)
@@ -261,30 +378,20 @@ Command Command::transform(const Base::Placement& other)
     plac.getRotation().getYawPitchRoll(aval,bval,cval);
     Command c = Command();
     c.Name = Name;
-    for(std::map<std::string,double>::const_iterator i = Parameters.begin(); i != Parameters.end(); ++i) {
-        std::string k = i->first;
-        double v = i->second;
-        if (k == "X")
-            v = xval;
-        if (k == "Y")
-            v = yval;
-        if (k == "Z")
-            v = zval;
-        if (k == "A")
-            v = aval;
-        if (k == "B")
-            v = bval;
-        if (k == "C")
-            v = cval;
-        c.Parameters[k] = v;
+    c.Parameters = Parameters;
+    const char letters[] = {'X','Y','Z','A','B','C'};
+    const double vals[] = {xval, yval, zval, aval, bval, cval};
+    for (int i=0; i<6; ++i) {
+        if (c.Parameters.has(letters[i]))
+            c.Parameters[letters[i]] = vals[i];
     }
     return c;
 }
 
 void Command::scaleBy(double factor)
 {
-    for(std::map<std::string, double>::const_iterator i = Parameters.begin(); i != Parameters.end(); ++i) {
-        switch (i->first[0]) {
+    Parameters.forEach([factor](const std::string &name, double &value) {
+        switch (name[0]) {
             case 'X':
             case 'Y':
             case 'Z':
@@ -293,10 +400,10 @@ void Command::scaleBy(double factor)
             case 'R':
             case 'Q':
             case 'F':
-                Parameters[i->first] = i->second * factor;
+                value *= factor;
                 break;
         }
-    }
+    });
 }
 
 // Reimplemented from base class
@@ -25,13 +25,91 @@
 #define PATH_COMMAND_H
 
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
+#include <cstdint>
 #include <Base/Persistence.h>
 #include <Base/Placement.h>
 #include <Base/Vector3D.h>
 
 namespace Path
 {
+    /** Compact storage of the parameters (words) of a command
+     *
+     * G-code words are single upper case letters. Their values are kept in a
+     * vector ordered by letter, together with a bit mask telling which letters
+     * are present, so a command needs a single small allocation instead of one
+     * map node per word. Any other key, which can only be set from Python, is
+     * kept in a separate map.
+     */
+    class PathExport CommandParams
+    {
+    public:
+        CommandParams();
+        CommandParams(const std::map<std::string,double>& parameters);
+        CommandParams(const CommandParams& other);
+        CommandParams& operator=(const CommandParams& other);
+
+        // returns a reference to the value of the given key, adding it if missing
+        double& operator[](const std::string& name);
+        double& operator[](char letter);
+
+        std::size_t count(const std::string& name) const;
+        bool has(char letter) const {
+            int s = slot(letter);
+            return s<0 ? count(std::string(1,letter))>0 : (mask & (1u<<s))!=0;
+        }
+        double get(const std::string& name, double fallback = 0.0) const;
+        double get(char letter, double fallback = 0.0) const {
+            int s = slot(letter);
+            if (s<0)
+                return get(std::string(1,letter), fallback);
+            return (mask & (1u<<s)) ? values[index(s)] : fallback;
+        }
+        void clear();
+        bool empty() const { return size() == 0; }
+        std::size_t size() const { return values.size() + (others ? others->size() : 0); }
+        std::map<std::string,double> toMap() const;
+
+        // calls f(name, value) for each parameter in alphabetical order
+        template<class Func> void forEach(Func f) const { visit(*this, f); }
+        template<class Func> void forEach(Func f) { visit(*this, f); }
+
+    private:
+        static int slot(char letter) {
+            return (letter>='A' && letter<='Z') ? letter-'A' : -1;
+        }
+        std::size_t index(int s) const;
+        static const std::string& letterName(int s);
+
+        template<class Self, class Func>
+        static void visit(Self& self, Func& f) {
+            typedef std::map<std::string,double>::iterator Iter;
+            bool haveOthers = self.others && !self.others->empty();
+            Iter it, itEnd;
+            if (haveOthers) {
+                it = self.others->begin();
+                itEnd = self.others->end();
+            }
+            std::size_t idx = 0;
+            for (int s=0; s<26; ++s) {
+                if (!(self.mask & (1u<<s)))
+                    continue;
+                const std::string& name = letterName(s);
+                for (; haveOthers && it!=itEnd && it->first<name; ++it)
+                    f(it->first, it->second);
+                f(name, self.values[idx++]);
+            }
+            for (; haveOthers && it!=itEnd; ++it)
+                f(it->first, it->second);
+        }
+
+        std::uint32_t mask;
+        std::vector<double> values;
+        std::unique_ptr<std::map<std::string,double> > others;
+    };
+
     /** The representation of a cnc command in a path */
     class PathExport Command : public Base::Persistence
     {
@@ -53,7 +131,9 @@ namespace Path
         Base::Vector3d getCenter (void) const; // returns a 3d vector from the i,j,k parameters
         void setCenter(const Base::Vector3d&, bool clockwise=true); // sets the center coordinates and the command name
         std::string toGCode (int precision=6, bool padzero=true) const; // returns a GCode string representation of the command
+        void appendGCode (std::string &out, int precision=6, bool padzero=true) const; // appends the GCode representation of the command to out
         void setFromGCode (const std::string&); // sets the parameters from the contents of the given GCode string
+        void setFromGCode (const char *begin, const char *end); // same as above, for the characters in [begin, end)
         void setFromPlacement (const Base::Placement&); // sets the parameters from the contents of the given placement
         bool has(const std::string&) const; // returns true if the given string exists in the parameters
         Command transform(const Base::Placement&); // returns a transformed copy of this command
@@ -62,13 +142,15 @@ namespace Path
 
         // this assumes the name is upper case
         inline double getParam(const std::string &name, double fallback = 0.0) const {
-            auto it = Parameters.find(name);
-            return it==Parameters.end() ? fallback : it->second;
+            return Parameters.get(name, fallback);
+        }
+        inline double getParam(char letter, double fallback = 0.0) const {
+            return Parameters.get(letter, fallback);
         }
 
         // attributes
         std::string Name;
-        std::map<std::string,double> Parameters;
+        CommandParams Parameters;
     };
     
 } //namespace Path
@@ -47,11 +47,9 @@ std::string CommandPy::representation(void) const
     str << "Command ";
     str << getCommandPtr()->Name;
     str << " [";
-    for(std::map<std::string,double>::iterator i = getCommandPtr()->Parameters.begin(); i != getCommandPtr()->Parameters.end(); ++i) {
-        std::string k = i->first;
-        double v = i->second;
+    getCommandPtr()->Parameters.forEach([&str](const std::string &k, double v) {
         str << " " << k << ":" << v;
-    }
+    });
     str << " ]";
     return str.str();
 }
@@ -165,9 +163,9 @@ Py::Dict CommandPy::getParameters(void) const
 {
     // dict now a class member , https://forum.freecadweb.org/viewtopic.php?f=15&t=50583
     if (parameters_copy_dict.length()==0) {    
-      for(std::map<std::string,double>::iterator i = getCommandPtr()->Parameters.begin(); i != getCommandPtr()->Parameters.end(); ++i) {
-          parameters_copy_dict.setItem(i->first, Py::Float(i->second));
-      }
+      getCommandPtr()->Parameters.forEach([this](const std::string &k, double v) {
+          parameters_copy_dict.setItem(k, Py::Float(v));
+      });
     }
     return parameters_copy_dict;
 }
@@ -284,8 +282,8 @@ PyObject *CommandPy::getCustomAttributes(const char* attr) const
     if (satt.length() == 1) {
         if (isalpha(satt[0])) {
             boost::to_upper(satt);
-            if (getCommandPtr()->Parameters.count(satt)) {
-                return PyFloat_FromDouble(getCommandPtr()->Parameters[satt]);
+            if (getCommandPtr()->Parameters.has(satt[0])) {
+                return PyFloat_FromDouble(getCommandPtr()->Parameters.get(satt[0]));
             }
             Py_INCREF(Py_None);
             return Py_None;
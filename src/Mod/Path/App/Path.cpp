@@ -24,9 +24,15 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
+# include <exception>
+# include <istream>
+# include <ostream>
 # include <boost/regex.hpp>
 #endif
 
+#include <QtConcurrentMap>
+
 #include <App/Application.h>
 #include <Base/Console.h>
 #include <Base/Exception.h>
@@ -286,87 +292,218 @@ Base::BoundBox3d Toolpath::getBoundBox() const
     return visitor.bb;
 }
 
-static void bulkAddCommand(const std::string &gcodestr, std::vector<Command*> &commands, bool &inches)
+Base::BoundBox3d Toolpath::getBoundBox(std::istream &in)
 {
-    Command *cmd = new Command();
-    cmd->setFromGCode(gcodestr);
-    if ("G20" == cmd->Name) {
-        inches = true;
-        delete cmd;
-    } else if ("G21" == cmd->Name) {
-        inches = false;
-        delete cmd;
-    } else {
-        if (inches) {
-            cmd->scaleBy(25.4);
-        }
-        commands.push_back(cmd);
-    }
+    BoundBoxSegmentVisitor visitor;
+    PathSegmentWalker::walk(in, visitor, Vector3d(0, 0, 0));
+
+    return visitor.bb;
 }
 
-void Toolpath::setFromGCode(const std::string instr)
+namespace {
+
+// the text of a single command, and the result of parsing it
+struct GCodeRange
 {
-    clear();
+    GCodeRange(const char *b, const char *e)
+        :begin(b),end(e),cmd(0)
+    {}
+
+    const char *begin;
+    const char *end;
+    Command *cmd;
+    std::exception_ptr error;
+};
 
-    // remove comments
-    //boost::regex e("\\(.*?\\)");
-    //std::string str = boost::regex_replace(instr, e, "");
-    std::string str(instr);
+struct GCodeRangeParser
+{
+    void operator()(GCodeRange &range) const
+    {
+        try {
+            Command *cmd = new Command();
+            range.cmd = cmd;
+            cmd->setFromGCode(range.begin, range.end);
+        } catch (...) {
+            range.error = std::current_exception();
+        }
+    }
+};
+
+// below this number of commands the parsing is not worth the threads
+const std::size_t GCodeParallelThreshold = 256;
+
+} // anonymous namespace
 
-    // split input string by () or G or M commands
-    std::string mode = "command";
+// Splits the string by () or G or M commands. If final is false, the last
+// command may not be complete yet, and is left in the string. Returns the
+// number of characters consumed.
+static std::size_t splitGCode(const std::string &str, bool final, std::vector<GCodeRange> &ranges)
+{
+    const char *data = str.c_str();
+    bool commandMode = true;
     std::size_t found = str.find_first_of("(gGmM");
     int last = -1;
-    bool inches = false;
     while (found != std::string::npos)
     {
         if (str[found] == '(') {
             // start of comment
-            if ( (last > -1) && (mode == "command") ) {
+            if ( (last > -1) && commandMode ) {
                 // before opening a comment, add the last found command
-                std::string gcodestr = str.substr(last, found-last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
+                ranges.emplace_back(data+last, data+found);
             }
-            mode = "comment";
+            commandMode = false;
             last = found;
             found = str.find_first_of(')', found+1);
         } else if (str[found] == ')') {
             // end of comment
-            std::string gcodestr = str.substr(last, found-last+1);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
+            ranges.emplace_back(data+last, data+found+1);
             last = -1;
             found = str.find_first_of("(gGmM", found+1);
-            mode = "command";
-        } else if (mode == "command") {
+            commandMode = true;
+        } else if (commandMode) {
             // command
             if (last > -1) {
-                std::string gcodestr = str.substr(last, found-last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
+                ranges.emplace_back(data+last, data+found);
             }
             last = found;
             found = str.find_first_of("(gGmM", found+1);
         }
     }
-    // add the last command found, if any
     if (last > -1) {
-        if (mode == "command") {
-            std::string gcodestr = str.substr(last,std::string::npos);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
+        if (!final)
+            return last;
+        // add the last command found, if any. An unterminated comment is dropped
+        if (commandMode)
+            ranges.emplace_back(data+last, data+str.size());
+    }
+    return str.size();
+}
+
+static void parseGCode(std::vector<GCodeRange> &ranges, std::vector<Command*> &commands, bool &inches)
+{
+    if (ranges.size() < GCodeParallelThreshold)
+        std::for_each(ranges.begin(), ranges.end(), GCodeRangeParser());
+    else
+        QtConcurrent::blockingMap(ranges, GCodeRangeParser());
+
+    // unit changes apply to the following commands, so they are done in order
+    std::exception_ptr error;
+    commands.reserve(commands.size() + ranges.size());
+    for (auto &range : ranges) {
+        Command *cmd = range.cmd;
+        if (error || range.error) {
+            if (!error)
+                error = range.error;
+            delete cmd;
+        } else if ("G20" == cmd->Name) {
+            inches = true;
+            delete cmd;
+        } else if ("G21" == cmd->Name) {
+            inches = false;
+            delete cmd;
+        } else {
+            if (inches) {
+                cmd->scaleBy(25.4);
+            }
+            commands.push_back(cmd);
         }
     }
+    if (error)
+        std::rethrow_exception(error);
+}
+
+GCodeParser::GCodeParser()
+    :inches(false)
+{
+}
+
+void GCodeParser::parse(const char *data, std::size_t size, std::vector<Command*> &commands)
+{
+    buffer.append(data, size);
+    std::vector<GCodeRange> ranges;
+    std::size_t consumed = splitGCode(buffer, false, ranges);
+    parseGCode(ranges, commands, inches);
+    buffer.erase(0, consumed);
+}
+
+void GCodeParser::finish(std::vector<Command*> &commands)
+{
+    std::vector<GCodeRange> ranges;
+    splitGCode(buffer, true, ranges);
+    parseGCode(ranges, commands, inches);
+    buffer.clear();
+}
+
+bool GCodeParser::read(std::istream &in, std::vector<Command*> &commands, std::size_t chunkSize)
+{
+    chunk.resize(chunkSize);
+    if (in.good()) {
+        in.read(&chunk[0], chunk.size());
+        std::streamsize count = in.gcount();
+        if (count > 0)
+            parse(&chunk[0], count, commands);
+        if (in.good())
+            return true;
+    }
+    finish(commands);
+    return false;
+}
+
+void GCodeParser::parse(const std::string &str, std::vector<Command*> &commands)
+{
+    std::vector<GCodeRange> ranges;
+    splitGCode(str, true, ranges);
+    bool inches = false;
+    parseGCode(ranges, commands, inches);
+}
+
+void Toolpath::setFromGCode(const std::string instr)
+{
+    clear();
+
+    // remove comments
+    //boost::regex e("\\(.*?\\)");
+    //std::string str = boost::regex_replace(instr, e, "");
+    GCodeParser::parse(instr, vpcCommands);
+    recalculate();
+}
+
+void Toolpath::setFromGCode(std::istream &in)
+{
+    clear();
+
+    GCodeParser parser;
+    while (parser.read(in, vpcCommands));
     recalculate();
 }
 
 std::string Toolpath::toGCode(void) const
 {
     std::string result;
+    // most commands fit in this, so the string is rarely regrown
+    result.reserve(vpcCommands.size()*32);
     for (std::vector<Command*>::const_iterator it=vpcCommands.begin();it!=vpcCommands.end();++it) {
-        result += (*it)->toGCode();
-        result += "\n";
+        (*it)->appendGCode(result);
+        result += '\n';
     }
     return result;
 }
 
+void Toolpath::toGCode(std::ostream &out) const
+{
+    std::string chunk;
+    chunk.reserve(GCodeParser::DefaultChunkSize + 1024);
+    for (std::vector<Command*>::const_iterator it=vpcCommands.begin();it!=vpcCommands.end();++it) {
+        (*it)->appendGCode(chunk);
+        chunk += '\n';
+        if (chunk.size() >= GCodeParser::DefaultChunkSize) {
+            out.write(chunk.c_str(), chunk.size());
+            chunk.clear();
+        }
+    }
+    out.write(chunk.c_str(), chunk.size());
+}
+
 void Toolpath::recalculate(void) // recalculates the path cache
 {
 
@@ -470,9 +607,9 @@ void Toolpath::Save (Writer &writer) const
 
 void Toolpath::SaveDocFile (Base::Writer &writer) const
 {
-    if (toGCode().empty())
+    if (vpcCommands.empty())
         return;
-    writer.Stream() << toGCode();
+    toGCode(writer.Stream());
 }
 
 void Toolpath::Restore(XMLReader &reader)
@@ -488,13 +625,23 @@ void Toolpath::Restore(XMLReader &reader)
 
 void Toolpath::RestoreDocFile(Base::Reader &reader)
 {
+    clear();
+
+    // the words are joined by spaces, and parsed a chunk at a time
+    GCodeParser parser;
     std::string gcode;
     std::string line;
     while (reader >> line) {
         gcode += line;
         gcode += " ";
+        if (gcode.size() >= GCodeParser::DefaultChunkSize) {
+            parser.parse(gcode.c_str(), gcode.size(), vpcCommands);
+            gcode.clear();
+        }
     }
-    setFromGCode(gcode);
+    parser.parse(gcode.c_str(), gcode.size(), vpcCommands);
+    parser.finish(vpcCommands);
+    recalculate();
 
 }
 
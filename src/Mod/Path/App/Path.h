@@ -30,10 +30,48 @@
 #include <Base/BoundBox.h>
 #include <Base/Persistence.h>
 #include <Base/Vector3D.h>
+#include <iosfwd>
+#include <vector>
 
 namespace Path
 {
 
+    /** Incremental G-code parser
+     *
+     * The input text is fed in chunks of any size. Each call parses the
+     * commands that are complete so far, and keeps the unfinished command
+     * at the end for the next call. The commands of a chunk are parsed
+     * concurrently when there are enough of them. G20/G21 are consumed by
+     * the parser and the following commands are converted to mm, as done
+     * by Toolpath::setFromGCode().
+     *
+     * The parsed commands are appended to the given vector and owned by
+     * the caller.
+     */
+    class PathExport GCodeParser
+    {
+        public:
+            static const std::size_t DefaultChunkSize = 1<<22;
+
+            GCodeParser();
+
+            // parses the commands completed by the given text
+            void parse(const char *data, std::size_t size, std::vector<Command*> &commands);
+            // parses what is left once the end of the input is reached
+            void finish(std::vector<Command*> &commands);
+            // reads and parses the next chunk, returns false at the end of the input
+            bool read(std::istream &in, std::vector<Command*> &commands,
+                    std::size_t chunkSize=DefaultChunkSize);
+
+            // parses the commands of the whole string at once
+            static void parse(const std::string &str, std::vector<Command*> &commands);
+
+        private:
+            std::string buffer;
+            std::vector<char> chunk;
+            bool inches;
+    };
+
     /** The representation of a CNC Toolpath */
     
     class PathExport Toolpath : public Base::Persistence
@@ -63,8 +101,11 @@ namespace Path
             double getCycleTime(double, double, double, double); // return the Cycle Time (s) of the Path
             void recalculate(void); // recalculates the points
             void setFromGCode(const std::string); // sets the path from the contents of the given GCode string
+            void setFromGCode(std::istream &in); // sets the path from a GCode stream, read in chunks
             std::string toGCode(void) const; // gets a gcode string representation from the Path
+            void toGCode(std::ostream &out) const; // writes the gcode to a stream, in chunks
             Base::BoundBox3d getBoundBox(void) const;
+            static Base::BoundBox3d getBoundBox(std::istream &in); // bound box of a GCode stream, without creating a Toolpath
             
             // shortcut functions
             unsigned int getSize(void) const { return vpcCommands.size(); }
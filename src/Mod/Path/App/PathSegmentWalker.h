@@ -26,6 +26,7 @@
 #include <Mod/Path/App/Path.h>
 
 #include <deque>
+#include <istream>
 
 namespace Path
 {
@@ -62,6 +63,16 @@ public:
 
     void walk(PathSegmentVisitor &cb, const Base::Vector3d &startPosition);
 
+    /**
+     * Walks the G-code read from the given stream without creating a Toolpath.
+     * The stream is parsed a chunk at a time, so only the commands of a single
+     * chunk are in memory at any time. The ids passed to the visitor are the
+     * indices the commands would have in a Toolpath. center is the rotation
+     * center, see Toolpath::getCenter().
+     */
+    static void walk(std::istream &in, PathSegmentVisitor &cb, const Base::Vector3d &startPosition,
+            const Base::Vector3d &center = Base::Vector3d());
+
 private:
     const Toolpath &tp;
 };
@@ -164,3 +164,103 @@ G0 Z0.500000
         path = Path.Path(commands)
 
         self.assertEqual(path.Length, 2)
+
+    def test60(self):
+        """Test reading and writing large gcode files"""
+        import os
+        import tempfile
+
+        # enough commands to be parsed concurrently, with unit changes in between
+        lines = []
+        for i in range(2000):
+            if i == 1000:
+                lines.append('G20')
+            if i == 1500:
+                lines.append('(back to mm) G21')
+            lines.append('G1 X%d Y%d.5 F100' % (i, i))
+        gcode = '\n'.join(lines) + '\n'
+
+        path = Path.Path()
+        path.setFromGCode(gcode)
+        self.assertEqual(len(path.Commands), 2001)
+        self.assertEqual(path.Commands[999].Parameters, {'F': 100, 'X': 999, 'Y': 999.5})
+        self.assertAlmostEqual(path.Commands[1000].X, 25400)
+        self.assertAlmostEqual(path.Commands[1000].Y, 25412.7)
+        self.assertAlmostEqual(path.Commands[1000].F, 2540)
+        self.assertEqual(path.Commands[1500].Name, '(back to mm)')
+        self.assertEqual(path.Commands[1501].Parameters, {'F': 100, 'X': 1500, 'Y': 1500.5})
+
+        doc = FreeCAD.newDocument("TestPathCoreIO")
+        try:
+            obj = doc.addObject("Path::Feature", "Path")
+            obj.Path = path
+            fd, name = tempfile.mkstemp(suffix='.ngc')
+            os.close(fd)
+            try:
+                Path.write(obj, name)
+                Path.read(name, doc.Name)
+            finally:
+                os.remove(name)
+            imported = [o for o in doc.Objects if o != obj]
+            self.assertEqual(len(imported), 1)
+            self.assertEqual(imported[0].Path.toGCode(), path.toGCode())
+        finally:
+            FreeCAD.closeDocument(doc.Name)
+
+    def test61(self):
+        """Test walking a gcode file without creating a path"""
+        import os
+        import tempfile
+
+        gcode = '\n'.join([
+            'G0 X0 Y0 Z5',
+            'G1 Z-1 F100',
+            'G2 X10 Y0 I5 J0',
+            'G3 X0 Y0 I-5 J0',
+            'G81 X20 Y20 Z-3 R2',
+            'G80',
+            'G20',
+            'G1 X-1 Y2',
+            'G21',
+            'G0 Z10']) + '\n'
+        path = Path.Path()
+        path.setFromGCode(gcode)
+
+        fd, name = tempfile.mkstemp(suffix='.ngc')
+        os.close(fd)
+        try:
+            with open(name, 'w') as f:
+                f.write(gcode)
+            bb = Path.boundBox(name)
+        finally:
+            os.remove(name)
+
+        expected = path.BoundBox
+        self.assertCoincide(bb.getPoint(0), expected.getPoint(0))
+        self.assertCoincide(bb.getPoint(6), expected.getPoint(6))
+        self.assertRoughly(bb.XMin, -25.4)
+        self.assertRoughly(bb.ZMax, 10)
+
+    def test70(self):
+        """Test Path.Area sections sliced concurrently"""
+        import Part
+
+        shape = Part.makeCylinder(5, 10).fuse(Part.makeBox(20, 4, 6, FreeCAD.Vector(0, -2, 0)))
+        heights = [9.5 - i for i in range(10)]
+
+        def sections(threads):
+            area = Path.Area(SectionThreads=threads)
+            area.setPlane(Part.makeCircle(10))
+            area.add(shape)
+            return [s.getShape() for s in area.makeSections(mode=0, project=False, heights=heights)]
+
+        serial = sections(1)
+        concurrent = sections(4)
+        self.assertEqual(len(serial), len(heights))
+        self.assertEqual(len(concurrent), len(serial))
+        for s, c in zip(serial, concurrent):
+            self.assertEqual(len(s.Edges), len(c.Edges))
+            self.assertRoughly(s.Area, c.Area)
+            self.assertRoughly(s.Length, c.Length)
+            self.assertCoincide(s.BoundBox.getPoint(0), c.BoundBox.getPoint(0))
+            self.assertCoincide(s.BoundBox.getPoint(6), c.BoundBox.getPoint(6))
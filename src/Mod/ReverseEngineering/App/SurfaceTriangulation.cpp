@@ -485,6 +485,7 @@ void ImageTriangulation::perform()
         meshAlg.GetPointsFlag(invalidPoints, MeshCore::MeshPoint::INVALID);
 
         kernel.DeletePoints(invalidPoints);
+        myMesh.resetAdjacency();
     }
 }
 
@@ -87,20 +87,27 @@ void Segmentation::accept()
     MeshCore::MeshKernel kernel = mesh->getKernel();
     MeshCore::MeshAlgorithm algo(kernel);
 
+    // use the cached curvature of the mesh unless it gets smoothed
+    std::shared_ptr<const std::vector<MeshCore::CurvatureInfo> > curvature;
     if (ui->checkBoxSmooth->isChecked()) {
         MeshCore::LaplaceSmoothing smoother(kernel);
         smoother.Smooth(ui->smoothSteps->value());
+        MeshCore::MeshCurvature meshCurv(kernel);
+        meshCurv.ComputePerVertex();
+        curvature = std::make_shared<std::vector<MeshCore::CurvatureInfo> >(meshCurv.GetCurvature());
+    }
+    else {
+        curvature = mesh->getCurvaturePerVertex();
     }
 
     MeshCore::MeshSegmentAlgorithm finder(kernel);
-    MeshCore::MeshCurvature meshCurv(kernel);
-    meshCurv.ComputePerVertex();
+    finder.SetParallel(true);
 
     // First create segments by curavture to get the surface type
     std::vector<MeshCore::MeshSurfaceSegmentPtr> segm;
     if (ui->groupBoxPln->isChecked()) {
         segm.emplace_back(std::make_shared<MeshCore::MeshCurvaturePlanarSegment>
-            (meshCurv.GetCurvature(), ui->numPln->value(), ui->curvTolPln->value()));
+            (*curvature, ui->numPln->value(), ui->curvTolPln->value()));
     }
     finder.FindSegments(segm);
 
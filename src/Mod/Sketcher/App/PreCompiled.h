@@ -52,6 +52,8 @@
 #include <vector>
 #include <set>
 #include <bitset>
+#include <future>
+#include <thread>
 
 #include <cmath>
 #include <algorithm>
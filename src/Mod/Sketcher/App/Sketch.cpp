@@ -73,10 +73,10 @@ TYPESYSTEM_SOURCE(Sketcher::Sketch, Base::Persistence)
 
 Sketch::Sketch()
   : SolveTime(0)
-  , RecalculateInitialSolutionWhileMovingPoint(false)
+  , RecalculateInitialSolutionWhileMovingPoint(true)
   , resolveAfterGeometryUpdated(false)
   , GCSsys(), ConstraintsCounter(0)
-  , isInitMove(false), isFine(true), moveStep(0)
+  , isInitMove(false), isFine(true)
   , defaultSolver(GCS::DogLeg)
   , defaultSolverRedundant(GCS::DogLeg)
   , debugMode(GCS::Minimal)
@@ -126,6 +126,7 @@ void Sketch::clear(void)
 
     GCSsys.clear();
     isInitMove = false;
+    MoveGeometries.clear();
     ConstraintsCounter = 0;
     Conflicting.clear();
     Redundant.clear();
@@ -3287,8 +3288,13 @@ Base::Vector3d Sketch::calculateNormalAtPoint(int geoIdCurve, double px, double
 
 bool Sketch::updateGeometry()
 {
+    // while dragging, the geometries of the subsystems that aren't solved don't change
+    bool onlyMoved = GCSsys.isIncremental() && MoveGeometries.size() == Geoms.size();
+
     int i=0;
     for (std::vector<GeoDef>::const_iterator it=Geoms.begin(); it != Geoms.end(); ++it, i++) {
+        if (onlyMoved && !MoveGeometries[i])
+            continue;
         try {
             if (it->type == Point) {
                 GeomPoint *point = static_cast<GeomPoint*>(it->geo);
@@ -3556,6 +3562,7 @@ int Sketch::internalSolve(std::string & solvername, int level)
 {
     if (!isInitMove) { // make sure we are in single subsystem mode
         clearTemporaryConstraints();
+        GCSsys.setIncremental(false);
         isFine = true;
     }
 
@@ -3598,6 +3605,8 @@ int Sketch::internalSolve(std::string & solvername, int level)
         }
         else {
             updateNonDrivingConstraints();
+            if (isInitMove && GCSsys.isIncremental())
+                GCSsys.acceptSolution(); // the next drag step starts from this solution
         }
     }
     else {
@@ -3968,6 +3977,20 @@ int Sketch::initMove(int geoId, PointPos pos, bool fine)
     InitParameters = MoveParameters;
 
     GCSsys.initSolution();
+
+    // Unless disabled, only the subsystems connected to the dragged geometry are
+    // solved while moving, each time starting from the previous position.
+    GCSsys.setIncremental(RecalculateInitialSolutionWhileMovingPoint);
+
+    GCS::VEC_pD params;
+    GCSsys.getIncrementalParams(params);
+    MoveGeometries.assign(Geoms.size(), false);
+    for (std::vector<double*>::const_iterator it = params.begin(); it != params.end(); ++it) {
+        auto element = param2geoelement.find(*it);
+        if (element != param2geoelement.end())
+            MoveGeometries[element->second.first] = true;
+    }
+
     isInitMove = true;
     return 0;
 }
@@ -3975,6 +3998,7 @@ int Sketch::initMove(int geoId, PointPos pos, bool fine)
 void Sketch::resetInitMove()
 {
     isInitMove = false;
+    GCSsys.setIncremental(false);
 }
 
 int Sketch::movePoint(int geoId, PointPos pos, Base::Vector3d toPoint, bool relative)
@@ -3985,24 +4009,8 @@ int Sketch::movePoint(int geoId, PointPos pos, Base::Vector3d toPoint, bool rela
     if (hasConflicts())
         return -1;
 
-    if (!isInitMove) {
+    if (!isInitMove)
         initMove(geoId, pos);
-        initToPoint = toPoint;
-        moveStep = 0;
-    }
-    else {
-        if(!relative && RecalculateInitialSolutionWhileMovingPoint) {
-            if (moveStep == 0) {
-                moveStep = (toPoint-initToPoint).Length();
-            }
-            else {
-                if( (toPoint-initToPoint).Length() > 20*moveStep) { // I am getting too far away from the original solution so reinit the solution
-                    initMove(geoId, pos);
-                    initToPoint = toPoint;
-                }
-            }
-        }
-    }
 
     if (relative) {
         for (int i=0; i < int(MoveParameters.size()-1); i+=2) {
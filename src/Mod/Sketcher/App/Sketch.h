@@ -138,8 +138,9 @@ public:
     int movePoint(int geoId, PointPos pos, Base::Vector3d toPoint, bool relative=false);
 
     /**
-     * Sets whether the initial solution should be recalculated while dragging after a certain distance from the previous drag point
-     * for smoother dragging operation.
+     * Sets whether the initial solution is recalculated at every step of a drag started by initMove(). If set (the default),
+     * only the subsystems connected to the dragged geometry are solved, each step starting from the result of the previous one.
+     * Otherwise every step solves the whole sketch starting from the solution at initMove().
      */
     bool getRecalculateInitialSolutionWhileMovingPoint() const
         {return RecalculateInitialSolutionWhileMovingPoint;}
@@ -447,6 +448,7 @@ protected:
     std::vector<double*> DrivenParameters;    // with memory allocation
     std::vector<double*> FixParameters; // with memory allocation
     std::vector<double> MoveParameters, InitParameters;
+    std::vector<bool> MoveGeometries; // geometries that are updated while dragging
     std::vector<GCS::Point>  Points;
     std::vector<GCS::Line>   Lines;
     std::vector<GCS::Arc>    Arcs;
@@ -459,8 +461,6 @@ protected:
 
     bool isInitMove;
     bool isFine;
-    Base::Vector3d initToPoint;
-    double moveStep;
 
 public:
     GCS::Algorithm defaultSolver;
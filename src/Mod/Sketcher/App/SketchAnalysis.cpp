@@ -38,6 +38,9 @@
 # include <TopoDS_Vertex.hxx>
 # include <algorithm>
 # include <cmath>
+# include <future>
+# include <set>
+# include <thread>
 #endif
 
 #include <Base/Console.h>
@@ -69,22 +72,19 @@ struct SketchAnalysis::VertexIds {
     Sketcher::PointPos PosId;
 };
 
+// Exact lexicographic order. A comparison with tolerance is not a strict weak
+// ordering and must not be used for sorting.
 struct SketchAnalysis::Vertex_Less
 {
-    Vertex_Less(double tolerance) : tolerance(tolerance){}
     bool operator()(const VertexIds& x,
                     const VertexIds& y) const
     {
-        if (fabs (x.v.x - y.v.x) > tolerance)
+        if (x.v.x != y.v.x)
             return x.v.x < y.v.x;
-        if (fabs (x.v.y - y.v.y) > tolerance)
+        if (x.v.y != y.v.y)
             return x.v.y < y.v.y;
-        if (fabs (x.v.z - y.v.z) > tolerance)
-            return x.v.z < y.v.z;
-        return false; // points are considered to be equal
+        return x.v.z < y.v.z;
     }
-private:
-    double tolerance;
 };
 
 struct SketchAnalysis::Vertex_EqualTo
@@ -113,16 +113,11 @@ struct SketchAnalysis::EdgeIds {
 
 struct SketchAnalysis::Edge_Less
 {
-    Edge_Less(double tolerance) : tolerance(tolerance){}
     bool operator()(const EdgeIds& x,
                     const EdgeIds& y) const
                     {
-                        if (fabs (x.l - y.l) > tolerance)
-                            return x.l < y.l;
-                        return false; // points are considered to be equal
+                        return x.l < y.l;
                     }
-private:
-    double tolerance;
 };
 
 struct SketchAnalysis::Edge_EqualTo
@@ -140,6 +135,43 @@ private:
     double tolerance;
 };
 
+namespace {
+// Identifies the two points of a constraint independent of their order
+typedef std::pair<std::pair<int, int>, std::pair<int, int> > PointPairKey;
+
+PointPairKey makePointPairKey(int first, Sketcher::PointPos firstPos,
+                              int second, Sketcher::PointPos secondPos)
+{
+    std::pair<int, int> a(first, static_cast<int>(firstPos));
+    std::pair<int, int> b(second, static_cast<int>(secondPos));
+    if (b < a)
+        std::swap(a, b);
+    return PointPairKey(a, b);
+}
+
+// Collects the keys of the given types of constraints of the sketch
+std::set<PointPairKey> getConstrainedPairs(const std::vector<Sketcher::Constraint*>& constraints,
+                                           const std::set<Sketcher::ConstraintType>& types)
+{
+    std::set<PointPairKey> pairs;
+    for (auto c : constraints) {
+        if (types.find(c->Type) != types.end())
+            pairs.insert(makePointPairKey(c->First, c->FirstPos, c->Second, c->SecondPos));
+    }
+    return pairs;
+}
+
+// Removes the candidates that are already constrained
+void removeConstrainedPairs(std::vector<ConstraintIds>& candidates, const std::set<PointPairKey>& constrained)
+{
+    if (constrained.empty())
+        return;
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&constrained](const ConstraintIds& id) {
+        return constrained.find(makePointPairKey(id.First, id.FirstPos, id.Second, id.SecondPos)) != constrained.end();
+    }), candidates.end());
+}
+}
+
 int SketchAnalysis::detectMissingPointOnPointConstraints(double precision, bool includeconstruction /*=true*/)
 {
     std::vector<VertexIds> vertexIds;
@@ -224,64 +256,106 @@ int SketchAnalysis::detectMissingPointOnPointConstraints(double precision, bool
         }
     }
 
-    std::sort(vertexIds.begin(), vertexIds.end(), Vertex_Less(precision));
-    std::vector<VertexIds>::iterator vt = vertexIds.begin();
+    std::sort(vertexIds.begin(), vertexIds.end(), Vertex_Less());
     Vertex_EqualTo pred(precision);
 
-    std::list<ConstraintIds> coincidences;
-    // Make a list of constraint we expect for coincident vertexes
-    while (vt < vertexIds.end()) {
-        // get first item whose adjacent element has the same vertex coordinates
-        vt = std::adjacent_find(vt, vertexIds.end(), pred);
-        if (vt < vertexIds.end()) {
-            std::vector<VertexIds>::iterator vn;
-            for (vn = vt+1; vn != vertexIds.end(); ++vn) {
-                if (pred(*vt,*vn)) {
-                    ConstraintIds id;
-                    id.Type = Coincident; // default point on point restriction
-                    id.v = vt->v;
-                    id.First = vt->GeoId;
-                    id.FirstPos = vt->PosId;
-                    id.Second = vn->GeoId;
-                    id.SecondPos = vn->PosId;
-                    coincidences.push_back(id);
-                }
-                else {
-                    break;
+    // Put the vertexes into the cells of a grid whose cell size is the tolerance.
+    // Two vertexes that are considered equal lie in the same or in adjacent cells.
+    typedef std::pair<long long, long long> Cell;
+    double cellSize = precision > 0 ? precision : Precision::Confusion();
+    auto cellOf = [cellSize](const Base::Vector3d& v) {
+        return Cell(static_cast<long long>(std::floor(v.x / cellSize)),
+                    static_cast<long long>(std::floor(v.y / cellSize)));
+    };
+
+    // The cell indexes and their neighbours must be representable. Otherwise, i.e. for
+    // huge coordinates or a tiny tolerance, the vertexes are swept in their sorted order.
+    const double maxCell = 1e18;
+    bool useGrid = std::all_of(vertexIds.begin(), vertexIds.end(), [cellSize, maxCell](const VertexIds& id) {
+        return std::fabs(id.v.x / cellSize) < maxCell && std::fabs(id.v.y / cellSize) < maxCell;
+    });
+
+    std::vector<std::pair<Cell, std::size_t> > grid;
+    if (useGrid) {
+        grid.reserve(vertexIds.size());
+        for (std::size_t i = 0; i < vertexIds.size(); i++)
+            grid.emplace_back(cellOf(vertexIds[i].v), i);
+        std::sort(grid.begin(), grid.end());
+    }
+
+    // For each vertex collect the following vertexes (in sorted order) that are equal to it
+    std::vector<std::vector<std::size_t> > candidates(vertexIds.size());
+    auto collect = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            if (!useGrid) {
+                for (std::size_t j = i + 1; j < vertexIds.size() && vertexIds[j].v.x - vertexIds[i].v.x <= precision; j++) {
+                    if (pred(vertexIds[i], vertexIds[j]))
+                        candidates[i].push_back(j);
                 }
+                continue;
             }
 
-            vt = vn;
+            Cell cell = cellOf(vertexIds[i].v);
+            for (long long dx = -1; dx <= 1; dx++) {
+                for (long long dy = -1; dy <= 1; dy++) {
+                    Cell neighbour(cell.first + dx, cell.second + dy);
+                    auto jt = std::lower_bound(grid.begin(), grid.end(), std::make_pair(neighbour, std::size_t(0)));
+                    for (; jt != grid.end() && jt->first == neighbour; ++jt) {
+                        if (jt->second > i && pred(vertexIds[i], vertexIds[jt->second]))
+                            candidates[i].push_back(jt->second);
+                    }
+                }
+            }
+            std::sort(candidates[i].begin(), candidates[i].end());
+        }
+    };
+
+    // The grid and the vertexes are only read, hence the candidates can be collected concurrently
+    std::size_t numThreads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    if (vertexIds.size() < 10000)
+        numThreads = 1;
+    std::size_t chunk = (vertexIds.size() + numThreads - 1) / numThreads;
+    std::vector<std::future<void> > tasks;
+    for (std::size_t t = 1; t < numThreads; t++) {
+        std::size_t begin = std::min(t * chunk, vertexIds.size());
+        std::size_t end = std::min(begin + chunk, vertexIds.size());
+        tasks.push_back(std::async(std::launch::async, collect, begin, end));
+    }
+    collect(0, std::min(chunk, vertexIds.size()));
+    for (auto& task : tasks)
+        task.get();
+
+    // Make a list of constraint we expect for coincident vertexes. The first vertex
+    // of a group is coincident to all other vertexes of the group.
+    std::vector<ConstraintIds> coincidences;
+    std::vector<bool> grouped(vertexIds.size(), false);
+    for (std::size_t i = 0; i < vertexIds.size(); i++) {
+        if (grouped[i])
+            continue;
+        const VertexIds& vt = vertexIds[i];
+        for (std::size_t j : candidates[i]) {
+            if (grouped[j])
+                continue;
+            grouped[j] = true;
+            const VertexIds& vn = vertexIds[j];
+            ConstraintIds id;
+            id.Type = Coincident; // default point on point restriction
+            id.v = vt.v;
+            id.First = vt.GeoId;
+            id.FirstPos = vt.PosId;
+            id.Second = vn.GeoId;
+            id.SecondPos = vn.PosId;
+            coincidences.push_back(id);
         }
     }
 
     // Go through the available 'Coincident', 'Tangent' or 'Perpendicular' constraints
     // and check which of them is forcing two vertexes to be coincident.
     // If there is none but two vertexes can be considered equal a coincident constraint is missing.
-    std::vector<Sketcher::Constraint*> constraint = sketch->Constraints.getValues();
-    for (std::vector<Sketcher::Constraint*>::iterator it = constraint.begin(); it != constraint.end(); ++it) {
-        if ((*it)->Type == Sketcher::Coincident ||
-            (*it)->Type == Sketcher::Tangent ||
-            (*it)->Type == Sketcher::Perpendicular) {
-            ConstraintIds id;
-            id.First = (*it)->First;
-            id.FirstPos = (*it)->FirstPos;
-            id.Second = (*it)->Second;
-            id.SecondPos = (*it)->SecondPos;
-            std::list<ConstraintIds>::iterator pos = std::find_if
-                    (coincidences.begin(), coincidences.end(), Constraint_Equal(id));
-            if (pos != coincidences.end()) {
-                coincidences.erase(pos);
-            }
-        }
-    }
+    std::set<Sketcher::ConstraintType> types = {Sketcher::Coincident, Sketcher::Tangent, Sketcher::Perpendicular};
+    removeConstrainedPairs(coincidences, getConstrainedPairs(sketch->Constraints.getValues(), types));
 
-    this->vertexConstraints.clear();
-    this->vertexConstraints.reserve(coincidences.size());
-
-    for (std::list<ConstraintIds>::iterator it = coincidences.begin(); it != coincidences.end(); ++it) {
-        this->vertexConstraints.push_back(*it);
-    }
+    this->vertexConstraints.swap(coincidences);
 
     return this->vertexConstraints.size();
 }
@@ -511,109 +585,42 @@ int SketchAnalysis::detectMissingEqualityConstraints(double precision)
         }
     }
 
-    std::sort(lineedgeIds.begin(), lineedgeIds.end(), Edge_Less(precision));
-    std::vector<EdgeIds>::iterator vt = lineedgeIds.begin();
     Edge_EqualTo pred(precision);
 
-    std::list<ConstraintIds> equallines;
-    // Make a list of constraint we expect for coincident vertexes
-    while (vt < lineedgeIds.end()) {
-        // get first item whose adjacent element has the same vertex coordinates
-        vt = std::adjacent_find(vt, lineedgeIds.end(), pred);
-        if (vt < lineedgeIds.end()) {
-            std::vector<EdgeIds>::iterator vn;
-            for (vn = vt+1; vn != lineedgeIds.end(); ++vn) {
-                if (pred(*vt,*vn)) {
-                    ConstraintIds id;
-                    id.Type = Equal;
-                    id.v.x = vt->l;
-                    id.First = vt->GeoId;
-                    id.FirstPos = Sketcher::none;
-                    id.Second = vn->GeoId;
-                    id.SecondPos = Sketcher::none;
-                    equallines.push_back(id);
-                }
-                else {
-                    break;
-                }
-            }
-
-            vt = vn;
-        }
-    }
-
-    std::sort(radiusedgeIds.begin(), radiusedgeIds.end(), Edge_Less(precision));
-    vt = radiusedgeIds.begin();
-
-    std::list<ConstraintIds> equalradius;
-    // Make a list of constraint we expect for coincident vertexes
-    while (vt < radiusedgeIds.end()) {
-        // get first item whose adjacent element has the same vertex coordinates
-        vt = std::adjacent_find(vt, radiusedgeIds.end(), pred);
-        if (vt < radiusedgeIds.end()) {
-            std::vector<EdgeIds>::iterator vn;
-            for (vn = vt+1; vn != radiusedgeIds.end(); ++vn) {
-                if (pred(*vt,*vn)) {
-                    ConstraintIds id;
-                    id.Type = Equal;
-                    id.v.x = vt->l;
-                    id.First = vt->GeoId;
-                    id.FirstPos = Sketcher::none;
-                    id.Second = vn->GeoId;
-                    id.SecondPos = Sketcher::none;
-                    equalradius.push_back(id);
-                }
-                else {
-                    break;
-                }
-            }
-
-            vt = vn;
-        }
-    }
-
-
-    // Go through the available 'Coincident', 'Tangent' or 'Perpendicular' constraints
-    // and check which of them is forcing two vertexes to be coincident.
-    // If there is none but two vertexes can be considered equal a coincident constraint is missing.
-    std::vector<Sketcher::Constraint*> constraint = sketch->Constraints.getValues();
-    for (std::vector<Sketcher::Constraint*>::iterator it = constraint.begin(); it != constraint.end(); ++it) {
-        if ((*it)->Type == Sketcher::Equal) {
-            ConstraintIds id;
-            id.First = (*it)->First;
-            id.FirstPos = (*it)->FirstPos;
-            id.Second = (*it)->Second;
-            id.SecondPos = (*it)->SecondPos;
-
-            std::list<ConstraintIds>::iterator pos = std::find_if
-                (equallines.begin(), equallines.end(), Constraint_Equal(id));
-
-            if (pos != equallines.end()) {
-                equallines.erase(pos);
-            }
-
-            pos = std::find_if
-                (equalradius.begin(), equalradius.end(), Constraint_Equal(id));
-
-            if (pos != equalradius.end()) {
-                equalradius.erase(pos);
+    // Sweep over the sorted lengths: each group consists of the first edge
+    // and all following edges that are equal to it.
+    auto findEqualEdges = [&pred](std::vector<EdgeIds>& edgeIds) {
+        std::vector<ConstraintIds> equal;
+        std::sort(edgeIds.begin(), edgeIds.end(), Edge_Less());
+        std::size_t i = 0;
+        while (i < edgeIds.size()) {
+            std::size_t j = i + 1;
+            for (; j < edgeIds.size() && pred(edgeIds[i], edgeIds[j]); ++j) {
+                ConstraintIds id;
+                id.Type = Equal;
+                id.v.x = edgeIds[i].l;
+                id.First = edgeIds[i].GeoId;
+                id.FirstPos = Sketcher::none;
+                id.Second = edgeIds[j].GeoId;
+                id.SecondPos = Sketcher::none;
+                equal.push_back(id);
             }
+            i = j;
         }
-    }
+        return equal;
+    };
 
-    this->lineequalityConstraints.clear();
-    this->lineequalityConstraints.reserve(equallines.size());
+    std::vector<ConstraintIds> equallines = findEqualEdges(lineedgeIds);
+    std::vector<ConstraintIds> equalradius = findEqualEdges(radiusedgeIds);
 
-    for (std::list<ConstraintIds>::iterator it = equallines.begin(); it != equallines.end(); ++it) {
-        this->lineequalityConstraints.push_back(*it);
-    }
-
-    this->radiusequalityConstraints.clear();
-    this->radiusequalityConstraints.reserve(equalradius.size());
+    // Go through the available 'Equal' constraints and remove the pairs that are already constrained
+    std::set<Sketcher::ConstraintType> types = {Sketcher::Equal};
+    std::set<PointPairKey> constrained = getConstrainedPairs(sketch->Constraints.getValues(), types);
+    removeConstrainedPairs(equallines, constrained);
+    removeConstrainedPairs(equalradius, constrained);
 
-    for (std::list<ConstraintIds>::iterator it = equalradius.begin(); it != equalradius.end(); ++it) {
-        this->radiusequalityConstraints.push_back(*it);
-    }
+    this->lineequalityConstraints.swap(equallines);
+    this->radiusequalityConstraints.swap(equalradius);
 
     return this->lineequalityConstraints.size() + this->radiusequalityConstraints.size();
 }
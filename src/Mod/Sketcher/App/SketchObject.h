@@ -424,7 +424,7 @@ public:
 public: /* Solver exposed interface */
     /// gets the solved sketch as a reference
     inline const Sketch &getSolvedSketch(void) const {return solvedSketch;}
-    /// enables/disables solver initial solution recalculation when moving point mode (useful for dragging)
+    /// enables/disables solver initial solution recalculation when moving point mode, i.e. incremental dragging (see Sketch)
     inline void setRecalculateInitialSolutionWhileMovingPoint(bool recalculateInitialSolutionWhileMovingPoint)
         {solvedSketch.setRecalculateInitialSolutionWhileMovingPoint(recalculateInitialSolutionWhileMovingPoint);}
     /// Forwards a request for a temporary initMove to the solver using the current sketch state as a reference (enables dragging)
@@ -993,6 +993,45 @@ PyObject* SketchObjectPy::movePoint(PyObject *args)
 
 }
 
+PyObject* SketchObjectPy::initTemporaryMove(PyObject *args)
+{
+    int GeoId, PointType;
+    PyObject* fine = Py_True;
+
+    if (!PyArg_ParseTuple(args, "ii|O!", &GeoId, &PointType, &PyBool_Type, &fine))
+        return 0;
+
+    if (this->getSketchObjectPtr()->initTemporaryMove(GeoId,(Sketcher::PointPos)PointType,PyObject_IsTrue(fine) ? true : false)) {
+        std::stringstream str;
+        str << "Not able to start moving point with the id and type: (" << GeoId << ", " << PointType << ")";
+        PyErr_SetString(PyExc_ValueError, str.str().c_str());
+        return 0;
+    }
+
+    Py_Return;
+}
+
+PyObject* SketchObjectPy::moveTemporaryPoint(PyObject *args)
+{
+    PyObject *pcObj;
+    int GeoId, PointType;
+    int relative=0;
+
+    if (!PyArg_ParseTuple(args, "iiO!|i", &GeoId, &PointType, &(Base::VectorPy::Type), &pcObj, &relative))
+        return 0;
+
+    Base::Vector3d v1 = static_cast<Base::VectorPy*>(pcObj)->value();
+
+    if (this->getSketchObjectPtr()->moveTemporaryPoint(GeoId,(Sketcher::PointPos)PointType,v1,(relative>0))) {
+        std::stringstream str;
+        str << "Not able to move point with the id and type: (" << GeoId << ", " << PointType << ")";
+        PyErr_SetString(PyExc_ValueError, str.str().c_str());
+        return 0;
+    }
+
+    Py_Return;
+}
+
 PyObject* SketchObjectPy::getGeoVertexIndex(PyObject *args)
 {
     int index;
@@ -54,6 +54,9 @@
 #include <cfloat>
 #include <limits>
 #include <future>
+#include <atomic>
+#include <numeric>
+#include <thread>
 
 #include "GCS.h"
 #include "qp_eq.h"
@@ -450,6 +453,7 @@ System::System()
   , hasUnknowns(false)
   , hasDiagnosis(false)
   , isInit(false)
+  , incremental(false)
   , emptyDiagnoseMatrix(true)
   , maxIter(100)
   , maxIterRedundant(100)
@@ -487,7 +491,7 @@ System::System(std::vector<Constraint *> clist_)
   c2p(), p2c(),
   subSystems(0), subSystemsAux(0),
   reference(0),
-  hasUnknowns(false), hasDiagnosis(false), isInit(false)
+  hasUnknowns(false), hasDiagnosis(false), isInit(false), incremental(false)
 {
     // create own (shallow) copy of constraints
     for (std::vector<Constraint *>::iterator constr=clist_.begin();
@@ -1568,6 +1572,13 @@ int System::solve(bool isFine, Algorithm alg, bool isRedundantsolving)
     // even if no other system has to be solved
     int res = Success;
     for (int cid=0; cid < int(subSystems.size()); cid++) {
+        // in incremental mode the untouched subsystems keep their solution
+        // and the others start from the last accepted solution
+        if (incremental) {
+            if (!subSystemsAux[cid])
+                continue;
+            isReset = true;
+        }
         if ((subSystems[cid] || subSystemsAux[cid]) && !isReset) {
              resetToReference();
              isReset = true;
@@ -3806,6 +3817,8 @@ int System::solve(SubSystem *subsysA, SubSystem *subsysB, bool /*isFine*/, bool
 void System::applySolution()
 {
     for (int cid=0; cid < int(subSystems.size()); cid++) {
+        if (incremental && !subSystemsAux[cid])
+            continue;
         if (subSystemsAux[cid])
             subSystemsAux[cid]->applySolution();
         if (subSystems[cid])
@@ -3821,16 +3834,38 @@ void System::undoSolution()
     resetToReference();
 }
 
+void System::acceptSolution()
+{
+    setReference();
+}
+
+void System::getIncrementalParams(VEC_pD &params) const
+{
+    params.clear();
+    if (!isInit)
+        return;
+
+    for (int cid=0; cid < int(subSystems.size()); cid++) {
+        if (!subSystemsAux[cid])
+            continue;
+        params.insert(params.end(), plists[cid].begin(), plists[cid].end());
+        for (MAP_pD_pD::const_iterator it=reductionmaps[cid].begin();
+             it != reductionmaps[cid].end(); ++it)
+            params.push_back(it->first);
+    }
+}
+
 void System::makeReducedJacobian(Eigen::MatrixXd &J,
                                  std::map<int,int> &jacobianconstraintmap,
                                  GCS::VEC_pD &pdiagnoselist,
                                  std::map< int , int> &tagmultiplicity)
 {
     // construct specific parameter list for diagonose ignoring driven constraint parameters
+    std::set<double *> drivenparams(pdrivenlist.begin(), pdrivenlist.end());
+    MAP_pD_I pdiagnoseIndex;
     for (int j=0; j < int(plist.size()); j++) {
-        auto result1 = std::find(std::begin(pdrivenlist), std::end(pdrivenlist), plist[j]);
-
-        if (result1 == std::end(pdrivenlist)) {
+        if (drivenparams.find(plist[j]) == drivenparams.end()) {
+            pdiagnoseIndex[plist[j]] = pdiagnoselist.size();
             pdiagnoselist.push_back(plist[j]);
         }
     }
@@ -3845,8 +3880,12 @@ void System::makeReducedJacobian(Eigen::MatrixXd &J,
         ++allcount;
         if ((*constr)->getTag() >= 0 && (*constr)->isDriving()) {
             jacobianconstraintcount++;
-            for (int j=0; j < int(pdiagnoselist.size()); j++) {
-                J(jacobianconstraintcount-1,j) = (*constr)->grad(pdiagnoselist[j]);
+            // the gradient is zero for the parameters the constraint doesn't depend on
+            VEC_pD &cparams = c2p[*constr];
+            for (VEC_pD::const_iterator param=cparams.begin(); param != cparams.end(); ++param) {
+                MAP_pD_I::const_iterator j = pdiagnoseIndex.find(*param);
+                if (j != pdiagnoseIndex.end())
+                    J(jacobianconstraintcount-1,j->second) = (*constr)->grad(*param);
             }
 
             // parallel processing: create tag multiplicity map
@@ -3863,6 +3902,74 @@ void System::makeReducedJacobian(Eigen::MatrixXd &J,
         J.resize(0,0);
 }
 
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+void System::makeSparseReducedJacobian(Eigen::SparseMatrix<double> &J,
+                                       std::map<int,int> &jacobianconstraintmap,
+                                       GCS::VEC_pD &pdiagnoselist,
+                                       std::map< int , int> &tagmultiplicity)
+{
+    // Same as makeReducedJacobian, but the matrix is assembled directly in sparse form and
+    // has a row for each driving constraint only (no zero padding). For large sketches the
+    // dense matrix would take more time and memory than the decomposition itself.
+    std::set<double *> drivenparams(pdrivenlist.begin(), pdrivenlist.end());
+    MAP_pD_I pdiagnoseIndex;
+    for (int j=0; j < int(plist.size()); j++) {
+        if (drivenparams.find(plist[j]) == drivenparams.end()) {
+            pdiagnoseIndex[plist[j]] = pdiagnoselist.size();
+            pdiagnoselist.push_back(plist[j]);
+        }
+    }
+
+    std::vector< Eigen::Triplet<double> > entries;
+    std::vector<int> cols;
+
+    int jacobianconstraintcount=0;
+    int allcount=0;
+    for (std::vector<Constraint *>::iterator constr=clist.begin(); constr != clist.end(); ++constr) {
+        (*constr)->revertParams();
+        ++allcount;
+        if ((*constr)->getTag() >= 0 && (*constr)->isDriving()) {
+            jacobianconstraintcount++;
+
+            // a parameter may be referenced more than once by a constraint, but its
+            // gradient must be entered only once as duplicated triplets are summed up
+            cols.clear();
+            VEC_pD &cparams = c2p[*constr];
+            for (VEC_pD::const_iterator param=cparams.begin(); param != cparams.end(); ++param) {
+                MAP_pD_I::const_iterator j = pdiagnoseIndex.find(*param);
+                if (j != pdiagnoseIndex.end())
+                    cols.push_back(j->second);
+            }
+            std::sort(cols.begin(), cols.end());
+            cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+
+            for (std::vector<int>::const_iterator j=cols.begin(); j != cols.end(); ++j) {
+                double value = (*constr)->grad(pdiagnoselist[*j]);
+                if (value != 0.0)
+                    entries.emplace_back(jacobianconstraintcount-1, *j, value);
+            }
+
+            // parallel processing: create tag multiplicity map
+            if(tagmultiplicity.find((*constr)->getTag()) == tagmultiplicity.end())
+                tagmultiplicity[(*constr)->getTag()] = 0;
+            else
+                tagmultiplicity[(*constr)->getTag()]++;
+
+            jacobianconstraintmap[jacobianconstraintcount-1] = allcount-1;
+        }
+    }
+
+    if(jacobianconstraintcount == 0) { // only driven constraints
+        J.resize(0,0);
+        return;
+    }
+
+    J.resize(jacobianconstraintcount, pdiagnoselist.size());
+    J.setFromTriplets(entries.begin(), entries.end());
+    J.makeCompressed();
+}
+#endif
+
 int System::diagnose(Algorithm alg)
 {
     // Analyses the constrainess grad of the system and provides feedback
@@ -3909,9 +4016,12 @@ SolverReportingManager::Manager().LogToFile("GCS::System::diagnose()\n");
     //
     // reduced Jacobian matrix
     // The Jacobian has been reduced to:
-    // 1. only contain driving constraints, but keep a full size (zero padded).
+    // 1. only contain driving constraints, but keep a full size (zero padded) for DenseQR.
     // 2. remove the parameters of the values of driven constraints.
     Eigen::MatrixXd J;
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+    Eigen::SparseMatrix<double> SJ;
+#endif
 
     // maps the index of the rows of the reduced jacobian matrix (solver constraints) to
     // the index those constraints would have in a full size Jacobian matrix
@@ -3925,13 +4035,25 @@ SolverReportingManager::Manager().LogToFile("GCS::System::diagnose()\n");
     std::map< int , int> tagmultiplicity;
 
 
-    makeReducedJacobian(J, jacobianconstraintmap, pdiagnoselist, tagmultiplicity);
+#ifndef EIGEN_SPARSEQR_COMPATIBLE
+    if(qrAlgorithm==EigenSparseQR){
+        Base::Console().Warning("SparseQR not supported by you current version of Eigen. It requires Eigen 3.2.2 or higher. Falling back to Dense QR\n");
+        qrAlgorithm=EigenDenseQR;
+    }
+#endif
+
+    if(qrAlgorithm==EigenDenseQR)
+        makeReducedJacobian(J, jacobianconstraintmap, pdiagnoselist, tagmultiplicity);
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+    else
+        makeSparseReducedJacobian(SJ, jacobianconstraintmap, pdiagnoselist, tagmultiplicity);
+#endif
 
     // this function will exit with a diagnosis and, unless overridden by functions below, with full DoFs
     hasDiagnosis = true;
     dofs = pdiagnoselist.size();
 
-    if(J.rows() > 0)
+    if(!jacobianconstraintmap.empty())
         emptyDiagnoseMatrix = false;
 
     // There is a legacy decision to use QR decomposition. I (abdullah) do not know all the
@@ -3971,13 +4093,11 @@ SolverReportingManager::Manager().LogToFile("GCS::System::diagnose()\n");
     // to identify whether the parameter is fully constraint (independent) or not (i.e. it is dependent).
 
     // QR decomposition method selection: SparseQR vs DenseQR
-
-#ifndef EIGEN_SPARSEQR_COMPATIBLE
-    if(qrAlgorithm==EigenSparseQR){
-        Base::Console().Warning("SparseQR not supported by you current version of Eigen. It requires Eigen 3.2.2 or higher. Falling back to Dense QR\n");
-        qrAlgorithm=EigenDenseQR;
-    }
-#endif
+    //
+    // SparseQR is done per connected component of the Jacobian, see identifyDependentParametersSparseQR().
+    // The sum of the ranks of the components is the rank of the system, so the decomposition of the
+    // transposed Jacobian is only needed to find conflicting/redundant constraints if there are more
+    // constraints than the rank.
 
     if(qrAlgorithm==EigenDenseQR){
     #ifdef PROFILE_DIAGNOSE
@@ -4038,43 +4158,42 @@ SolverReportingManager::Manager().LogToFile("GCS::System::diagnose()\n");
     #ifdef PROFILE_DIAGNOSE
         Base::TimeInfo SparseQR_start_time;
     #endif
-        if (J.rows() > 0) {
-            int rank = 0;
-            Eigen::MatrixXd R;
-            Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int> > SqrJT;
-            // Here we give the system the possibility to run the two QR decompositions in parallel, depending on the load of the system
-            // so we are using the default std::launch::async | std::launch::deferred policy, as nobody better than the system
-            // nows if it can run the task in parallel or is oversubscribed and should deferred it.
-            // Care to wait() for the future before any prospective detection of conflicting/redundant, because the redundant solve
-            // modifies pdiagnoselist and it would NOT be thread-safe. Care to call the thread with silent=true, unless the present thread
-            // does not use Base::Console, or the launch policy is set to std::launch::deferred policy, as it is not thread-safe to use them
-            // in both at the same time.
-            //
-            // identifyDependentParametersSparseQR(J, jacobianconstraintmap, pdiagnoselist, true)
-            //
-            // Debug:
-            //auto fut = std::async(std::launch::deferred,&System::identifyDependentParametersSparseQR,this,J,jacobianconstraintmap, pdiagnoselist, false);
-            auto fut = std::async(&System::identifyDependentParametersSparseQR,this,J,jacobianconstraintmap, pdiagnoselist, /*silent=*/true);
+        if (SJ.rows() > 0) {
+            int paramsNum = SJ.cols();
+            int constrNum = SJ.rows();
 
-            makeSparseQRDecomposition( J, jacobianconstraintmap, SqrJT, rank, R, /*transposed=*/true, /*silent=*/false);
+            // The components are decomposed in parallel, so the logging must be silent there
+            // as Base::Console is not thread-safe.
+            int rank = identifyDependentParametersSparseQR(SJ, pdiagnoselist, /*silent=*/true);
 
-            int paramsNum = SqrJT.rows();
-            int constrNum = SqrJT.cols();
+            dofs = paramsNum - rank; // unless overconstraint, which will be overridden below
 
-            fut.wait(); // wait for the execution of identifyDependentParametersSparseQR to finish
+            if (constrNum <= rank) {
+                if(debugMode==IterationLevel)
+                    SolverReportingManager::Manager().LogQRSystemInformation(*this, paramsNum, constrNum, rank);
+            }
+            else { // conflicting or redundant constraints
+                Eigen::MatrixXd R;
+                Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int> > SqrJT;
 
-            dofs = paramsNum - rank; // unless overconstraint, which will be overridden below
+                makeSparseQRDecomposition( SJ, SqrJT, rank, R, /*transposed=*/true, /*silent=*/false);
 
-            // Detecting conflicting or redundant constraints
-            if (constrNum > rank) { // conflicting or redundant constraints
+                paramsNum = SqrJT.rows();
+                constrNum = SqrJT.cols();
 
-                int nonredundantconstrNum;
+                dofs = paramsNum - rank; // unless overconstraint, which will be overridden below
 
-                identifyConflictingRedundantConstraints(alg, SqrJT, jacobianconstraintmap, tagmultiplicity, pdiagnoselist,
-                                                        R, constrNum, rank, nonredundantconstrNum);
+                // Detecting conflicting or redundant constraints
+                if (constrNum > rank) {
 
-                if (paramsNum == rank && nonredundantconstrNum > rank) // over-constrained
-                    dofs = paramsNum - nonredundantconstrNum;
+                    int nonredundantconstrNum;
+
+                    identifyConflictingRedundantConstraints(alg, SqrJT, jacobianconstraintmap, tagmultiplicity, pdiagnoselist,
+                                                            R, constrNum, rank, nonredundantconstrNum);
+
+                    if (paramsNum == rank && nonredundantconstrNum > rank) // over-constrained
+                        dofs = paramsNum - nonredundantconstrNum;
+                }
             }
         }
 
@@ -4162,23 +4281,13 @@ void System::makeDenseQRDecomposition(  const Eigen::MatrixXd &J,
 }
 
 #ifdef EIGEN_SPARSEQR_COMPATIBLE
-void System::makeSparseQRDecomposition( const Eigen::MatrixXd &J,
-                                        const std::map<int,int> &jacobianconstraintmap,
+void System::makeSparseQRDecomposition( const Eigen::SparseMatrix<double> &J,
                                         Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int> > &SqrJT,
                                         int &rank, Eigen::MatrixXd & R, bool transposeJ, bool silent)
 {
-
-   Eigen::SparseMatrix<double> SJ;
-
-    // this creation is not optimized (done using triplets)
-    // however the time this takes is negligible compared to the
-    // time the QR decomposition itself takes
-    SJ = J.sparseView();
-    SJ.makeCompressed();
-
     #ifdef _GCS_DEBUG
     if(!silent)
-        SolverReportingManager::Manager().LogMatrix("J",J);
+        SolverReportingManager::Manager().LogMatrix("J",Eigen::MatrixXd(J));
     #endif
 
     #ifdef _GCS_DEBUG_SOLVER_JACOBIAN_QR_DECOMPOSITION_TRIANGULAR_MATRIX
@@ -4191,12 +4300,12 @@ void System::makeSparseQRDecomposition( const Eigen::MatrixXd &J,
     int rowsNum = 0;
     int colsNum = 0;
 
-    if (SJ.rows() > 0) {
+    if (J.rows() > 0) {
         Eigen::SparseMatrix<double> SJG;
         if(transposeJ)
-            SJG = SJ.topRows(jacobianconstraintmap.size()).transpose();
+            SJG = J.transpose();
         else
-            SJG = SJ.topRows(jacobianconstraintmap.size());
+            SJG = J;
 
         if (SJG.rows() > 0 && SJG.cols() > 0) {
             SqrJT.compute(SJG);
@@ -4259,23 +4368,152 @@ void System::identifyDependentParametersDenseQR( const Eigen::MatrixXd &J,
 
     makeDenseQRDecomposition( J, jacobianconstraintmap, qrJ, rank, Rparams, false, true);
 
-    identifyDependentParameters(qrJ, Rparams, rank, pdiagnoselist, silent);
+    identifyDependentParameters(qrJ, Rparams, rank, pdiagnoselist,
+                                pDependentParametersGroups, pDependentParameters, silent);
 }
 
 #ifdef EIGEN_SPARSEQR_COMPATIBLE
-void System::identifyDependentParametersSparseQR( const Eigen::MatrixXd &J,
-                                                  const std::map<int,int> &jacobianconstraintmap,
-                                                  const GCS::VEC_pD &pdiagnoselist,
-                                                  bool silent)
-{
-    Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int> > SqrJ;
-    Eigen::MatrixXd Rparams;
+int System::identifyDependentParametersSparseQR( const Eigen::SparseMatrix<double> &J,
+                                                 const GCS::VEC_pD &pdiagnoselist,
+                                                 bool silent)
+{
+    // Parameters of different connected components of the constraint graph are never coupled,
+    // so the Jacobian is block diagonal up to a permutation and each block can be decomposed
+    // on its own. The rank of J is the sum of the ranks of the blocks and the groups of dependent
+    // parameters of a block only contain parameters of this block. The blocks are decomposed in
+    // parallel, which also avoids the fill-in of a decomposition of the whole matrix.
+    int paramsNum = J.cols();
+    int constrNum = J.rows();
+
+    // union-find of the parameters coupled by a constraint
+    std::vector<int> parent(paramsNum);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto findRoot = [&parent](int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+
+    std::vector<int> firstCol(constrNum, -1);
+    for (int k=0; k < J.outerSize(); ++k) {
+        for (Eigen::SparseMatrix<double>::InnerIterator it(J,k); it; ++it) {
+            int row = it.row();
+            if (firstCol[row] < 0) {
+                firstCol[row] = k;
+            }
+            else {
+                int a = findRoot(firstCol[row]);
+                int b = findRoot(k);
+                if (a != b)
+                    parent[b] = a;
+            }
+        }
+    }
+
+    // distribute the columns and rows to the components and number them within their component
+    std::vector<int> component(paramsNum, -1);
+    std::vector<int> localIndex(paramsNum);
+    std::vector<int> localRow(constrNum);
+    std::vector< std::vector<int> > compCols, compRows;
+    for (int j=0; j < paramsNum; j++) {
+        int root = findRoot(j);
+        if (component[root] < 0) {
+            component[root] = compCols.size();
+            compCols.emplace_back();
+            compRows.emplace_back();
+        }
+        component[j] = component[root];
+        localIndex[j] = compCols[component[j]].size();
+        compCols[component[j]].push_back(j);
+    }
+    for (int row=0; row < constrNum; row++) {
+        // a row without any entry doesn't contribute to the rank
+        if (firstCol[row] >= 0) {
+            std::vector<int> &rows = compRows[component[firstCol[row]]];
+            localRow[row] = rows.size();
+            rows.push_back(row);
+        }
+    }
+
+    struct ComponentDiagnosis {
+        int rank = 0;
+        std::vector< std::vector<double *> > groups;
+        VEC_pD dependent;
+    };
+
+    int compNum = compCols.size();
+    std::vector<ComponentDiagnosis> results(compNum);
+
+    auto diagnoseComponent = [&](int cid) {
+        const std::vector<int> &cols = compCols[cid];
+        const std::vector<int> &rows = compRows[cid];
+        ComponentDiagnosis &result = results[cid];
+
+        VEC_pD params;
+        params.reserve(cols.size());
+        for (std::vector<int>::const_iterator j=cols.begin(); j != cols.end(); ++j)
+            params.push_back(pdiagnoselist[*j]);
+
+        if (rows.empty()) { // a parameter without any constraint
+            for (VEC_pD::const_iterator param=params.begin(); param != params.end(); ++param) {
+                result.groups.push_back(VEC_pD(1, *param));
+                result.dependent.push_back(*param);
+            }
+            return;
+        }
 
-    int nontransprank;
+        std::vector< Eigen::Triplet<double> > entries;
+        for (int c=0; c < int(cols.size()); c++) {
+            for (Eigen::SparseMatrix<double>::InnerIterator it(J,cols[c]); it; ++it)
+                entries.emplace_back(localRow[it.row()], c, it.value());
+        }
 
-    makeSparseQRDecomposition( J, jacobianconstraintmap, SqrJ, nontransprank, Rparams, false, true); // do not transpose allow to diagnose parameters
+        Eigen::SparseMatrix<double> CJ(rows.size(), cols.size());
+        CJ.setFromTriplets(entries.begin(), entries.end());
+        CJ.makeCompressed();
+
+        Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int> > SqrJ;
+        Eigen::MatrixXd Rparams;
+
+        makeSparseQRDecomposition( CJ, SqrJ, result.rank, Rparams, false, true); // do not transpose allow to diagnose parameters
+
+        identifyDependentParameters(SqrJ, Rparams, result.rank, params,
+                                    result.groups, result.dependent, silent);
+    };
+
+    // The largest components are scheduled first to balance the load of the tasks
+    std::vector<int> order(compNum);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&compCols](int a, int b) {
+        return compCols[a].size() > compCols[b].size();
+    });
+
+    std::atomic<int> next(0);
+    auto worker = [&]() {
+        for (int i = next++; i < compNum; i = next++)
+            diagnoseComponent(order[i]);
+    };
+
+    // As above, the default launch policy lets the system decide whether a task runs
+    // in parallel or is deferred until wait() is called.
+    int taskNum = std::min<int>(compNum, std::max<int>(1, std::thread::hardware_concurrency()));
+    std::vector< std::future<void> > futures;
+    for (int i=1; i < taskNum; i++)
+        futures.push_back(std::async(worker));
+    worker();
+    for (std::vector< std::future<void> >::iterator it = futures.begin(); it != futures.end(); ++it)
+        it->wait();
+
+    int rank = 0;
+    for (std::vector<ComponentDiagnosis>::iterator it = results.begin(); it != results.end(); ++it) {
+        rank += it->rank;
+        pDependentParametersGroups.insert(pDependentParametersGroups.end(), it->groups.begin(), it->groups.end());
+        pDependentParameters.insert(pDependentParameters.end(), it->dependent.begin(), it->dependent.end());
+    }
 
-    identifyDependentParameters(SqrJ, Rparams, nontransprank, pdiagnoselist, silent);
+    return rank;
 }
 #endif
 
@@ -4284,6 +4522,8 @@ void System::identifyDependentParameters(   T & qrJ,
                                             Eigen::MatrixXd &Rparams,
                                             int rank,
                                             const GCS::VEC_pD &pdiagnoselist,
+                                            std::vector< std::vector<double *> > &dependentGroups,
+                                            VEC_pD &dependent,
                                             bool silent)
 {
     (void) silent; // silent is only used in debug code, but it is important as Base::Console is not thread-safe. Removes warning in non Debug mode.
@@ -4298,27 +4538,27 @@ void System::identifyDependentParameters(   T & qrJ,
         SolverReportingManager::Manager().LogMatrix("Rparams_nonzeros_over_pilot", Rparams);
 #endif
 
-    pDependentParametersGroups.resize(qrJ.cols()-rank);
+    dependentGroups.resize(qrJ.cols()-rank);
     for (int j=rank; j < qrJ.cols(); j++) {
         for (int row=0; row < rank; row++) {
             if (fabs(Rparams(row,j)) > 1e-10) {
                 int origCol = qrJ.colsPermutation().indices()[row];
 
-                pDependentParametersGroups[j-rank].push_back(pdiagnoselist[origCol]);
-                pDependentParameters.push_back(pdiagnoselist[origCol]);
+                dependentGroups[j-rank].push_back(pdiagnoselist[origCol]);
+                dependent.push_back(pdiagnoselist[origCol]);
             }
         }
         int origCol = qrJ.colsPermutation().indices()[j];
 
-        pDependentParametersGroups[j-rank].push_back(pdiagnoselist[origCol]);
-        pDependentParameters.push_back(pdiagnoselist[origCol]);
+        dependentGroups[j-rank].push_back(pdiagnoselist[origCol]);
+        dependent.push_back(pdiagnoselist[origCol]);
     }
 
 #ifdef _GCS_DEBUG
     if(!silent) {
         SolverReportingManager::Manager().LogMatrix("PermMatrix", (Eigen::MatrixXd)qrJ.colsPermutation());
 
-        SolverReportingManager::Manager().LogGroupOfParameters("ParameterGroups",pDependentParametersGroups);
+        SolverReportingManager::Manager().LogGroupOfParameters("ParameterGroups",dependentGroups);
     }
 
 #endif
@@ -4506,15 +4746,43 @@ void System::identifyConflictingRedundantConstraints(   Algorithm alg,
         SolverReportingManager::Manager().LogSetOfConstraints("Chosen redundants", skipped);
     }
 
+    // Only the part of the system that is coupled with the skipped constraints has to be
+    // solved, the remaining components can't change their error.
+    std::set<double *> diagnosedParams(pdiagnoselist.begin(), pdiagnoselist.end());
+    std::set<double *> coupledParams;
+    std::set<Constraint *> coupled(skipped.begin(), skipped.end());
+    std::vector<Constraint *> pending(skipped.begin(), skipped.end());
+    while (!pending.empty()) {
+        Constraint *constr = pending.back();
+        pending.pop_back();
+        VEC_pD &cparams = c2p[constr];
+        for (VEC_pD::const_iterator param=cparams.begin(); param != cparams.end(); ++param) {
+            if (diagnosedParams.count(*param) == 0 || !coupledParams.insert(*param).second)
+                continue;
+            std::vector<Constraint *> &pconstrs = p2c[*param];
+            for (std::vector<Constraint *>::const_iterator it=pconstrs.begin(); it != pconstrs.end(); ++it) {
+                if (coupled.insert(*it).second)
+                    pending.push_back(*it);
+            }
+        }
+    }
+
     std::vector<Constraint *> clistTmp;
-    clistTmp.reserve(clist.size());
+    clistTmp.reserve(coupled.size());
     for (std::vector<Constraint *>::iterator constr=clist.begin();
         constr != clist.end(); ++constr) {
-        if ((*constr)->isDriving() && skipped.count(*constr) == 0)
+        if ((*constr)->isDriving() && skipped.count(*constr) == 0 && coupled.count(*constr) > 0)
             clistTmp.push_back(*constr);
     }
 
-    SubSystem *subSysTmp = new SubSystem(clistTmp, pdiagnoselist);
+    GCS::VEC_pD plistTmp;
+    plistTmp.reserve(coupledParams.size());
+    for (VEC_pD::const_iterator param=pdiagnoselist.begin(); param != pdiagnoselist.end(); ++param) {
+        if (coupledParams.count(*param) > 0)
+            plistTmp.push_back(*param);
+    }
+
+    SubSystem *subSysTmp = new SubSystem(clistTmp, plistTmp);
     int res = solve(subSysTmp,true,alg,true);
 
     if(debugMode==Minimal || debugMode==IterationLevel) {
@@ -4613,6 +4881,7 @@ void System::identifyConflictingRedundantConstraints(   Algorithm alg,
 void System::clearSubSystems()
 {
     isInit = false;
+    incremental = false;
     free(subSystems);
     free(subSystemsAux);
     subSystems.clear();
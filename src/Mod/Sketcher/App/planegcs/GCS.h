@@ -130,6 +130,7 @@ namespace GCS
         bool hasUnknowns;  // if plist is filled with the unknown parameters
         bool hasDiagnosis; // if dofs, conflictingTags, redundantTags are up to date
         bool isInit;       // if plists, clists, reductionmaps are up to date
+        bool incremental;  // if only the subsystems with temporary constraints are solved
 
         bool emptyDiagnoseMatrix; // false only if there is at least one driving constraint.
 
@@ -138,6 +139,9 @@ namespace GCS
         int solve_DL(SubSystem *subsys, bool isRedundantsolving=false);
 
         void makeReducedJacobian(Eigen::MatrixXd &J, std::map<int,int> &jacobianconstraintmap, GCS::VEC_pD &pdiagnoselist, std::map< int , int> &tagmultiplicity);
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+        void makeSparseReducedJacobian(Eigen::SparseMatrix<double> &J, std::map<int,int> &jacobianconstraintmap, GCS::VEC_pD &pdiagnoselist, std::map< int , int> &tagmultiplicity);
+#endif
 
         void makeDenseQRDecomposition(  const Eigen::MatrixXd &J,
                                         const std::map<int,int> &jacobianconstraintmap,
@@ -145,8 +149,7 @@ namespace GCS
                                         int &rank, Eigen::MatrixXd &R, bool transposeJ = true, bool silent = false);
 
 #ifdef EIGEN_SPARSEQR_COMPATIBLE
-        void makeSparseQRDecomposition( const Eigen::MatrixXd &J,
-                                        const std::map<int,int> &jacobianconstraintmap,
+        void makeSparseQRDecomposition( const Eigen::SparseMatrix<double> &J,
                                         Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int> > &SqrJT,
                                         int &rank, Eigen::MatrixXd &R, bool transposeJ = true, bool silent = false);
 #endif
@@ -173,8 +176,8 @@ namespace GCS
         void eliminateNonZerosOverPivotInUpperTriangularMatrix(Eigen::MatrixXd &R, int rank);
 
 #ifdef EIGEN_SPARSEQR_COMPATIBLE
-        void identifyDependentParametersSparseQR( const Eigen::MatrixXd &J,
-                                                  const std::map<int,int> &jacobianconstraintmap,
+        // returns the rank of J
+        int identifyDependentParametersSparseQR(  const Eigen::SparseMatrix<double> &J,
                                                   const GCS::VEC_pD &pdiagnoselist,
                                                   bool silent=true);
 #endif
@@ -189,6 +192,8 @@ namespace GCS
                                             Eigen::MatrixXd &Rparams,
                                             int rank,
                                             const GCS::VEC_pD &pdiagnoselist,
+                                            std::vector< std::vector<double *> > &dependentGroups,
+                                            VEC_pD &dependent,
                                             bool silent=true);
 
         #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
@@ -349,6 +354,15 @@ namespace GCS
 
         void applySolution();
         void undoSolution();
+
+        // In incremental mode (used for dragging) only the subsystems that contain
+        // temporary constraints are solved and each solve starts from the last
+        // accepted solution instead of the parameter values of initSolution().
+        // The mode is left when the subsystems are cleared.
+        void setIncremental(bool on) { incremental = on; }
+        bool isIncremental() const { return incremental; }
+        void acceptSolution(); // makes the current parameter values the start of the next solve
+        void getIncrementalParams(VEC_pD &params) const; // unknowns of the subsystems solved in incremental mode
         //FIXME: looks like XconvergenceFine is not the solver precision, at least in DogLeg solver.
         // Note: Yes, every solver has a different way of interpreting precision
         // but one has to study what is this needed for in order to decide
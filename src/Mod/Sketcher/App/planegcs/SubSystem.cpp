@@ -20,6 +20,7 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
 #include <iostream>
 #include <iterator>
 #include "SubSystem.h"
@@ -126,6 +127,59 @@ void SubSystem::initialize(VEC_pD &params, MAP_pD_pD &reductionmap)
         }
 //        (*constr)->redirectParams(pmap); // redirect parameters to pvec
     }
+
+    // The solvers evaluate the residuals and the Jacobian in every iteration, so the
+    // structure of the Jacobian is stored in flat arrays to only evaluate the non-zero
+    // entries. Constraints of the same type are evaluated one after another, this way
+    // the virtual calls of error() and grad() are predicted well.
+    cstart.assign(1, 0);
+    erow.clear();
+    eparam.clear();
+    for (int i=0; i < csize; i++) {
+        VEC_pD &cparams = c2p[clist[i]];
+        for (VEC_pD::const_iterator p=cparams.begin(); p != cparams.end(); ++p) {
+            erow.push_back(i);
+            eparam.push_back(*p);
+        }
+        cstart.push_back(static_cast<int>(eparam.size()));
+    }
+
+    pstart.assign(psize+1, 0);
+    for (VEC_pD::const_iterator p=eparam.begin(); p != eparam.end(); ++p)
+        pstart[*p - pvals.data() + 1]++;
+    for (int j=0; j < psize; j++)
+        pstart[j+1] += pstart[j];
+    pentries.resize(eparam.size());
+    std::vector<int> pnext(pstart.begin(), pstart.end()-1);
+    for (int k=0; k < int(eparam.size()); k++)
+        pentries[pnext[eparam[k] - pvals.data()]++] = k;
+
+    evalorder.resize(csize);
+    std::vector<int> ctype(csize);
+    for (int i=0; i < csize; i++) {
+        evalorder[i] = i;
+        ctype[i] = clist[i]->getTypeId();
+    }
+    std::stable_sort(evalorder.begin(), evalorder.end(),
+                     [&ctype](int a, int b) { return ctype[a] < ctype[b]; });
+
+    residuals.resize(csize);
+    jvals.resize(eparam.size());
+}
+
+void SubSystem::evalResiduals()
+{
+    for (std::vector<int>::const_iterator i=evalorder.begin(); i != evalorder.end(); ++i)
+        residuals[*i] = clist[*i]->error();
+}
+
+void SubSystem::evalJacobian()
+{
+    for (std::vector<int>::const_iterator i=evalorder.begin(); i != evalorder.end(); ++i) {
+        Constraint *constr = clist[*i];
+        for (int k=cstart[*i]; k < cstart[*i+1]; k++)
+            jvals[k] = constr->grad(eparam[k]);
+    }
 }
 
 void SubSystem::redirectParams()
@@ -207,12 +261,11 @@ void SubSystem::getConstraintList(std::vector<Constraint *> &clist_)
 
 double SubSystem::error()
 {
+    evalResiduals();
+
     double err = 0.;
-    for (std::vector<Constraint *>::const_iterator constr=clist.begin();
-         constr != clist.end(); ++constr) {
-        double tmp = (*constr)->error();
-        err += tmp*tmp;
-    }
+    for (int i=0; i < csize; i++)
+        err += residuals[i]*residuals[i];
     err *= 0.5;
     return err;
 }
@@ -221,22 +274,19 @@ void SubSystem::calcResidual(Eigen::VectorXd &r)
 {
     assert(r.size() == csize);
 
-    int i=0;
-    for (std::vector<Constraint *>::const_iterator constr=clist.begin();
-         constr != clist.end(); ++constr, i++) {
-        r[i] = (*constr)->error();
-    }
+    evalResiduals();
+    for (int i=0; i < csize; i++)
+        r[i] = residuals[i];
 }
 
 void SubSystem::calcResidual(Eigen::VectorXd &r, double &err)
 {
     assert(r.size() == csize);
 
-    int i=0;
+    evalResiduals();
     err = 0.;
-    for (std::vector<Constraint *>::const_iterator constr=clist.begin();
-         constr != clist.end(); ++constr, i++) {
-        r[i] = (*constr)->error();
+    for (int i=0; i < csize; i++) {
+        r[i] = residuals[i];
         err += r[i]*r[i];
     }
     err *= 0.5;
@@ -261,12 +311,18 @@ void SubSystem::calcJacobi()
 void SubSystem::calcJacobi(VEC_pD &params, Eigen::MatrixXd &jacobi)
 {
     jacobi.setZero(csize, params.size());
+
+    evalJacobian();
     for (int j=0; j < int(params.size()); j++) {
         MAP_pD_pD::const_iterator
           pmapfind = pmap.find(params[j]);
-        if (pmapfind != pmap.end())
-            for (int i=0; i < csize; i++)
-                jacobi(i,j) = clist[i]->grad(pmapfind->second);
+        if (pmapfind != pmap.end()) {
+            int p = pmapfind->second - pvals.data();
+            for (int e=pstart[p]; e < pstart[p+1]; e++) {
+                int k = pentries[e];
+                jacobi(erow[k],j) = jvals[k];
+            }
+        }
     }
 }
 
@@ -280,15 +336,18 @@ void SubSystem::calcGrad(VEC_pD &params, Eigen::VectorXd &grad)
     assert(grad.size() == int(params.size()));
 
     grad.setZero();
+
+    evalResiduals();
+    evalJacobian();
     for (int j=0; j < int(params.size()); j++) {
         MAP_pD_pD::const_iterator
           pmapfind = pmap.find(params[j]);
         if (pmapfind != pmap.end()) {
-            // assert(p2c.find(pmapfind->second) != p2c.end());
-            std::vector<Constraint *> constrs=p2c[pmapfind->second];
-            for (std::vector<Constraint *>::const_iterator constr = constrs.begin();
-                 constr != constrs.end(); ++constr)
-                grad[j] += (*constr)->error() * (*constr)->grad(pmapfind->second);
+            int p = pmapfind->second - pvals.data();
+            for (int e=pstart[p]; e < pstart[p+1]; e++) {
+                int k = pentries[e];
+                grad[j] += residuals[erow[k]] * jvals[k];
+            }
         }
     }
 }
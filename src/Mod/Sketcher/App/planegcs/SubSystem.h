@@ -44,6 +44,20 @@ namespace GCS
         std::map<Constraint *,VEC_pD > c2p; // constraint to parameter adjacency list
         std::map<double *,std::vector<Constraint *> > p2c; // parameter to constraint adjacency list
         void initialize(VEC_pD &params, MAP_pD_pD &reductionmap); // called by the constructors
+
+        // Flat storage of the non-zero entries of the Jacobian. The entries of constraint i
+        // are cstart[i] to cstart[i+1]-1, pentries lists the entries of each parameter
+        // (pstart[j] to pstart[j+1]-1, j being the index in pvals) in constraint order.
+        std::vector<int> cstart;
+        std::vector<int> erow;        // constraint of each entry
+        VEC_pD eparam;                // parameter (in pvals) of each entry
+        std::vector<int> pstart;
+        std::vector<int> pentries;
+        std::vector<int> evalorder;   // the constraints grouped by their type
+        VEC_D residuals;              // error of each constraint, set by evalResiduals()
+        VEC_D jvals;                  // value of each entry, set by evalJacobian()
+        void evalResiduals();
+        void evalJacobian();
     public:
         SubSystem(std::vector<Constraint *> &clist_, VEC_pD &params);
         SubSystem(std::vector<Constraint *> &clist_, VEC_pD &params,
@@ -97,6 +97,7 @@
 
 # include <QGuiApplication>
 # include <QMessageBox>
+# include <QtConcurrentMap>
 #include <qdebug.h>
 #include <QString>
 
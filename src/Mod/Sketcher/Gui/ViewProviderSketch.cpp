@@ -29,7 +29,10 @@
 # include <Geom_BSplineCurve.hxx>
 # include <Geom_Circle.hxx>
 # include <Geom_Ellipse.hxx>
+# include <Geom_Hyperbola.hxx>
+# include <Geom_Parabola.hxx>
 # include <Geom_TrimmedCurve.hxx>
+# include <Standard_Failure.hxx>
 # include <Inventor/actions/SoGetBoundingBoxAction.h>
 # include <Inventor/SoPath.h>
 # include <Inventor/SbBox3f.h>
@@ -71,6 +74,7 @@
 # include <QTextStream>
 # include <QKeyEvent>
 # include <QDesktopWidget>
+# include <QtConcurrentMap>
 
 # include <boost_bind_bind.hpp>
 # include <boost/scoped_ptr.hpp>
@@ -170,6 +174,208 @@ SbVec2s ViewProviderSketch::prvClickPos;
 SbVec2s ViewProviderSketch::prvCursorPos;
 SbVec2s ViewProviderSketch::newCursorPos;
 
+//**************************************************************************
+// Retained edit mode visuals
+
+/// Polyline of a curve together with the parameters it was computed from.
+/// draw() only recomputes a polyline if the parameters of its curve have changed.
+struct CurvePolyline {
+    Base::Type type;
+    std::vector<double> key;
+    std::vector<Base::Vector3d> coords;
+};
+
+/// Constraint icon as rendered by ViewProviderSketch::renderConstrIcon()
+struct RenderedConstrIcon {
+    QImage image;
+    std::vector<QRect> boundingBoxes;
+    int vPad;
+};
+
+static void appendAxisKey(const gp_Ax2& pos, std::vector<double>& key)
+{
+    const gp_XYZ axes[3] = {pos.Location().XYZ(), pos.Direction().XYZ(), pos.XDirection().XYZ()};
+    for (const gp_XYZ& xyz : axes) {
+        key.push_back(xyz.X());
+        key.push_back(xyz.Y());
+        key.push_back(xyz.Z());
+    }
+}
+
+/// Returns the parameters that determine the polyline of a curve drawn by tessellateCurve()
+static std::vector<double> curvePolylineKey(const Part::Geometry *geo)
+{
+    std::vector<double> key;
+    Handle(Geom_Curve) curve = Handle(Geom_Curve)::DownCast(geo->handle());
+    Handle(Geom_TrimmedCurve) trimmed = Handle(Geom_TrimmedCurve)::DownCast(curve);
+    if (!trimmed.IsNull()) {
+        key.push_back(trimmed->FirstParameter());
+        key.push_back(trimmed->LastParameter());
+        curve = trimmed->BasisCurve();
+    }
+
+    if (curve->IsKind(STANDARD_TYPE(Geom_Conic))) {
+        appendAxisKey(Handle(Geom_Conic)::DownCast(curve)->Position(), key);
+        if (curve->IsKind(STANDARD_TYPE(Geom_Circle))) {
+            key.push_back(Handle(Geom_Circle)::DownCast(curve)->Radius());
+        }
+        else if (curve->IsKind(STANDARD_TYPE(Geom_Ellipse))) {
+            Handle(Geom_Ellipse) ellipse = Handle(Geom_Ellipse)::DownCast(curve);
+            key.push_back(ellipse->MajorRadius());
+            key.push_back(ellipse->MinorRadius());
+        }
+        else if (curve->IsKind(STANDARD_TYPE(Geom_Hyperbola))) {
+            Handle(Geom_Hyperbola) hyperbola = Handle(Geom_Hyperbola)::DownCast(curve);
+            key.push_back(hyperbola->MajorRadius());
+            key.push_back(hyperbola->MinorRadius());
+        }
+        else if (curve->IsKind(STANDARD_TYPE(Geom_Parabola))) {
+            key.push_back(Handle(Geom_Parabola)::DownCast(curve)->Focal());
+        }
+    }
+    else if (curve->IsKind(STANDARD_TYPE(Geom_BSplineCurve))) {
+        Handle(Geom_BSplineCurve) spline = Handle(Geom_BSplineCurve)::DownCast(curve);
+        key.push_back(spline->Degree());
+        key.push_back(spline->IsPeriodic() ? 1 : 0);
+        key.push_back(spline->FirstParameter());
+        key.push_back(spline->LastParameter());
+        for (int i = 1; i <= spline->NbPoles(); i++) {
+            gp_Pnt pole = spline->Pole(i);
+            key.push_back(pole.X());
+            key.push_back(pole.Y());
+            key.push_back(pole.Z());
+            key.push_back(spline->Weight(i));
+        }
+        for (int i = 1; i <= spline->NbKnots(); i++) {
+            key.push_back(spline->Knot(i));
+            key.push_back(spline->Multiplicity(i));
+        }
+    }
+
+    return key;
+}
+
+/// Computes the polyline of a circle, ellipse, conic arc or B-spline
+static void tessellateCurve(const Part::Geometry *geo, int stdcountsegments, std::vector<Base::Vector3d>& Coords)
+{
+    Coords.clear();
+
+    if (geo->getTypeId() == Part::GeomCircle::getClassTypeId()) {
+        const Part::GeomCircle *circle = static_cast<const Part::GeomCircle *>(geo);
+        Handle(Geom_Circle) curve = Handle(Geom_Circle)::DownCast(circle->handle());
+
+        int countSegments = stdcountsegments;
+        double segment = (2 * M_PI) / countSegments;
+
+        for (int i=0; i < countSegments; i++) {
+            gp_Pnt pnt = curve->Value(i*segment);
+            Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+        }
+
+        gp_Pnt pnt = curve->Value(0);
+        Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+    }
+    else if (geo->getTypeId() == Part::GeomEllipse::getClassTypeId()) {
+        const Part::GeomEllipse *ellipse = static_cast<const Part::GeomEllipse *>(geo);
+        Handle(Geom_Ellipse) curve = Handle(Geom_Ellipse)::DownCast(ellipse->handle());
+
+        int countSegments = stdcountsegments;
+        double segment = (2 * M_PI) / countSegments;
+        for (int i=0; i < countSegments; i++) {
+            gp_Pnt pnt = curve->Value(i*segment);
+            Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+        }
+
+        gp_Pnt pnt = curve->Value(0);
+        Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+    }
+    else if (geo->isDerivedFrom(Part::GeomArcOfConic::getClassTypeId())) {
+        const Part::GeomArcOfConic *arc = static_cast<const Part::GeomArcOfConic *>(geo);
+        Handle(Geom_TrimmedCurve) curve = Handle(Geom_TrimmedCurve)::DownCast(arc->handle());
+
+        // arcs of circles and ellipses are drawn in their own orientation
+        bool emulateCCW = geo->getTypeId() == Part::GeomArcOfHyperbola::getClassTypeId() ||
+                          geo->getTypeId() == Part::GeomArcOfParabola::getClassTypeId();
+
+        double startangle, endangle;
+        arc->getRange(startangle, endangle, emulateCCW);
+        if (startangle > endangle) // if arc is reversed
+            std::swap(startangle, endangle);
+
+        double range = endangle-startangle;
+        int countSegments = std::max(6, int(stdcountsegments * range / (2 * M_PI)));
+        double segment = range / countSegments;
+
+        for (int i=0; i < countSegments; i++) {
+            gp_Pnt pnt = curve->Value(startangle);
+            Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+            startangle += segment;
+        }
+
+        // end point
+        gp_Pnt pnt = curve->Value(endangle);
+        Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+    }
+    else if (geo->getTypeId() == Part::GeomBSplineCurve::getClassTypeId()) {
+        const Part::GeomBSplineCurve *spline = static_cast<const Part::GeomBSplineCurve *>(geo);
+        Handle(Geom_BSplineCurve) curve = Handle(Geom_BSplineCurve)::DownCast(spline->handle());
+
+        double first = curve->FirstParameter();
+        double last = curve->LastParameter();
+        if (first > last) // if arc is reversed
+            std::swap(first, last);
+
+        double range = last-first;
+        int countSegments = stdcountsegments;
+        double segment = range / countSegments;
+
+        for (int i=0; i < countSegments; i++) {
+            gp_Pnt pnt = curve->Value(first);
+            Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+            first += segment;
+        }
+
+        // end point
+        gp_Pnt end = curve->Value(last);
+        Coords.emplace_back(end.X(), end.Y(), end.Z());
+    }
+}
+
+/**
+ * Recomputes outdated curve polylines in a worker thread. A job only writes
+ * the polyline of its own geometry. The message of a failed curve is kept in
+ * the job, draw() clears that polyline and throws once all jobs are done.
+ */
+class CurveTessellator
+{
+public:
+    CurveTessellator(const std::vector<Part::Geometry *>& geomlist,
+                     std::vector<CurvePolyline>& polylines,
+                     int stdcountsegments)
+      : geomlist(geomlist)
+      , polylines(polylines)
+      , stdcountsegments(stdcountsegments)
+    {
+    }
+    void operator()(std::pair<std::size_t, std::string>& job) const
+    {
+        try {
+            tessellateCurve(geomlist[job.first], stdcountsegments, polylines[job.first].coords);
+        }
+        catch (const Standard_Failure& e) {
+            job.second = e.GetMessageString();
+        }
+        catch (const std::exception& e) {
+            job.second = e.what();
+        }
+    }
+
+private:
+    const std::vector<Part::Geometry *>& geomlist;
+    std::vector<CurvePolyline>& polylines;
+    int stdcountsegments;
+};
+
 //**************************************************************************
 // Edit data structure
 
@@ -188,6 +394,7 @@ struct EditData {
     coinFontSize(17), // this value is in pixels, 17 pixels
     constraintIconSize(15),
     pixelScalingFactor(1.0),
+    CurvePolylineSegments(0),
     blockedPreselection(false),
     FullyConstrained(false),
     //ActSketch(0), // if you are wondering, it went to SketchObject, accessible via getSolvedSketch() and via SketchObject interface as appropriate
@@ -265,6 +472,13 @@ struct EditData {
     // constraint IDs.
     std::map<QString, ViewProviderSketch::ConstrIconBBVec> combinedConstrBoxes;
 
+    // Polylines of the curves by geometry index, reused as long as the curve doesn't change
+    std::vector<CurvePolyline> CurvePolylines;
+    int CurvePolylineSegments;
+
+    // Rendered constraint icons, reused while dragging as long as type, color and labels match
+    std::map<QString, RenderedConstrIcon> ConstrIconCache;
+
     // nodes for the visuals
     SoSeparator   *EditRoot;
     SoMaterial    *PointsMaterials;
@@ -3692,6 +3906,32 @@ QImage ViewProviderSketch::renderConstrIcon(const QString &type,
     // Constants to help create constraint icons
     QString joinStr = QString::fromLatin1(", ");
 
+    // Icons that are not rotated are reused. While dragging the type, color and labels
+    // of an icon rarely change, only its position.
+    QString cacheKey;
+    if (iconRotation == 0) {
+        QStringList keyParts;
+        keyParts << type << QString::number(edit->constraintIconSize) << QString::number(iconColor.rgba());
+        QList<QColor>::const_iterator colorIt = labelColors.begin();
+        for (QStringList::const_iterator labelIt = labels.begin(); labelIt != labels.end(); ++labelIt) {
+            keyParts << *labelIt;
+            if (colorIt != labelColors.end())
+                keyParts << QString::number((colorIt++)->rgba());
+        }
+        cacheKey = keyParts.join(QChar(0x1f));
+
+        std::map<QString, RenderedConstrIcon>::const_iterator cached = edit->ConstrIconCache.find(cacheKey);
+        if (cached != edit->ConstrIconCache.end()) {
+            if (boundingBoxes)
+                boundingBoxes->insert(boundingBoxes->end(), cached->second.boundingBoxes.begin(), cached->second.boundingBoxes.end());
+            if (vPad)
+                *vPad = cached->second.vPad;
+            return cached->second.image;
+        }
+    }
+
+    RenderedConstrIcon rendered;
+
     QPixmap pxMap;
     std::stringstream constraintName;
     constraintName << type.toLatin1().data() << edit->constraintIconSize; // allow resizing by embedding size
@@ -3710,8 +3950,7 @@ QImage ViewProviderSketch::renderConstrIcon(const QString &type,
     // See Qt docs on qRect::bottom() for explanation of the +1
     int pxBelowBase = qfm.boundingRect(labels.join(joinStr)).bottom() + 1;
 
-    if(vPad)
-        *vPad = pxBelowBase;
+    rendered.vPad = pxBelowBase;
 
     QTransform rotation;
     rotation.rotate(iconRotation);
@@ -3721,8 +3960,7 @@ QImage ViewProviderSketch::renderConstrIcon(const QString &type,
                                                         roticon.height() + pxBelowBase);
 
     // Make a bounding box for the icon
-    if(boundingBoxes)
-        boundingBoxes->push_back(QRect(0, 0, roticon.width(), roticon.height()));
+    rendered.boundingBoxes.push_back(QRect(0, 0, roticon.width(), roticon.height()));
 
     // Render the Icons
     QPainter qp(&image);
@@ -3758,17 +3996,30 @@ QImage ViewProviderSketch::renderConstrIcon(const QString &type,
             //       icon.width() is ever very small (or removed).
             qp.drawText(icon.width() + cursorOffset, icon.height(), labelStr);
 
-            if(boundingBoxes) {
-                labelBB = qfm.boundingRect(labelStr);
-                labelBB.moveTo(icon.width() + cursorOffset,
-                               icon.height() - qfm.height() + pxBelowBase);
-                boundingBoxes->push_back(labelBB);
-            }
+            labelBB = qfm.boundingRect(labelStr);
+            labelBB.moveTo(icon.width() + cursorOffset,
+                           icon.height() - qfm.height() + pxBelowBase);
+            rendered.boundingBoxes.push_back(labelBB);
 
             cursorOffset += Gui::QtTools::horizontalAdvance(qfm, labelStr);
         }
     }
 
+    qp.end();
+
+    if (boundingBoxes)
+        boundingBoxes->insert(boundingBoxes->end(), rendered.boundingBoxes.begin(), rendered.boundingBoxes.end());
+    if (vPad)
+        *vPad = rendered.vPad;
+
+    if (!cacheKey.isEmpty()) {
+        // labels are arbitrary, so keep the cache from growing without bounds
+        if (edit->ConstrIconCache.size() > 1000)
+            edit->ConstrIconCache.clear();
+        rendered.image = image;
+        edit->ConstrIconCache[cacheKey] = rendered;
+    }
+
     return image;
 }
 
@@ -3895,9 +4146,7 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
     assert(edit);
 
     // Render Geometry ===================================================
-    std::vector<Base::Vector3d> Coords;
     std::vector<Base::Vector3d> Points;
-    std::vector<unsigned int> Index;
 
     int intGeoCount = getSketchObject()->getHighestCurveIndex() + 1;
     int extGeoCount = getSketchObject()->getExternalGeometryCount();
@@ -3946,9 +4195,42 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
     // RootPoint
     Points.emplace_back(0.,0.,0.);
 
+    // The polylines of the curves are retained between calls. Only the polylines of curves
+    // whose parameters changed are recomputed, which while dragging is usually a small part.
+    if (edit->CurvePolylineSegments != stdcountsegments) {
+        edit->CurvePolylines.clear();
+        edit->CurvePolylineSegments = stdcountsegments;
+    }
+    edit->CurvePolylines.resize(geomlist->size() - 2);
+
+    std::vector<std::size_t> CurvSlots; // geometry index of each curve in the line set
+    std::vector<std::pair<std::size_t, std::string> > outdatedPolylines;
+
+    auto retainPolyline = [&](std::size_t slot, const Part::Geometry *geo) {
+        CurvePolyline &polyline = edit->CurvePolylines[slot];
+        std::vector<double> key = curvePolylineKey(geo);
+        if (polyline.type != geo->getTypeId() || polyline.key != key || polyline.coords.empty()) {
+            polyline.type = geo->getTypeId();
+            polyline.key.swap(key);
+            outdatedPolylines.emplace_back(slot, std::string());
+        }
+        CurvSlots.push_back(slot);
+    };
+
+    // polyline that is computed on every call
+    auto volatilePolyline = [&](std::size_t slot) -> std::vector<Base::Vector3d>& {
+        CurvePolyline &polyline = edit->CurvePolylines[slot];
+        polyline.type = Base::Type::badType();
+        polyline.key.clear();
+        polyline.coords.clear();
+        CurvSlots.push_back(slot);
+        return polyline.coords;
+    };
+
     for (std::vector<Part::Geometry *>::const_iterator it = geomlist->begin(); it != geomlist->end()-2; ++it, GeoId++) {
         if (GeoId >= intGeoCount)
             GeoId = -extGeoCount;
+        std::size_t slot = it - geomlist->begin();
         if ((*it)->getTypeId() == Part::GeomPoint::getClassTypeId()) { // add a point
             const Part::GeomPoint *point = static_cast<const Part::GeomPoint *>(*it);
             Points.push_back(point->getPoint());
@@ -3957,18 +4239,17 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
         else if ((*it)->getTypeId() == Part::GeomLineSegment::getClassTypeId()) { // add a line
             const Part::GeomLineSegment *lineSeg = static_cast<const Part::GeomLineSegment *>(*it);
             // create the definition struct for that geom
+            std::vector<Base::Vector3d> &Coords = volatilePolyline(slot);
             Coords.push_back(lineSeg->getStartPoint());
             Coords.push_back(lineSeg->getEndPoint());
             Points.push_back(lineSeg->getStartPoint());
             Points.push_back(lineSeg->getEndPoint());
-            Index.push_back(2);
             edit->CurvIdToGeoId.push_back(GeoId);
             edit->PointIdToGeoId.push_back(GeoId);
             edit->PointIdToGeoId.push_back(GeoId);
         }
         else if ((*it)->getTypeId() == Part::GeomCircle::getClassTypeId()) { // add a circle
             const Part::GeomCircle *circle = static_cast<const Part::GeomCircle *>(*it);
-            Handle(Geom_Circle) curve = Handle(Geom_Circle)::DownCast(circle->handle());
             auto gf = GeometryFacade::getFacade(circle);
 
             int countSegments = stdcountsegments;
@@ -3980,6 +4261,7 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
             //
             // This code produces the scaled up version of the geometry for the scenograph
             if(gf->getInternalType() == InternalType::BSplineControlPoint) {
+                std::vector<Base::Vector3d> &Coords = volatilePolyline(slot);
                 for( auto c : getSketchObject()->Constraints.getValues()) {
                     if( c->Type == InternalAlignment && c->AlignmentType == BSplineControlPoint && c->First == GeoId) {
                         auto bspline = dynamic_cast<const Part::GeomBSplineCurve *>((*geomlist)[c->Second]);
@@ -4069,71 +4351,32 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
                 }
             }
             else {
-
-                double segment = (2 * M_PI) / countSegments;
-
-                for (int i=0; i < countSegments; i++) {
-                    gp_Pnt pnt = curve->Value(i*segment);
-                    Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-                }
-
-                gp_Pnt pnt = curve->Value(0);
-                Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                retainPolyline(slot, circle);
             }
 
-            Index.push_back(countSegments+1);
             edit->CurvIdToGeoId.push_back(GeoId);
             Points.push_back(center);
             edit->PointIdToGeoId.push_back(GeoId);
         }
         else if ((*it)->getTypeId() == Part::GeomEllipse::getClassTypeId()) { // add an ellipse
             const Part::GeomEllipse *ellipse = static_cast<const Part::GeomEllipse *>(*it);
-            Handle(Geom_Ellipse) curve = Handle(Geom_Ellipse)::DownCast(ellipse->handle());
 
-            int countSegments = stdcountsegments;
             Base::Vector3d center = ellipse->getCenter();
-            double segment = (2 * M_PI) / countSegments;
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(i*segment);
-                Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-            }
-
-            gp_Pnt pnt = curve->Value(0);
-            Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+            retainPolyline(slot, ellipse);
 
-            Index.push_back(countSegments+1);
             edit->CurvIdToGeoId.push_back(GeoId);
             Points.push_back(center);
             edit->PointIdToGeoId.push_back(GeoId);
         }
         else if ((*it)->getTypeId() == Part::GeomArcOfCircle::getClassTypeId()) { // add an arc
             const Part::GeomArcOfCircle *arc = static_cast<const Part::GeomArcOfCircle *>(*it);
-            Handle(Geom_TrimmedCurve) curve = Handle(Geom_TrimmedCurve)::DownCast(arc->handle());
-
-            double startangle, endangle;
-            arc->getRange(startangle, endangle, /*emulateCCW=*/false);
-            if (startangle > endangle) // if arc is reversed
-                std::swap(startangle, endangle);
-
-            double range = endangle-startangle;
-            int countSegments = std::max(6, int(stdcountsegments * range / (2 * M_PI)));
-            double segment = range / countSegments;
 
             Base::Vector3d center = arc->getCenter();
             Base::Vector3d start  = arc->getStartPoint(/*emulateCCW=*/true);
             Base::Vector3d end    = arc->getEndPoint(/*emulateCCW=*/true);
 
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(startangle);
-                Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-                startangle += segment;
-            }
-
-            // end point
-            gp_Pnt pnt = curve->Value(endangle);
-            Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+            retainPolyline(slot, arc);
 
-            Index.push_back(countSegments+1);
             edit->CurvIdToGeoId.push_back(GeoId);
             Points.push_back(start);
             Points.push_back(end);
@@ -4144,32 +4387,13 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
         }
         else if ((*it)->getTypeId() == Part::GeomArcOfEllipse::getClassTypeId()) { // add an arc
             const Part::GeomArcOfEllipse *arc = static_cast<const Part::GeomArcOfEllipse *>(*it);
-            Handle(Geom_TrimmedCurve) curve = Handle(Geom_TrimmedCurve)::DownCast(arc->handle());
-
-            double startangle, endangle;
-            arc->getRange(startangle, endangle, /*emulateCCW=*/false);
-            if (startangle > endangle) // if arc is reversed
-                std::swap(startangle, endangle);
-
-            double range = endangle-startangle;
-            int countSegments = std::max(6, int(stdcountsegments * range / (2 * M_PI)));
-            double segment = range / countSegments;
 
             Base::Vector3d center = arc->getCenter();
             Base::Vector3d start  = arc->getStartPoint(/*emulateCCW=*/true);
             Base::Vector3d end    = arc->getEndPoint(/*emulateCCW=*/true);
 
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(startangle);
-                Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-                startangle += segment;
-            }
-
-            // end point
-            gp_Pnt pnt = curve->Value(endangle);
-            Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+            retainPolyline(slot, arc);
 
-            Index.push_back(countSegments+1);
             edit->CurvIdToGeoId.push_back(GeoId);
             Points.push_back(start);
             Points.push_back(end);
@@ -4180,32 +4404,13 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
         }
         else if ((*it)->getTypeId() == Part::GeomArcOfHyperbola::getClassTypeId()) {
             const Part::GeomArcOfHyperbola *aoh = static_cast<const Part::GeomArcOfHyperbola *>(*it);
-            Handle(Geom_TrimmedCurve) curve = Handle(Geom_TrimmedCurve)::DownCast(aoh->handle());
-
-            double startangle, endangle;
-            aoh->getRange(startangle, endangle, /*emulateCCW=*/true);
-            if (startangle > endangle) // if arc is reversed
-                std::swap(startangle, endangle);
-
-            double range = endangle-startangle;
-            int countSegments = std::max(6, int(stdcountsegments * range / (2 * M_PI)));
-            double segment = range / countSegments;
 
             Base::Vector3d center = aoh->getCenter();
             Base::Vector3d start  = aoh->getStartPoint();
             Base::Vector3d end    = aoh->getEndPoint();
 
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(startangle);
-                Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-                startangle += segment;
-            }
-
-            // end point
-            gp_Pnt pnt = curve->Value(endangle);
-            Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+            retainPolyline(slot, aoh);
 
-            Index.push_back(countSegments+1);
             edit->CurvIdToGeoId.push_back(GeoId);
             Points.push_back(start);
             Points.push_back(end);
@@ -4216,32 +4421,13 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
         }
         else if ((*it)->getTypeId() == Part::GeomArcOfParabola::getClassTypeId()) {
             const Part::GeomArcOfParabola *aop = static_cast<const Part::GeomArcOfParabola *>(*it);
-            Handle(Geom_TrimmedCurve) curve = Handle(Geom_TrimmedCurve)::DownCast(aop->handle());
-
-            double startangle, endangle;
-            aop->getRange(startangle, endangle, /*emulateCCW=*/true);
-            if (startangle > endangle) // if arc is reversed
-                std::swap(startangle, endangle);
-
-            double range = endangle-startangle;
-            int countSegments = std::max(6, int(stdcountsegments * range / (2 * M_PI)));
-            double segment = range / countSegments;
 
             Base::Vector3d center = aop->getCenter();
             Base::Vector3d start  = aop->getStartPoint();
             Base::Vector3d end    = aop->getEndPoint();
 
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(startangle);
-                Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-                startangle += segment;
-            }
-
-            // end point
-            gp_Pnt pnt = curve->Value(endangle);
-            Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+            retainPolyline(slot, aop);
 
-            Index.push_back(countSegments+1);
             edit->CurvIdToGeoId.push_back(GeoId);
             Points.push_back(start);
             Points.push_back(end);
@@ -4253,31 +4439,12 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
         else if ((*it)->getTypeId() == Part::GeomBSplineCurve::getClassTypeId()) { // add a bspline
             bsplineGeoIds.push_back(GeoId);
             const Part::GeomBSplineCurve *spline = static_cast<const Part::GeomBSplineCurve *>(*it);
-            Handle(Geom_BSplineCurve) curve = Handle(Geom_BSplineCurve)::DownCast(spline->handle());
 
             Base::Vector3d startp  = spline->getStartPoint();
             Base::Vector3d endp    = spline->getEndPoint();
 
-            double first = curve->FirstParameter();
-            double last = curve->LastParameter();
-            if (first > last) // if arc is reversed
-                std::swap(first, last);
-
-            double range = last-first;
-            int countSegments = stdcountsegments;
-            double segment = range / countSegments;
-
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(first);
-                Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-                first += segment;
-            }
-
-            // end point
-            gp_Pnt end = curve->Value(last);
-            Coords.emplace_back(end.X(), end.Y(), end.Z());
+            retainPolyline(slot, spline);
 
-            Index.push_back(countSegments+1);
             edit->CurvIdToGeoId.push_back(GeoId);
             Points.push_back(startp);
             Points.push_back(endp);
@@ -4349,6 +4516,22 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
     if ( (combrepscale > (2 * combrepscalehyst)) || (combrepscale < (combrepscalehyst/2)))
         combrepscalehyst = combrepscale ;
 
+    // recompute the outdated polylines, concurrently if there are enough of them
+    if (outdatedPolylines.size() > 1) {
+        QtConcurrent::blockingMap(outdatedPolylines, CurveTessellator(*geomlist, edit->CurvePolylines, stdcountsegments));
+    }
+    else if (!outdatedPolylines.empty()) {
+        CurveTessellator(*geomlist, edit->CurvePolylines, stdcountsegments)(outdatedPolylines.front());
+    }
+
+    for (std::vector<std::pair<std::size_t, std::string> >::iterator it = outdatedPolylines.begin(); it != outdatedPolylines.end(); ++it) {
+        if (!it->second.empty()) {
+            // make sure the polyline is recomputed the next time
+            edit->CurvePolylines[it->first].coords.clear();
+            throw Base::CADKernelError(it->second);
+        }
+    }
+
 
     // geometry information layer for bsplines, as they need a second round now that max curvature is known
     for (std::vector<int>::const_iterator it = bsplineGeoIds.begin(); it != bsplineGeoIds.end(); ++it) {
@@ -4806,9 +4989,13 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
 
     visibleInformationChanged=false; // whatever that changed in Information layer is already updated
 
-    edit->CurvesCoordinate->point.setNum(Coords.size());
-    edit->CurveSet->numVertices.setNum(Index.size());
-    edit->CurvesMaterials->diffuseColor.setNum(Index.size());
+    std::size_t numCoords = 0;
+    for (std::vector<std::size_t>::const_iterator it = CurvSlots.begin(); it != CurvSlots.end(); ++it)
+        numCoords += edit->CurvePolylines[*it].coords.size();
+
+    edit->CurvesCoordinate->point.setNum(numCoords);
+    edit->CurveSet->numVertices.setNum(CurvSlots.size());
+    edit->CurvesMaterials->diffuseColor.setNum(CurvSlots.size());
     edit->PointsCoordinate->point.setNum(Points.size());
     edit->PointsMaterials->diffuseColor.setNum(Points.size());
 
@@ -4818,17 +5005,18 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
 
     float dMg = 100;
 
-    int i=0; // setting up the line set
-    for (std::vector<Base::Vector3d>::const_iterator it = Coords.begin(); it != Coords.end(); ++it,i++) {
-        dMg = dMg>std::abs(it->x)?dMg:std::abs(it->x);
-        dMg = dMg>std::abs(it->y)?dMg:std::abs(it->y);
-        verts[i].setValue(it->x,it->y,zLowLines);
+    int i=0; // setting up the line set and its indexes
+    int curvId=0;
+    for (std::vector<std::size_t>::const_iterator jt = CurvSlots.begin(); jt != CurvSlots.end(); ++jt, curvId++) {
+        const std::vector<Base::Vector3d> &Coords = edit->CurvePolylines[*jt].coords;
+        for (std::vector<Base::Vector3d>::const_iterator it = Coords.begin(); it != Coords.end(); ++it,i++) {
+            dMg = dMg>std::abs(it->x)?dMg:std::abs(it->x);
+            dMg = dMg>std::abs(it->y)?dMg:std::abs(it->y);
+            verts[i].setValue(it->x,it->y,zLowLines);
+        }
+        index[curvId] = Coords.size();
     }
 
-    i=0; // setting up the indexes of the line set
-    for (std::vector<unsigned int>::const_iterator it = Index.begin(); it != Index.end(); ++it,i++)
-        index[i] = *it;
-
     i=0; // setting up the point set
     for (std::vector<Base::Vector3d>::const_iterator it = Points.begin(); it != Points.end(); ++it,i++){
         dMg = dMg>std::abs(it->x)?dMg:std::abs(it->x);
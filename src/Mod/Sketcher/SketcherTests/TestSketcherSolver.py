@@ -120,6 +120,25 @@ def CreateSlotPlateInnerSet(SketchFeature):
     SketchFeature.addConstraint(Sketcher.Constraint('Coincident',7,2,8,1))
     SketchFeature.addConstraint(Sketcher.Constraint('Coincident',8,2,5,1))
 
+def CreateDragSketchSet(SketchFeature):
+    # a rectangle with a fixed corner and an independent circle
+    SketchFeature.addGeometry(Part.LineSegment(App.Vector(5,12,0),App.Vector(15,12,0)))
+    SketchFeature.addGeometry(Part.LineSegment(App.Vector(15,12,0),App.Vector(15,5,0)))
+    SketchFeature.addGeometry(Part.LineSegment(App.Vector(15,5,0),App.Vector(5,5,0)))
+    SketchFeature.addGeometry(Part.LineSegment(App.Vector(5,5,0),App.Vector(5,12,0)))
+    SketchFeature.addGeometry(Part.Circle(App.Vector(-20,-20,0),App.Vector(0,0,1),4),False)
+    SketchFeature.addConstraint(Sketcher.Constraint('Coincident',0,2,1,1))
+    SketchFeature.addConstraint(Sketcher.Constraint('Coincident',1,2,2,1))
+    SketchFeature.addConstraint(Sketcher.Constraint('Coincident',2,2,3,1))
+    SketchFeature.addConstraint(Sketcher.Constraint('Coincident',3,2,0,1))
+    SketchFeature.addConstraint(Sketcher.Constraint('Horizontal',0))
+    SketchFeature.addConstraint(Sketcher.Constraint('Horizontal',2))
+    SketchFeature.addConstraint(Sketcher.Constraint('Vertical',1))
+    SketchFeature.addConstraint(Sketcher.Constraint('Vertical',3))
+    SketchFeature.addConstraint(Sketcher.Constraint('DistanceX',2,2,5.0))
+    SketchFeature.addConstraint(Sketcher.Constraint('DistanceY',2,2,5.0))
+    SketchFeature.addConstraint(Sketcher.Constraint('Radius',4,4.0))
+
 #---------------------------------------------------------------------------
 # define the test cases to test the FreeCAD Sketcher module
 #---------------------------------------------------------------------------
@@ -245,6 +264,84 @@ class TestSketcherSolver(unittest.TestCase):
         ActiveSketch.solve()
         self.failUnless(status == 0) # no redundants/conflicts/convergence issues
 
+    def checkDragResult(self, drag, full):
+        # the result of the drag must not change when the sketch is solved again
+        # and match a full solve with the dragged corner constrained in place
+        full.addConstraint(Sketcher.Constraint('DistanceX',0,2,30.0))
+        full.addConstraint(Sketcher.Constraint('DistanceY',0,2,20.0))
+        self.Doc.recompute()
+
+        dragged = drag.Geometry
+        self.failUnless(drag.solve() == 0)
+        for geo1, geo2, geo3 in zip(dragged, drag.Geometry, full.Geometry):
+            if isinstance(geo1, Part.LineSegment):
+                points = [(geo1.StartPoint, geo2.StartPoint, geo3.StartPoint),
+                          (geo1.EndPoint, geo2.EndPoint, geo3.EndPoint)]
+            else:
+                points = [(geo1.Center, geo2.Center, geo3.Center)]
+                self.assertAlmostEqual(geo1.Radius, geo3.Radius, places=6)
+            for pnt1, pnt2, pnt3 in points:
+                self.assertAlmostEqual(pnt1.distanceToPoint(pnt2), 0.0, places=6)
+                self.assertAlmostEqual(pnt1.distanceToPoint(pnt3), 0.0, places=6)
+
+    def testIncrementalDrag(self):
+        # the drag only solves the subsystem of the rectangle
+        drag = self.Doc.addObject('Sketcher::SketchObject','SketchDrag')
+        CreateDragSketchSet(drag)
+        full = self.Doc.addObject('Sketcher::SketchObject','SketchFull')
+        CreateDragSketchSet(full)
+        self.Doc.recompute()
+
+        for pos in ((18,14), (24,17), (30,20)):
+            drag.movePoint(0,2,App.Vector(pos[0],pos[1],0))
+        self.checkDragResult(drag, full)
+
+    def testTemporaryDrag(self):
+        # like the sketch editor, only the solver is moved while dragging, each
+        # step starting from the previous one, and movePoint() applies the result
+        drag = self.Doc.addObject('Sketcher::SketchObject','SketchDrag')
+        CreateDragSketchSet(drag)
+        full = self.Doc.addObject('Sketcher::SketchObject','SketchFull')
+        CreateDragSketchSet(full)
+        self.Doc.recompute()
+
+        corner = drag.Geometry[0].EndPoint
+        drag.initTemporaryMove(0,2,False)
+        for pos in ((18,14), (21,15), (24,17), (27,19)):
+            drag.moveTemporaryPoint(0,2,App.Vector(pos[0],pos[1],0))
+        self.assertAlmostEqual(drag.Geometry[0].EndPoint.distanceToPoint(corner), 0.0, places=6)
+        drag.movePoint(0,2,App.Vector(30,20,0))
+        self.checkDragResult(drag, full)
+
+    def testDetectMissingConstraints(self):
+        sketch = self.Doc.addObject('Sketcher::SketchObject','SketchAnalysis')
+        sketch.addGeometry(Part.LineSegment(App.Vector(0,0,0),App.Vector(10,0,0)))
+        sketch.addGeometry(Part.LineSegment(App.Vector(10,0.00001,0),App.Vector(10,5,0)))
+        sketch.addGeometry(Part.LineSegment(App.Vector(10,5,0),App.Vector(0,5,0)))
+        sketch.addGeometry(Part.LineSegment(App.Vector(0,5,0),App.Vector(0,0,0)))
+        sketch.addGeometry(Part.Circle(App.Vector(30,0,0),App.Vector(0,0,1),2),False)
+        sketch.addGeometry(Part.Circle(App.Vector(40,0,0),App.Vector(0,0,1),2.00001),False)
+        sketch.addGeometry(Part.Circle(App.Vector(50,0,0),App.Vector(0,0,1),3),False)
+        sketch.addConstraint(Sketcher.Constraint('Coincident',1,2,2,1))
+
+        def pairs(constraints):
+            return set(frozenset(((c[0], c[1]), (c[2], c[3]))) for c in constraints)
+
+        # the gap of the second line is below the default tolerance
+        self.failUnless(sketch.detectMissingPointOnPointConstraints() == 3)
+        self.assertEqual(pairs(sketch.MissingPointOnPointConstraints),
+                         {frozenset(((0,2),(1,1))), frozenset(((2,2),(3,1))), frozenset(((3,2),(0,1)))})
+
+        # with a tolerance this small the grid cells cannot be indexed
+        self.failUnless(sketch.detectMissingPointOnPointConstraints(1e-300) == 2)
+        self.assertEqual(pairs(sketch.MissingPointOnPointConstraints),
+                         {frozenset(((2,2),(3,1))), frozenset(((3,2),(0,1)))})
+
+        self.failUnless(sketch.detectMissingEqualityConstraints() == 3)
+        self.assertEqual(pairs(sketch.MissingLineEqualityConstraints),
+                         {frozenset(((0,0),(2,0))), frozenset(((1,0),(3,0)))})
+        self.assertEqual(pairs(sketch.MissingRadiusConstraints), {frozenset(((4,0),(5,0)))})
+
     def tearDown(self):
         #closing doc
         FreeCAD.closeDocument("SketchSolverTest")
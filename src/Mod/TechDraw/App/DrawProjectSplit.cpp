@@ -66,6 +66,10 @@
 #include <algorithm>
 #include <cmath>
 #include <GeomLib_Tool.hxx>
+#include <Precision.hxx>
+
+#include <QFuture>
+#include <QtConcurrentMap>
 
 #include <App/Application.h>
 #include <Base/BoundBox.h>
@@ -170,63 +174,7 @@ std::vector<TopoDS_Edge> DrawProjectSplit::getEdges(TechDraw::GeometryObject* ge
 
     //HLR algo does not provide all edge intersections for edge endpoints.
     //need to split long edges touched by Vertex of another edge
-    std::vector<splitPoint> splits;
-    std::vector<TopoDS_Edge>::iterator itOuter = origEdges.begin();
-    int iOuter = 0;
-    for (; itOuter != origEdges.end(); ++itOuter, iOuter++) {
-        TopoDS_Vertex v1 = TopExp::FirstVertex((*itOuter));
-        TopoDS_Vertex v2 = TopExp::LastVertex((*itOuter));
-        Bnd_Box sOuter;
-        BRepBndLib::Add(*itOuter, sOuter);
-        sOuter.SetGap(0.1);
-        if (sOuter.IsVoid()) {
-            Base::Console().Message("DPS::Extract Faces - outer Bnd_Box is void\n");
-            continue;
-        }
-        if (DrawUtil::isZeroEdge(*itOuter)) {
-            Base::Console().Message("DPS::extractFaces - outerEdge: %d is ZeroEdge\n",iOuter);   //this is not finding ZeroEdges
-            continue;  //skip zero length edges. shouldn't happen ;)
-        }
-        int iInner = 0;
-        std::vector<TopoDS_Edge>::iterator itInner = faceEdges.begin();
-        for (; itInner != faceEdges.end(); ++itInner,iInner++) {
-            if (iInner == iOuter) {
-                continue;
-            }
-            if (DrawUtil::isZeroEdge((*itInner))) {
-                continue;  //skip zero length edges. shouldn't happen ;)
-            }
-
-            Bnd_Box sInner;
-            BRepBndLib::Add(*itInner, sInner);
-            sInner.SetGap(0.1);
-            if (sInner.IsVoid()) {
-                Base::Console().Log("INFO - DPS::Extract Faces - inner Bnd_Box is void\n");
-                continue;
-            }
-            if (sOuter.IsOut(sInner)) {      //bboxes of edges don't intersect, don't bother
-                continue;
-            }
-
-            double param = -1;
-            if (isOnEdge((*itInner),v1,param,false)) {
-                gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
-                splitPoint s1;
-                s1.i = iInner;
-                s1.v = Base::Vector3d(pnt1.X(),pnt1.Y(),pnt1.Z());
-                s1.param = param;
-                splits.push_back(s1);
-            }
-            if (isOnEdge((*itInner),v2,param,false)) {
-                gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
-                splitPoint s2;
-                s2.i = iInner;
-                s2.v = Base::Vector3d(pnt2.X(),pnt2.Y(),pnt2.Z());
-                s2.param = param;
-                splits.push_back(s2);
-            }
-        } //inner loop
-    }   //outer loop
+    std::vector<splitPoint> splits = getSplitPoints(faceEdges);
 
     std::vector<splitPoint> sorted = sortSplits(splits,true);
     auto last = std::unique(sorted.begin(), sorted.end(), DrawProjectSplit::splitEqual);  //duplicates to back
@@ -241,6 +189,161 @@ std::vector<TopoDS_Edge> DrawProjectSplit::getEdges(TechDraw::GeometryObject* ge
 }
 
 
+namespace {
+//finds the split points caused by the end vertices of one edge
+struct EdgeSplitFinder
+{
+    typedef std::vector<splitPoint> result_type;
+
+    EdgeSplitFinder(const std::vector<TopoDS_Edge>& e,
+                    const std::vector<Bnd_Box>& b,
+                    const std::vector<bool>& u,
+                    const std::vector<std::vector<int> >& g,
+                    int c, double x, double y, double cx, double cy)
+      : edges(e), boxes(b), usable(u), grid(g),
+        cells(c), xMin(x), yMin(y), cellX(cx), cellY(cy)
+    {
+    }
+
+    int cellIndex(double v, double vMin, double cellSize) const
+    {
+        int i = static_cast<int>((v - vMin) / cellSize);
+        return std::min(std::max(i, 0), cells - 1);
+    }
+
+    std::vector<splitPoint> operator()(int iOuter) const
+    {
+        std::vector<splitPoint> result;
+        if (!usable[iOuter]) {
+            return result;
+        }
+        const TopoDS_Edge& outer = edges[iOuter];
+        TopoDS_Vertex ends[2] = { TopExp::FirstVertex(outer),
+                                  TopExp::LastVertex(outer) };
+        for (auto& v: ends) {
+            gp_Pnt pnt = BRep_Tool::Pnt(v);
+            int ix = cellIndex(pnt.X(), xMin, cellX);
+            int iy = cellIndex(pnt.Y(), yMin, cellY);
+            for (auto& iInner: grid[iy * cells + ix]) {
+                if (iInner == iOuter) {
+                    continue;
+                }
+                if (boxes[iInner].IsOut(pnt)) {      //vertex not near this edge, don't bother
+                    continue;
+                }
+                double param = -1;
+                if (DrawProjectSplit::isOnEdge(edges[iInner],v,param,false)) {
+                    splitPoint s;
+                    s.i = iInner;
+                    s.v = Base::Vector3d(pnt.X(),pnt.Y(),pnt.Z());
+                    s.param = param;
+                    result.push_back(s);
+                }
+            }
+        }
+        return result;
+    }
+
+    const std::vector<TopoDS_Edge>& edges;
+    const std::vector<Bnd_Box>& boxes;
+    const std::vector<bool>& usable;
+    const std::vector<std::vector<int> >& grid;
+    int cells;
+    double xMin, yMin;
+    double cellX, cellY;
+};
+
+//splits one edge at its (sorted) split points
+struct EdgeSplitter
+{
+    typedef std::vector<TopoDS_Edge> result_type;
+
+    EdgeSplitter(const std::vector<TopoDS_Edge>& e,
+                 const std::vector<std::vector<splitPoint> >& s)
+      : edges(e), edgeSplits(s)
+    {
+    }
+
+    std::vector<TopoDS_Edge> operator()(int iEdge) const
+    {
+        return DrawProjectSplit::split1Edge(edges[iEdge], edgeSplits[iEdge]);
+    }
+
+    const std::vector<TopoDS_Edge>& edges;
+    const std::vector<std::vector<splitPoint> >& edgeSplits;
+};
+}
+
+//find the places where the end vertex of one edge touches the interior of another.
+//the edges are binned into a uniform 2d grid by their bounding boxes so that each
+//vertex is only checked against the edges sharing its cell instead of against every
+//edge. the vertex tests are run concurrently.
+std::vector<splitPoint> DrawProjectSplit::getSplitPoints(const std::vector<TopoDS_Edge>& edges)
+{
+    std::vector<splitPoint> result;
+    int edgeCount = edges.size();
+    if (edgeCount < 2) {
+        return result;
+    }
+
+    std::vector<Bnd_Box> boxes(edgeCount);
+    std::vector<bool> usable(edgeCount, false);
+    Bnd_Box allBox;
+    for (int i = 0; i < edgeCount; i++) {
+        if (DrawUtil::isZeroEdge(edges[i])) {
+            continue;  //skip zero length edges. shouldn't happen ;)
+        }
+        BRepBndLib::Add(edges[i], boxes[i]);
+        boxes[i].SetGap(0.1);
+        if (boxes[i].IsVoid()) {
+            Base::Console().Log("INFO - DPS::getSplitPoints - Bnd_Box is void for edge: %d\n", i);
+            continue;
+        }
+        usable[i] = true;
+        allBox.Add(boxes[i]);
+    }
+    if (allBox.IsVoid()) {
+        return result;
+    }
+
+    //about one edge per cell on average
+    double xMin, yMin, zMin, xMax, yMax, zMax;
+    allBox.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+    int cells = std::max(1, static_cast<int>(std::sqrt(static_cast<double>(edgeCount))));
+    double cellX = std::max((xMax - xMin) / cells, Precision::Confusion());
+    double cellY = std::max((yMax - yMin) / cells, Precision::Confusion());
+
+    std::vector<std::vector<int> > grid(cells * cells);
+    EdgeSplitFinder finder(edges, boxes, usable, grid, cells, xMin, yMin, cellX, cellY);
+    for (int i = 0; i < edgeCount; i++) {
+        if (!usable[i]) {
+            continue;
+        }
+        double bxMin, byMin, bzMin, bxMax, byMax, bzMax;
+        boxes[i].Get(bxMin, byMin, bzMin, bxMax, byMax, bzMax);
+        int ixLow  = finder.cellIndex(bxMin, xMin, cellX);
+        int ixHigh = finder.cellIndex(bxMax, xMin, cellX);
+        int iyLow  = finder.cellIndex(byMin, yMin, cellY);
+        int iyHigh = finder.cellIndex(byMax, yMin, cellY);
+        for (int iy = iyLow; iy <= iyHigh; iy++) {
+            for (int ix = ixLow; ix <= ixHigh; ix++) {
+                grid[iy * cells + ix].push_back(i);
+            }
+        }
+    }
+
+    std::vector<int> outerEdges(edgeCount);
+    for (int i = 0; i < edgeCount; i++) {
+        outerEdges[i] = i;
+    }
+    QFuture<std::vector<splitPoint> > future = QtConcurrent::mapped(outerEdges, finder);
+    future.waitForFinished();
+    for (auto it = future.constBegin(); it != future.constEnd(); ++it) {
+        result.insert(result.end(), it->begin(), it->end());
+    }
+    return result;
+}
+
 //this routine is the big time consumer.  gets called many times (and is slow?))
 //note param gets modified here
 bool DrawProjectSplit::isOnEdge(TopoDS_Edge e, TopoDS_Vertex v, double& param, bool allowEnds)
@@ -289,45 +392,40 @@ bool DrawProjectSplit::isOnEdge(TopoDS_Edge e, TopoDS_Vertex v, double& param, b
 }
 
 
+//split edges at the split points. splits must be sorted by edge and param.
+//edges without split points are copied as is, the others are split concurrently.
 std::vector<TopoDS_Edge> DrawProjectSplit::splitEdges(std::vector<TopoDS_Edge> edges, std::vector<splitPoint> splits)
 {
     std::vector<TopoDS_Edge> result;
-    std::vector<TopoDS_Edge> newEdges;
-    std::vector<splitPoint> edgeSplits;      //splits for current edge
-    int iEdge = 0; //current edge index
-    int iSplit = 0; //current splitindex
-    int ii = 0;     //i value of current split
     int endEdge = edges.size();
-    int endSplit = splits.size();
-    int imax = std::numeric_limits<int>::max();
-
-    while ((iEdge < endEdge) )  {
-        if (iSplit < endSplit) {
-            ii = splits[iSplit].i;
-        } else {
-            ii = imax;
+    std::vector<std::vector<splitPoint> > edgeSplits(endEdge);
+    std::vector<int> splitEdgeIdx;
+    for (auto& s: splits) {
+        if ((s.i < 0) || (s.i >= endEdge)) {
+            continue;
         }
-        if (ii == iEdge) {
-            edgeSplits.push_back(splits[iSplit]);
-            iSplit++;
-        } else if (ii > iEdge) {
-            if (!edgeSplits.empty()) {                          //save *iedge's splits
-                newEdges = split1Edge(edges[iEdge],edgeSplits);
-                result.insert(result.end(), newEdges.begin(), newEdges.end());
-                edgeSplits.clear();
-            } else {
-                result.push_back(edges[iEdge]);                //save *iedge
-            }
-            iEdge++;                                           //next edge
-        } else if (iEdge > ii) {
-            iSplit++;
+        if (edgeSplits[s.i].empty()) {
+            splitEdgeIdx.push_back(s.i);
         }
+        edgeSplits[s.i].push_back(s);
+    }
+
+    QFuture<std::vector<TopoDS_Edge> > future =
+        QtConcurrent::mapped(splitEdgeIdx, EdgeSplitter(edges, edgeSplits));
+    future.waitForFinished();
+
+    std::vector<std::vector<TopoDS_Edge> > newEdges(endEdge);
+    int iResult = 0;
+    for (auto it = future.constBegin(); it != future.constEnd(); ++it, iResult++) {
+        newEdges[splitEdgeIdx[iResult]] = *it;
     }
 
-    if (!edgeSplits.empty()) {                                           //handle last batch
-        newEdges = split1Edge(edges[iEdge],edgeSplits);
-        result.insert(result.end(), newEdges.begin(), newEdges.end());
-        edgeSplits.clear();
+    for (int iEdge = 0; iEdge < endEdge; iEdge++) {
+        if (edgeSplits[iEdge].empty()) {
+            result.push_back(edges[iEdge]);                //save *iedge
+        } else {
+            result.insert(result.end(), newEdges[iEdge].begin(), newEdges[iEdge].end());
+        }
     }
 
     return result;
@@ -624,6 +624,13 @@ TopoDS_Shape DrawUtil::shapeFromString(std::string s)
     return result;
 }
 
+std::string DrawUtil::shapeHash(TopoDS_Shape s)
+{
+    //stable between sessions and ignores triangulations, so tessellating
+    //the source shape doesn't invalidate the saved key
+    return Part::TopoShape(s).getContentHash();
+}
+
 Base::Vector3d DrawUtil::invertY(Base::Vector3d v)
 {
     Base::Vector3d result(v.x, -v.y, v.z);
@@ -113,6 +113,8 @@ class TechDrawExport DrawUtil {
         static gp_Pnt         V32gpPnt(const Base::Vector3d v)  { return gp_Pnt(v.x,v.y,v.z); }
         static std::string shapeToString(TopoDS_Shape s);
         static TopoDS_Shape shapeFromString(std::string s);
+        //! content hash of a shape's brep representation, stable across sessions
+        static std::string shapeHash(TopoDS_Shape s);
         static Base::Vector3d invertY(Base::Vector3d v);
         static QPointF invertY(QPointF p);
         static std::vector<std::string> split(std::string csvLine);
@@ -27,6 +27,7 @@
 
 #ifndef _PreComp_
 # include <sstream>
+# include <iomanip>
 
 #include <Bnd_Box.hxx>
 #include <BRepAdaptor_Curve.hxx>
@@ -168,6 +169,10 @@ DrawViewPart::DrawViewPart(void) :
     ADD_PROPERTY_TYPE(SeamHidden ,(prefSeamHid()),sgroup,App::Prop_None,"Show Hidden Seam lines");
     ADD_PROPERTY_TYPE(IsoHidden ,(prefIsoHid()),sgroup,App::Prop_None,"Show Hidden Iso u,v lines");
     ADD_PROPERTY_TYPE(IsoCount ,(prefIsoCount()),sgroup,App::Prop_None,"Number of iso parameters lines");
+    ADD_PROPERTY_TYPE(HLRCache ,(TopoDS_Shape()),sgroup,(App::PropertyType)(App::Prop_Hidden | App::Prop_Output),
+                      "Saved HLR result");
+    ADD_PROPERTY_TYPE(HLRCacheKey ,(""),sgroup,(App::PropertyType)(App::Prop_Hidden | App::Prop_Output),
+                      "Source shape and projection of saved HLR result");
 
     geometryObject = nullptr;
     //initialize bbox to non-garbage
@@ -447,13 +452,36 @@ TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape,
     go->setFocus(Focus.getValue());
     go->usePolygonHLR(CoarseView.getValue());
 
-    if (go->usePolygonHLR()){
-        go->projectShapeWithPolygonAlgo(shape,
-            viewAxis);
+    //reuse the saved HLR result if neither the shape nor the projection changed
+    bool haveHLR = false;
+    std::string cacheKey;
+    if (prefHLRCache()) {
+        cacheKey = hlrCacheKey(shape, viewAxis);
+        if (!cacheKey.empty() &&
+            (cacheKey == HLRCacheKey.getValue())) {
+            haveHLR = go->setHlrResult(HLRCache.getValue());
+        }
+    } else if (!HLRCache.getValue().IsNull()) {
+        //don't keep stale results in the document
+        HLRCache.setValue(TopoDS_Shape());
+        HLRCacheKey.setValue("");
     }
-    else{
-        go->projectShape(shape,
-            viewAxis);
+
+    if (haveHLR) {
+        Base::Console().Log("DVP::buildGO - %s reusing saved HLR result\n", getNameInDocument());
+    } else {
+        if (go->usePolygonHLR()){
+            go->projectShapeWithPolygonAlgo(shape,
+                viewAxis);
+        }
+        else{
+            go->projectShape(shape,
+                viewAxis);
+        }
+        if (!cacheKey.empty()) {
+            HLRCache.setValue(go->getHlrResult());
+            HLRCacheKey.setValue(cacheKey);
+        }
     }
 
     go->extractGeometry(TechDraw::ecHARD,                   //always show the hard&outline visible lines
@@ -499,6 +527,30 @@ TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape,
     return go;
 }
 
+//! identifies the input of an HLR run: the (centered, scaled & rotated) shape
+//! and everything about the projector.
+std::string DrawViewPart::hlrCacheKey(const TopoDS_Shape& shape, const gp_Ax2& viewAxis) const
+{
+    std::string shapeHash = DrawUtil::shapeHash(shape);
+    if (shapeHash.empty()) {
+        return std::string();
+    }
+    const gp_XYZ axes[] = { viewAxis.Location().XYZ(),
+                            viewAxis.Direction().XYZ(),
+                            viewAxis.XDirection().XYZ() };
+    std::stringstream builder;
+    builder << std::setprecision(12);
+    builder << shapeHash << ";";
+    for (auto& a: axes) {
+        builder << a.X() << "," << a.Y() << "," << a.Z() << ";";
+    }
+    builder << Perspective.getValue() << ";"
+            << Focus.getValue() << ";"
+            << CoarseView.getValue() << ";"
+            << IsoCount.getValue();
+    return builder.str();
+}
+
 //! make faces from the existing edge geometry
 void DrawViewPart::extractFaces()
 {
@@ -526,63 +578,7 @@ void DrawViewPart::extractFaces()
 
     //HLR algo does not provide all edge intersections for edge endpoints.
     //need to split long edges touched by Vertex of another edge
-    std::vector<splitPoint> splits;
-    std::vector<TopoDS_Edge>::iterator itOuter = nonZero.begin();
-    int iOuter = 0;
-    for (; itOuter != nonZero.end(); ++itOuter, iOuter++) {    //*** itOuter != nonZero.end() - 1
-        TopoDS_Vertex v1 = TopExp::FirstVertex((*itOuter));
-        TopoDS_Vertex v2 = TopExp::LastVertex((*itOuter));
-        Bnd_Box sOuter;
-        BRepBndLib::Add(*itOuter, sOuter);
-        sOuter.SetGap(0.1);
-        if (sOuter.IsVoid()) {
-            Base::Console().Log("DVP::Extract Faces - outer Bnd_Box is void for %s\n",getNameInDocument());
-            continue;
-        }
-        if (DrawUtil::isZeroEdge(*itOuter)) {
-            Base::Console().Log("DVP::extractFaces - outerEdge: %d is ZeroEdge\n",iOuter);   //this is not finding ZeroEdges
-            continue;  //skip zero length edges. shouldn't happen ;)
-        }
-        int iInner = 0;
-        std::vector<TopoDS_Edge>::iterator itInner = nonZero.begin();   //***sb itOuter + 1;
-        for (; itInner != nonZero.end(); ++itInner,iInner++) {
-            if (iInner == iOuter) {
-                continue;
-            }
-            if (DrawUtil::isZeroEdge((*itInner))) {
-                continue;  //skip zero length edges. shouldn't happen ;)
-            }
-
-            Bnd_Box sInner;
-            BRepBndLib::Add(*itInner, sInner);
-            sInner.SetGap(0.1);
-            if (sInner.IsVoid()) {
-                Base::Console().Log("INFO - DVP::Extract Faces - inner Bnd_Box is void for %s\n",getNameInDocument());
-                continue;
-            }
-            if (sOuter.IsOut(sInner)) {      //bboxes of edges don't intersect, don't bother
-                continue;
-            }
-
-            double param = -1;
-            if (DrawProjectSplit::isOnEdge((*itInner),v1,param,false)) {
-                gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
-                splitPoint s1;
-                s1.i = iInner;
-                s1.v = Base::Vector3d(pnt1.X(),pnt1.Y(),pnt1.Z());
-                s1.param = param;
-                splits.push_back(s1);
-            }
-            if (DrawProjectSplit::isOnEdge((*itInner),v2,param,false)) {
-                gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
-                splitPoint s2;
-                s2.i = iInner;
-                s2.v = Base::Vector3d(pnt2.X(),pnt2.Y(),pnt2.Z());
-                s2.param = param;
-                splits.push_back(s2);
-            }
-        } //inner loop
-    }   //outer loop
+    std::vector<splitPoint> splits = DrawProjectSplit::getSplitPoints(nonZero);
 
     std::vector<splitPoint> sorted = DrawProjectSplit::sortSplits(splits,true);
     auto last = std::unique(sorted.begin(), sorted.end(), DrawProjectSplit::splitEqual);  //duplicates to back
@@ -1504,6 +1500,14 @@ int DrawViewPart::prefIsoCount(void)
     return result;
 }
 
+bool DrawViewPart::prefHLRCache(void)
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+          .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/TechDraw/HLR");
+    bool result = hGrp->GetBool("CacheHLR", true);
+    return result;
+}
+
 
 // Python Drawing feature ---------------------------------------------------------
 
@@ -37,6 +37,8 @@
 
 #include <Base/BoundBox.h>
 
+#include <Mod/Part/App/PropertyTopoShape.h>
+
 #include "PropertyGeomFormatList.h"
 #include "PropertyCenterLineList.h"
 #include "PropertyCosmeticEdgeList.h"
@@ -112,6 +114,9 @@ public:
     App::PropertyBool   IsoHidden;
     App::PropertyInteger  IsoCount;
 
+    Part::PropertyPartShape HLRCache;      //packed HLR output of the last projection
+    App::PropertyString     HLRCacheKey;   //shape hash + projection parameters of HLRCache
+
     virtual short mustExecute() const override;
     virtual void onDocumentRestored() override;
     virtual App::DocumentObjectExecReturn *execute(void) override;
@@ -241,6 +246,9 @@ protected:
     bool prefSmoothHid(void);
     bool prefIsoHid(void);
     int  prefIsoCount(void);
+    bool prefHLRCache(void);
+
+    std::string hlrCacheKey(const TopoDS_Shape& shape, const gp_Ax2& viewAxis) const;
 
     std::vector<TechDraw::Vertex*> m_referenceVerts;
 
@@ -56,6 +56,8 @@
 #include <TopLoc_Location.hxx>
 
 #include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
+#include <TopoDS_Iterator.hxx>
 #include <TopoDS_Shape.hxx>
 #include <TopoDS_Vertex.hxx>
 #include <TopoDS_Edge.hxx>
@@ -273,6 +275,57 @@ void GeometryObject::projectShape(const TopoDS_Shape& input,
     Base::Console().Log("TIMING - %s GO spent: %.3f millisecs in hlrToShape and BuildCurves\n",m_parentName.c_str(),diffOut);
 }
 
+//! pack the HLR output compounds into a single compound in a fixed order.
+//! missing results are stored as empty compounds so the order is preserved.
+TopoDS_Shape GeometryObject::getHlrResult(void) const
+{
+    BRep_Builder builder;
+    TopoDS_Compound result;
+    builder.MakeCompound(result);
+    const TopoDS_Shape* parts[] = { &visHard, &visOutline, &visSmooth, &visSeam, &visIso,
+                                    &hidHard, &hidOutline, &hidSmooth, &hidSeam, &hidIso };
+    for (auto& p: parts) {
+        if (p->IsNull()) {
+            TopoDS_Compound empty;
+            builder.MakeCompound(empty);
+            builder.Add(result, empty);
+        } else {
+            builder.Add(result, *p);
+        }
+    }
+    return result;
+}
+
+//! restore the HLR output from a compound made by getHlrResult.
+//! returns false (and leaves the HLR output untouched) if packed is not usable.
+bool GeometryObject::setHlrResult(const TopoDS_Shape& packed)
+{
+    if (packed.IsNull() ||
+        packed.ShapeType() != TopAbs_COMPOUND) {
+        return false;
+    }
+    std::vector<TopoDS_Shape> parts;
+    for (TopoDS_Iterator it(packed); it.More(); it.Next()) {
+        parts.push_back(it.Value());
+    }
+    if (parts.size() != 10) {
+        return false;
+    }
+
+    clear();
+    visHard    = parts[0];
+    visOutline = parts[1];
+    visSmooth  = parts[2];
+    visSeam    = parts[3];
+    visIso     = parts[4];
+    hidHard    = parts[5];
+    hidOutline = parts[6];
+    hidSmooth  = parts[7];
+    hidSeam    = parts[8];
+    hidIso     = parts[9];
+    return true;
+}
+
 //mirror a shape thru XZ plane for Qt's inverted Y coordinate
 TopoDS_Shape GeometryObject::invertGeometry(const TopoDS_Shape s)
 {
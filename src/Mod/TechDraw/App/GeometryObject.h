@@ -146,6 +146,10 @@ public:
     TopoDS_Shape getHidSeam(void)    { return hidSeam; }
     TopoDS_Shape getHidIso(void)     { return hidIso; }
 
+    //! HLR output packed into one compound (for caching) and unpacked again
+    TopoDS_Shape getHlrResult(void) const;
+    bool setHlrResult(const TopoDS_Shape& packed);
+
     void addVertex(TechDraw::Vertex* v);
     void addEdge(TechDraw::BaseGeom* bg);
 